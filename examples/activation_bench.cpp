@@ -0,0 +1,121 @@
+// runs each query in a file through search::semantic() twice -- ranked over a
+// pruning random walk subgraph, the way semantic_search does by default, and
+// over the whole collection with an activation_matrix -- and reports the
+// latency of each along with how many of the top documents they agree on
+//
+// usage: activation_bench <db file> <query file> [collection] [threads] [top k] [steps]
+
+#include <semantic/semantic.hpp>
+#include <semantic/storage/sqlite3.hpp>
+#include <semantic/search.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace semantic;
+
+typedef LGWeighting<TFWeighting,IDFWeighting,double> WeightingPolicy;
+typedef SESubgraph<SQLite3StoragePolicy, PruningRandomWalkSubgraph, WeightingPolicy> Graph;
+typedef search<Graph>::sorted_results sorted_results;
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+void report(std::string what, unsigned long n, double secs) {
+	std::cout << what << ": " << n << " queries in " << secs << "s";
+	if (n > 0) std::cout << " (" << 1000 * secs / n << "ms/query)";
+	std::cout << std::endl;
+}
+
+// how many of the first k documents of a are in the first k of b
+std::size_t overlap(const sorted_results &a, const sorted_results &b, std::size_t k) {
+	std::set<std::string> top;
+	for (std::size_t i = 0; i < k && i < b.size(); i++) top.insert(b[i].first);
+	std::size_t n = 0;
+	for (std::size_t i = 0; i < k && i < a.size(); i++) n += top.count(a[i].first);
+	return n;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "usage: " << argv[0] << " <db file> <query file> [collection] [threads] [top k] [steps]" << std::endl;
+		return 1;
+	}
+
+	std::string collection = argc > 3 ? argv[3] : "My Collection";
+	unsigned int threads = argc > 4 ? atoi(argv[4]) : 1;
+	std::size_t k = argc > 5 ? atoi(argv[5]) : 10;
+	unsigned int steps = argc > 6 ? atoi(argv[6]) : 4;
+
+	std::vector<std::string> queries;
+	std::ifstream file(argv[2]);
+	std::string line;
+	while (std::getline(file, line)) if (!line.empty()) queries.push_back(line);
+	if (queries.empty()) {
+		std::cerr << "no queries in " << argv[2] << std::endl;
+		return 1;
+	}
+
+	Graph g(collection);
+	g.set_file(argv[1]);
+	g.set_trials(100);
+	g.set_depth(4);
+	g.keep_only_top_edges(0.3f);
+
+	// the subgraph
+	std::vector<sorted_results> walked;
+	search<Graph> walk(g);
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (std::size_t q = 0; q < queries.size(); q++) {
+		walked.push_back(walk.semantic(queries[q], k, k).first);
+	}
+	report("random walk subgraph", queries.size(), seconds_since(start));
+
+	// the matrix, which is built by the first search
+	activation_matrix<Graph> matrix;
+	start = boost::posix_time::microsec_clock::universal_time();
+	activation_matrix<Graph>::pointer m = matrix.current(g);
+	std::cout << "matrix: " << m->size() << " vertices, " << m->num_edges() << " edges, built in "
+	          << seconds_since(start) << "s" << std::endl;
+
+	search<Graph> spread(g);
+	spread.set_activation_matrix(&matrix);
+	spread.set_activation_threads(threads);
+	spread.set_activation_steps(steps);
+	std::vector<sorted_results> spreaded;
+	start = boost::posix_time::microsec_clock::universal_time();
+	for (std::size_t q = 0; q < queries.size(); q++) {
+		spreaded.push_back(spread.semantic(queries[q], k, k).first);
+	}
+	report("activation matrix (" + to_string(threads) + " threads)", queries.size(), seconds_since(start));
+
+	spread.set_activation_stable_top(k);
+	std::vector<sorted_results> stopped;
+	start = boost::posix_time::microsec_clock::universal_time();
+	for (std::size_t q = 0; q < queries.size(); q++) {
+		stopped.push_back(spread.semantic(queries[q], k, k).first);
+	}
+	report("activation matrix, stopping once the top " + to_string(k) + " are stable", queries.size(), seconds_since(start));
+
+	// how well they agree
+	std::size_t walk_matrix = 0, matrix_stopped = 0, found = 0;
+	for (std::size_t q = 0; q < queries.size(); q++) {
+		walk_matrix += overlap(walked[q], spreaded[q], k);
+		matrix_stopped += overlap(stopped[q], spreaded[q], k);
+		found += std::min(k, spreaded[q].size());
+	}
+	if (found > 0) {
+		std::cout << "top " << k << " documents in common with the full matrix: random walk "
+		          << 100.0 * walk_matrix / found << "%, stopping early " << 100.0 * matrix_stopped / found << "%" << std::endl;
+	}
+	return 0;
+}
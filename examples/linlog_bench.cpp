@@ -0,0 +1,121 @@
+// lays out the subgraph a query brings up (the one search --cluster lays out)
+// with MinimizerBarnesHutHelper, the serial minimizer behind linlog_layout_3d,
+// and with ParallelMinimizerBarnesHutHelper in one and in [threads] threads,
+// all from the same starting positions.  reports the iterations/second of each
+// and the LinLog energy of the layout each ends up with (lower is better)
+//
+// usage: linlog_bench <db file> <query> [collection] [iterations] [threads]
+
+#include <semantic/semantic.hpp>
+#include <semantic/storage/sqlite3.hpp>
+#include <semantic/search.hpp>
+#include <semantic/analysis/parallel_linlog.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <math.h>
+
+using namespace semantic;
+
+typedef PrecomputedWeighting<LGWeighting<TFWeighting,IDFWeighting,double> > WeightingPolicy;
+typedef SESubgraph<SQLite3StoragePolicy, PruningRandomWalkSubgraph, WeightingPolicy> Graph;
+typedef boost::associative_property_map<weighting_traits<Graph>::edge_weight_map> WeightMap;
+typedef analysis::LinLogHelper<Graph, WeightMap> LinLog;
+typedef LinLog::AllMaps Maps;
+
+const double attrExp = 1.0, gravFactor = 0.01;
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+// the energy both minimizers head for (in their last, unpulsed steps),
+// with the repulsion summed over every pair rather than approximated
+double layout_energy(const Maps &m) {
+	double attrSum = 0, repuSum = 0;
+	for (std::size_t i = 0; i < m.weight.size(); i++) {
+		for (std::size_t k = 0; k < m.weight[i].size(); k++) attrSum += m.weight[i][k];
+		repuSum += m.repulsion[i];
+	}
+	double repuFactor = 1.0;
+	if (repuSum > 0 && attrSum > 0) repuFactor = attrSum / repuSum / repuSum * pow(repuSum, 0.5 * attrExp);
+
+	LinLog::Point bary(0,0,0);
+	for (std::size_t i = 0; i < m.position.size(); i++) bary += m.position[i] * m.repulsion[i];
+	if (repuSum > 0) bary /= repuSum;
+
+	double energy = 0;
+	for (std::size_t i = 0; i < m.position.size(); i++) {
+		// (each edge is in the adjacency lists of both its ends)
+		for (std::size_t k = 0; k < m.adjacency[i].size(); k++) {
+			if (m.adjacency[i][k] != i) energy += m.weight[i][k] * m.position[i].dist(m.position[m.adjacency[i][k]]) / 2;
+		}
+		for (std::size_t j = i + 1; j < m.position.size(); j++) {
+			if (m.repulsion[i] == 0 || m.repulsion[j] == 0) continue;
+			energy -= repuFactor * m.repulsion[i] * m.repulsion[j] * log(m.position[i].dist(m.position[j]));
+		}
+		energy += gravFactor * repuFactor * m.repulsion[i] * m.position[i].dist(bary);
+	}
+	return energy;
+}
+
+void report(std::string what, const Maps &m, int iterations, double secs) {
+	std::cout << what << ": " << iterations << " iterations in " << secs << "s";
+	if (secs > 0) std::cout << " (" << iterations / secs << " iterations/s)";
+	std::cout << ", energy " << layout_energy(m) << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "usage: " << argv[0] << " <db file> <query> [collection] [iterations] [threads]" << std::endl;
+		return 1;
+	}
+
+	std::string collection = argc > 3 ? argv[3] : "My Collection";
+	int iterations = argc > 4 ? atoi(argv[4]) : 300;
+	unsigned int threads = argc > 5 ? atoi(argv[5]) : 4;
+
+	Graph g(collection);
+	g.set_file(argv[1]);
+	search<Graph> engine(g);
+	engine.semantic(argv[2]);
+
+	weighting_traits<Graph>::edge_weight_map w;
+	g.populate_weight_map(boost::make_assoc_property_map(w));
+
+	Maps start;
+	LinLog::populate_all_maps(g, boost::make_assoc_property_map(w), start, true);
+	std::cout << num_vertices(g) << " vertices, " << num_edges(g) << " edges; starting energy "
+	          << layout_energy(start) << std::endl;
+
+	Maps serial = start;
+	analysis::detail::MinimizerBarnesHutHelper<Maps> s(serial, attrExp, 0.0, gravFactor);
+	s.setIterations(iterations);
+	boost::posix_time::ptime t = boost::posix_time::microsec_clock::universal_time();
+	s.run();
+	report("serial", serial, iterations, seconds_since(t));
+
+	Maps one = start;
+	analysis::detail::ParallelMinimizerBarnesHutHelper<Maps> p1(one, attrExp, 0.0, gravFactor);
+	p1.setIterations(iterations);
+	t = boost::posix_time::microsec_clock::universal_time();
+	p1.run();
+	report("parallel, 1 thread", one, iterations, seconds_since(t));
+
+	Maps many = start;
+	analysis::detail::ParallelMinimizerBarnesHutHelper<Maps> pn(many, attrExp, 0.0, gravFactor);
+	pn.setIterations(iterations);
+	pn.setThreads(threads);
+	t = boost::posix_time::microsec_clock::universal_time();
+	pn.run();
+	report("parallel, " + to_string(threads) + " threads", many, iterations, seconds_since(t));
+
+	if (one.position != many.position) {
+		std::cout << "the layouts in 1 and " << threads << " threads differ" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,130 @@
+// times the single pass text_normalizer against the old smart_quotes_filter
+// (a find_first_of/replace pass per character class) on a corpus, and on the
+// same corpus with its quotes and dashes made typographic, and reports MB/sec
+//
+// usage: normalize_bench <corpus file> [passes]
+
+#include <semantic/filter.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+using namespace semantic;
+
+// what smart_quotes_filter used to be
+class old_smart_quotes_filter : public text_filter {
+	public:
+		std::string operator()(const std::string &text) {
+			std::string cleaned(text);
+			replace_runs(cleaned, "―", "");
+			replace_runs(cleaned, "‐‑", "-");
+			replace_runs(cleaned, "‒–—", "--");
+			replace_runs(cleaned, "‘’", "'");
+			replace_runs(cleaned, "”“", "\"");
+			replace_runs(cleaned, "•", "*");
+			return cleaned;
+		}
+
+	private:
+		void replace_runs(std::string &cleaned, const std::string &delim, const std::string &replace) {
+			std::string::size_type pos = cleaned.find_first_of(delim, 0);
+			while (pos != std::string::npos) {
+				std::string::size_type nextPos = cleaned.find_first_not_of(delim, pos);
+				if (nextPos != std::string::npos) {
+					cleaned.replace(pos, nextPos - pos, replace);
+				} else {
+					cleaned.replace(pos, 1, replace);
+				}
+				pos = cleaned.find_first_of(delim, pos);
+			}
+		}
+};
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+void report(std::string what, double bytes, double secs) {
+	std::cout << "  " << what << ": " << secs << "s";
+	if (secs > 0) std::cout << " (" << bytes / secs / (1024 * 1024) << " MB/sec)";
+	std::cout << std::endl;
+}
+
+template <class Filter>
+std::string time_filter(std::string what, Filter &f, const std::string &text, unsigned int passes) {
+	std::string out;
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int p = 0; p < passes; p++) out = f(text);
+	report(what, (double)text.size() * passes, seconds_since(start));
+	return out;
+}
+
+void run(const std::string &name, const std::string &text, unsigned int passes) {
+	std::cout << name << " (" << text.size() << " bytes):" << std::endl;
+
+	old_smart_quotes_filter old_filter;
+	std::string old_out = time_filter("old smart_quotes_filter", old_filter, text, passes);
+
+	smart_quotes_filter filter;
+	std::string new_out = time_filter("smart_quotes_filter", filter, text, passes);
+
+	std::string reused;
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int p = 0; p < passes; p++) filter.normalize(text, reused);
+	report("normalize() into a reused buffer", (double)text.size() * passes, seconds_since(start));
+
+	text_normalizer everything;
+	everything.decode_entities(true);
+	everything.fold_whitespace(true);
+	time_filter("with entities and whitespace", everything, text, passes);
+
+	// the old filter worked on bytes rather than characters, so it only
+	// agrees with the new one where there was nothing for it to do
+	std::cout << "  outputs " << (old_out == new_out ? "match" : "differ") << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <corpus file> [passes]" << std::endl;
+		return 1;
+	}
+
+	unsigned int passes = argc > 2 ? atoi(argv[2]) : 5;
+
+	std::ifstream corpus(argv[1]);
+	std::ostringstream buffer;
+	buffer << corpus.rdbuf();
+	std::string text = buffer.str();
+	if (text.empty()) {
+		std::cerr << "no text in " << argv[1] << std::endl;
+		return 1;
+	}
+
+	run("corpus", text, passes);
+
+	// and again with curly quotes and proper dashes everywhere
+	std::string typographic;
+	bool open = true;
+	for (std::string::size_type i = 0; i < text.size(); i++) {
+		if (text[i] == '"') {
+			typographic += open ? "“" : "”";
+			open = !open;
+		} else if (text[i] == '\'') {
+			typographic += "’";
+		} else if (text[i] == '-' && i + 1 < text.size() && text[i+1] == '-') {
+			typographic += "—";
+			i++;
+		} else {
+			typographic += text[i];
+		}
+	}
+	run("typographic corpus", typographic, passes);
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+// times SQLite3StoragePolicy::commit_changes_to_storage() on a synthetic
+// document/term graph and reports rows/sec for vertices and edges
+//
+// usage: sqlite_sync_bench <db file> [documents] [terms] [terms per document]
+
+#include <semantic/semantic.hpp>
+#include <semantic/storage/sqlite3.hpp>
+#include <semantic/utility.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random.hpp>
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace semantic;
+
+typedef SEGraph<SQLite3StoragePolicy> Graph;
+typedef se_graph_traits<Graph>::vertex_descriptor Vertex;
+typedef se_graph_traits<Graph>::vertex_properties_type VertexProperties;
+typedef se_graph_traits<Graph>::edge_properties_type EdgeProperties;
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+void report(std::string what, unsigned long n, double secs) {
+	std::cout << what << ": " << n << " rows in " << secs << "s";
+	if (secs > 0) std::cout << " (" << (unsigned long)(n / secs) << " rows/sec)";
+	std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <db file> [documents] [terms] [terms per document]" << std::endl;
+		return 1;
+	}
+
+	std::string file = argv[1];
+	unsigned int num_docs = argc > 2 ? atoi(argv[2]) : 2000;
+	unsigned int num_terms = argc > 3 ? atoi(argv[3]) : 20000;
+	unsigned int per_doc = argc > 4 ? atoi(argv[4]) : 100;
+
+	Graph g("sqlite_sync_bench");
+	g.set_file(file);
+	g.set_mirror_changes_to_storage(true);
+	g.clear(); // start from an empty collection
+	g.commit_changes_to_storage();
+
+	// vertices first
+	std::vector<Vertex> docs, terms;
+	for(unsigned int i = 0; i < num_docs; i++) {
+		VertexProperties vp;
+		vp.content = "document " + to_string(i);
+		vp.type_major = node_type_major_doc;
+		docs.push_back(add_vertex(vp, g));
+	}
+	for(unsigned int i = 0; i < num_terms; i++) {
+		VertexProperties vp;
+		vp.content = "term" + to_string(i);
+		vp.type_major = node_type_major_term;
+		vp.type_minor = node_type_minor_term;
+		terms.push_back(add_vertex(vp, g));
+	}
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	g.commit_changes_to_storage();
+	report("vertices", num_docs + num_terms, seconds_since(start));
+
+	// then the edges, both directions like the indexer does
+	boost::minstd_rand rng(42);
+	boost::uniform_int<> pick(0, num_terms - 1);
+	boost::variate_generator<boost::minstd_rand&, boost::uniform_int<> > random_term(rng, pick);
+
+	unsigned long num_edges_added = 0;
+	for(unsigned int i = 0; i < num_docs; i++) {
+		for(unsigned int j = 0; j < per_doc; j++) {
+			EdgeProperties ep;
+			ep.strength = 1 + j % 5;
+			Vertex t = terms[random_term()];
+			if (add_edge(docs[i], t, ep, g).second) num_edges_added++;
+			if (add_edge(t, docs[i], ep, g).second) num_edges_added++;
+		}
+	}
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	g.commit_changes_to_storage();
+	report("edges", num_edges_added, seconds_since(start));
+
+	// and a small change on top of the big collection, which should cost
+	// about as much as the change and not as much as the collection
+	unsigned long num_small = 0;
+	for(unsigned int i = 0; i < 10; i++) {
+		VertexProperties vp;
+		vp.content = "late document " + to_string(i);
+		vp.type_major = node_type_major_doc;
+		Vertex d = add_vertex(vp, g);
+		num_small++;
+		for(unsigned int j = 0; j < per_doc; j++) {
+			EdgeProperties ep;
+			ep.strength = 1;
+			Vertex t = terms[random_term()];
+			if (add_edge(d, t, ep, g).second) num_small++;
+			if (add_edge(t, d, ep, g).second) num_small++;
+		}
+	}
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	g.commit_changes_to_storage();
+	report("small update", num_small, seconds_since(start));
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+// stems every word of a corpus with the plain English stemmer and with the
+// cached_stemmer in front of it, and reports words/sec for each along with
+// the cache's hit rate
+//
+// usage: stem_bench <corpus file> [passes] [cache capacity]
+
+#include <semantic/cached_stemmer.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
+
+using namespace semantic;
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+void report(std::string what, unsigned long n, double secs) {
+	std::cout << what << ": " << n << " words in " << secs << "s";
+	if (secs > 0) std::cout << " (" << (unsigned long)(n / secs) << " words/sec)";
+	std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <corpus file> [passes] [cache capacity]" << std::endl;
+		return 1;
+	}
+
+	unsigned int passes = argc > 2 ? atoi(argv[2]) : 5;
+	std::size_t capacity = argc > 3 ? atoi(argv[3]) : 16 * 1024;
+
+	// the words the way the parser hands them over: runs of letters
+	std::vector<std::string> words;
+	std::ifstream corpus(argv[1]);
+	std::string line;
+	while (std::getline(corpus, line)) {
+		std::string::size_type i = 0;
+		while (i < line.size()) {
+			while (i < line.size() && !isalpha((unsigned char)line[i])) i++;
+			std::string::size_type start = i;
+			while (i < line.size() && isalpha((unsigned char)line[i])) i++;
+			if (i > start) words.push_back(line.substr(start, i - start));
+		}
+	}
+	if (words.empty()) {
+		std::cerr << "no words in " << argv[1] << std::endl;
+		return 1;
+	}
+	unsigned long n = words.size() * passes;
+
+	std::vector<std::string> plain(words.size()), cached(words.size());
+
+	stemming::english_stem stemmer;
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int p = 0; p < passes; p++) {
+		for (std::vector<std::string>::size_type i = 0; i < words.size(); i++) {
+			plain[i] = words[i];
+			stemmer(plain[i]);
+		}
+	}
+	report("english_stem", n, seconds_since(start));
+
+	cached_stemmer<> cache(capacity);
+	start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int p = 0; p < passes; p++) {
+		for (std::vector<std::string>::size_type i = 0; i < words.size(); i++) {
+			cached[i] = words[i];
+			cache(cached[i]);
+		}
+	}
+	report("cached_stemmer", n, seconds_since(start));
+
+	cached_stemmer<>::statistics stats = cache.get_statistics();
+	std::cout << "cache: " << stats.entries << " of " << stats.capacity << " slots used, "
+	          << stats.hits << " hits, " << stats.misses << " misses ("
+	          << 100.0 * stats.hits / (stats.hits + stats.misses) << "% hit rate), "
+	          << stats.evictions << " evictions" << std::endl;
+
+	if (plain != cached) {
+		std::cerr << "the cached stems don't match!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,87 @@
+// times the tokenizer and tagger on a fixed corpus and reports tokens/sec
+// for the span-and-tag-id path (tagger::tag), and for the string based
+// calls built on it (add_tags, get_nouns)
+//
+// usage: tagger_bench <lexicon> <corpus file> [passes]
+
+#include <semantic/tagger.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace semantic;
+
+double seconds_since(boost::posix_time::ptime start) {
+	boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+	return d.total_microseconds() / 1000000.0;
+}
+
+void report(std::string what, unsigned long n, double secs) {
+	std::cout << what << ": " << n << " tokens in " << secs << "s";
+	if (secs > 0) std::cout << " (" << (unsigned long)(n / secs) << " tokens/sec)";
+	std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "usage: " << argv[0] << " <lexicon> <corpus file> [passes]" << std::endl;
+		return 1;
+	}
+
+	unsigned int passes = argc > 3 ? atoi(argv[3]) : 5;
+
+	std::vector<std::string> lines;
+	std::ifstream corpus(argv[2]);
+	std::string line;
+	while (std::getline(corpus, line)) lines.push_back(line);
+	if (lines.empty()) {
+		std::cerr << "no text in " << argv[2] << std::endl;
+		return 1;
+	}
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	tagger t(argv[1]);
+	std::cout << "lexicon: " << seconds_since(start) << "s" << std::endl;
+
+	// the same number of tokens goes through every run
+	tagger::tagged_tokens out;
+	unsigned long tokens = 0;
+	for (std::vector<std::string>::size_type i = 0; i < lines.size(); i++) {
+		t.tokenize(lines[i], out);
+		tokens += out.size();
+	}
+	tokens *= passes;
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int p = 0; p < passes; p++) {
+		t.reset();
+		for (std::vector<std::string>::size_type i = 0; i < lines.size(); i++)
+			t.tag(lines[i], out);
+	}
+	report("tag", tokens, seconds_since(start));
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	unsigned long length = 0;
+	for (unsigned int p = 0; p < passes; p++) {
+		t.reset();
+		for (std::vector<std::string>::size_type i = 0; i < lines.size(); i++)
+			length += t.add_tags(lines[i]).size();
+	}
+	report("add_tags", tokens, seconds_since(start));
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	unsigned long nouns = 0;
+	for (unsigned int p = 0; p < passes; p++) {
+		t.reset();
+		for (std::vector<std::string>::size_type i = 0; i < lines.size(); i++)
+			nouns += t.get_nouns(lines[i]).size();
+	}
+	report("get_nouns", tokens, seconds_since(start));
+
+	return 0;
+}
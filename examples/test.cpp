@@ -105,6 +105,7 @@ void simple_subgraph_test() {
 #include <semantic/analysis/harel_bfs_cluster.hpp>
 #include <semantic/analysis/utility.hpp>
 #include <semantic/pruning.hpp>
+#include <boost/progress.hpp>
 
 void compass_test() {
 	std::ifstream in("/tmp/townhall_index.txt");
@@ -185,7 +186,8 @@ void compass_test() {
 	std::cout << num_vertices(g) << std::endl;
 	std::cout << num_edges(g) << std::endl;
 	
-	analysis::harel_bfs_separation(g, weightmap, 2);
+	boost::progress_display separating(2 * num_vertices(g), std::cout);
+	analysis::harel_bfs_separation(g, weightmap, 2, 3, 1, separating);
 
 	typedef std::map<weighting::weight_type, unsigned long> DistribMap;
 	DistribMap distrib;
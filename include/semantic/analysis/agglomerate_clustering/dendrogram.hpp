@@ -1,6 +1,8 @@
 #ifndef __SEMANTIC_ANALYSIS_DENDROGRAM_HPP__
 #define __SEMANTIC_ANALYSIS_DENDROGRAM_HPP__
 
+#include <semantic/analysis/silhouette.hpp>
+
 #include <boost/pending/disjoint_sets.hpp>
 
 namespace semantic {
@@ -112,7 +114,58 @@ namespace semantic {
 				return m_current.find_set(u);
 			}
 			
+			// the silhouette (analysis::layout_silhouette()) of every cut from `most`
+			// clusters down to `least`, as (number of clusters, silhouette) pairs.
+			// each cut is the one before plus a link, so this measures the distance
+			// between each pair of positions once, not once per cut, and spreads the
+			// points over `threads` threads.  doesn't change the current clusters
+			template <class PositionMap, class OutputIterator>
+			void layout_silhouettes(PositionMap positions, vertices_size_type least, vertices_size_type most, OutputIterator out, unsigned int threads = 1) {
+				typedef typename boost::property_traits<PositionMap>::value_type point;
+				
+				std::map<vertex, std::size_t> index;
+				std::vector<point> points;
+				for(typename rank_map_type::iterator i = m_base_rank.begin(); i != m_base_rank.end(); ++i) {
+					index[i->first] = points.size();
+					points.push_back(get(positions, i->first));
+				}
+				
+				vertices_size_type n = points.size();
+				if (most > n) most = n;
+				if (least + m_links.size() < n) least = n - m_links.size(); // can't get fewer than that
+				if (least < 1) least = 1;
+				if (n == 0 || most < least) return;
+				
+				// the clusters at `most` come from the first n - most links
+				std::vector<std::size_t> parent(n);
+				for(std::size_t i = 0; i < n; i++) parent[i] = i;
+				for(std::size_t l = 0; l < n - most; l++) {
+					std::size_t u = root_of(parent, index[m_links[l].first]);
+					std::size_t v = root_of(parent, index[m_links[l].second]);
+					if (u != v) parent[u] = v;
+				}
+				std::vector<std::size_t> cluster(n), number(n, n);
+				std::size_t count = 0;
+				for(std::size_t i = 0; i < n; i++) {
+					std::size_t r = root_of(parent, i);
+					if (number[r] == n) number[r] = count++;
+					cluster[i] = number[r];
+				}
+				
+				analysis::detail::silhouette_sweep<point> sweep(points, cluster, count, threads);
+				for(vertices_size_type k = most; ; k--) {
+					*out++ = std::make_pair(k, sweep.silhouette());
+					if (k == least) break;
+					sweep.merge_with(index[m_links[n - k].first], index[m_links[n - k].second]);
+				}
+			}
+			
 		private:
+			static std::size_t root_of(std::vector<std::size_t> &parent, std::size_t i) {
+				while(parent[i] != i) i = parent[i] = parent[parent[i]];
+				return i;
+			}
+			
 			rank_map_type					m_base_rank, m_current_rank;
 			pred_map_type					m_base_pred, m_current_pred;
 		
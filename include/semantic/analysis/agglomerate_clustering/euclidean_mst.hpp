@@ -0,0 +1,153 @@
+/*
+	clustering a laid out graph by the distances between its vertices, without
+	a table of every pairwise distance.
+
+	the minimum spanning tree of the points, under straight-line distance, is
+	found with Boruvka's algorithm: each round joins every group of points to
+	its nearest neighbor group, so there are at most log n rounds.  the nearest
+	point outside a point's group is usually among its k nearest neighbors,
+	which are looked up once in a kd_tree; when they're all inside, the tree is
+	asked directly.  either way the answer is exact.
+
+	single linkage clustering merges along the edges of that tree, shortest
+	first, so the dendrogram comes straight from it:
+
+		dendrogram<Graph> dgram(g);
+		analysis::dendrogram_from_layout(g, boost::make_assoc_property_map(positions), dgram);
+*/
+
+#ifndef __SEMANTIC_ANALYSIS_EUCLIDEAN_MST_HPP__
+#define __SEMANTIC_ANALYSIS_EUCLIDEAN_MST_HPP__
+
+#include <semantic/semantic.hpp>
+#include <semantic/analysis/kd_tree.hpp>
+#include <semantic/analysis/agglomerate_clustering/dendrogram.hpp>
+
+#include <boost/graph/iteration_macros.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <math.h>
+
+namespace semantic { namespace analysis {
+
+	// an edge between two points, by their indices
+	struct layout_edge {
+		std::size_t source, target;
+		double distance;
+
+		layout_edge() : source(0), target(0), distance(0) {}
+		layout_edge(std::size_t s, std::size_t t, double d) : source(s), target(t), distance(d) {}
+
+		bool operator<(const layout_edge &e) const { return distance < e.distance; }
+	};
+
+	namespace detail {
+		inline std::size_t find_root(std::vector<std::size_t> &parent, std::size_t i) {
+			while(parent[i] != i) {
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+			}
+			return i;
+		}
+	} // namespace detail
+
+	// the Euclidean minimum spanning tree of the points, as points.size()-1
+	// edges (in no particular order)
+	template <class Point>
+	void euclidean_mst(const std::vector<Point> &points, std::vector<layout_edge> &mst, std::size_t k = 8)
+	{
+		typedef kd_tree<Point> tree_type;
+		typedef typename tree_type::neighbor neighbor;
+
+		mst.clear();
+		std::size_t n = points.size();
+		if (n < 2) return;
+		if (k > n - 1) k = n - 1;
+
+		tree_type tree(points);
+		std::vector<neighbor> near(n * k);
+		std::vector<neighbor> found;
+		for(std::size_t i = 0; i < n; i++) {
+			tree.nearest(i, k, found);
+			std::copy(found.begin(), found.end(), near.begin() + i * k);
+		}
+
+		std::vector<std::size_t> parent(n), label(n);
+		for(std::size_t i = 0; i < n; i++) parent[i] = i;
+
+		// an edge is (squared distance, lower end, higher end): comparing
+		// those gives every edge a distinct weight, which Boruvka needs
+		typedef std::pair<double, std::pair<std::size_t, std::size_t> > edge_key;
+		const edge_key none((std::numeric_limits<double>::max)(), std::make_pair(n, n));
+		std::vector<edge_key> best(n);
+
+		std::size_t components = n;
+		while(components > 1) {
+			for(std::size_t i = 0; i < n; i++) label[i] = detail::find_root(parent, i);
+			tree.set_labels(label);
+			std::fill(best.begin(), best.end(), none);
+
+			for(std::size_t i = 0; i < n; i++) {
+				std::size_t c = label[i];
+				neighbor other(0, n);
+				for(std::size_t j = i * k; j < (i + 1) * k; j++) {
+					if (label[near[j].second] != c) {
+						other = near[j];
+						break;
+					}
+				}
+				if (other.second == n) {
+					other = tree.nearest_other(i, best[c].first);
+					if (other.second == n) continue;
+				}
+
+				edge_key e(other.first, std::make_pair(std::min(i, other.second), std::max(i, other.second)));
+				if (e < best[c]) best[c] = e;
+			}
+
+			for(std::size_t c = 0; c < n; c++) {
+				if (best[c] == none) continue;
+				std::size_t u = best[c].second.first, v = best[c].second.second;
+				std::size_t ru = detail::find_root(parent, u), rv = detail::find_root(parent, v);
+				if (ru == rv) continue;			// the other group picked it too
+				parent[ru] = rv;
+				mst.push_back(layout_edge(u, v, sqrt(best[c].first)));
+				components--;
+			}
+		}
+	}
+
+	// single linkage clusters of the vertices of g by their positions
+	// (anything point3d-like), into a dendrogram
+	template <class Graph, class PositionMap>
+	void dendrogram_from_layout(Graph &g, PositionMap positions, dendrogram<Graph> &out, std::size_t k = 8)
+	{
+		typedef typename se_graph_traits<Graph>::vertex_descriptor vertex;
+		typedef typename boost::property_traits<PositionMap>::value_type point;
+
+		std::vector<vertex> index_vertex;
+		std::vector<point> points;
+		index_vertex.reserve(num_vertices(g));
+		points.reserve(num_vertices(g));
+		BGL_FORALL_VERTICES_T(u, g, Graph) {
+			index_vertex.push_back(u);
+			points.push_back(get(positions, u));
+		}
+
+		std::vector<layout_edge> mst;
+		euclidean_mst(points, mst, k);
+		std::stable_sort(mst.begin(), mst.end());
+
+		// (the dendrogram links representatives)
+		for(std::size_t i = 0; i < mst.size(); i++) {
+			out.add_link(out.get_rep_for(index_vertex[mst[i].source]), out.get_rep_for(index_vertex[mst[i].target]));
+		}
+	}
+
+}} // namespace semantic::analysis
+
+#endif
@@ -1,11 +1,20 @@
+#include <semantic/config.hpp>
 #include <semantic/semantic.hpp>
+#include <semantic/compact_subgraph.hpp>
 #include <boost/graph/iteration_macros.hpp>
 #include <semantic/utility.hpp>
 //#include <ext/hash_map>
 
-	
-	//debug
-	#include <boost/progress.hpp>
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <math.h>
 
 #ifndef __SEMANTIC_ANALYSIS_CLUSTER_HPP__
 #define __SEMANTIC_ANALYSIS_CLUSTER_HPP__
@@ -19,180 +28,294 @@ namespace semantic { namespace analysis {
 	 * this algorithm does iterative random walk clustering as described in "On Clustering Using Random Walks" (Harel & Koren 2001)
 	 */
 	
+	// the bytes of NS vectors harel_bfs_separation() keeps from one block of
+	// vertices to the next, unless told otherwise
+	const std::size_t harel_ns_cache_bytes = 64 * 1024 * 1024;
+	
 	namespace detail {
 		template <class Graph, class WeightMap>
 		struct harel_bfs_traits
 		{
 			typedef typename property_traits<WeightMap>::value_type weight;
 			typedef typename graph_traits<Graph>::vertex_descriptor vertex;
-			typedef typename std::map<vertex, weight> neighbor_similarity_map;
+			// sparse, over the vertex numbers of a compact_subgraph: (vertex, similarity) in vertex order
+			typedef typename std::vector<std::pair<std::size_t, weight> > neighbor_similarity_map;
 		};
 		
-		template <class Graph, class WeightMap>
+		// the vertices a search handles at once, per thread
+		const std::size_t harel_bfs_block = 64;
+		
+		// dense scratch space for building NS vectors, one per thread.  it's all
+		// zeroes between uses, so only what a walk touched gets cleaned up
+		template <class Weight>
+		struct harel_ns_scratch {
+			explicit harel_ns_scratch(std::size_t n) : mass(n, 0), next(n, 0), ns(n, 0), in_next(n, 0), in_ns(n, 0) {}
+			
+			std::vector<Weight> mass, next, ns;
+			std::vector<char> in_next, in_ns;
+			std::vector<std::size_t> frontier, next_frontier, touched;
+		};
+		
+		// the NS vector of vertex u: the chance of a walk from u being at each
+		// vertex after 1, 2, ... depth+1 steps, added up.  the walks are followed
+		// a step at a time for all of them at once, and a flow along an edge of
+		// less than `threshold` isn't followed
+		template <class Compact, class Weight>
 		inline void
 		harel_bfs_create_ns_map(
-			Graph &g,
-			WeightMap w,
-			typename graph_traits<Graph>::vertex_descriptor v,
+			const Compact &c,
+			const std::vector<Weight> &totals,
+			std::size_t u,
 			int depth,
-			typename harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map &ns,
-			bool use_threshold = false)
-		{			
-			// spider!
-			ns_spider(g, w, v, ns, 0, depth, 1, use_threshold);
-		}
-		
-		template <class Graph, class WeightMap>
-		inline void
-		ns_spider(
-			Graph &g, 
-			WeightMap w, 
-			typename graph_traits<Graph>::vertex_descriptor v,
-			typename harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map &ns,
-			int cur_depth,
-			int limit,
-			typename property_traits<WeightMap>::value_type running_weight,
-			bool use_threshold = false)
+			Weight threshold,
+			harel_ns_scratch<Weight> &s,
+			std::vector<std::pair<std::size_t, Weight> > &ns)
 		{
-			if (cur_depth > limit) return; // hit our depth limit. we're done!
-			// get this node's neighbors
-			typedef typename property_traits<WeightMap>::value_type weight;
-			typedef typename graph_traits<Graph>::out_edge_iterator out_edge_iterator;
-			typedef typename graph_traits<Graph>::vertex_descriptor vertex;
+			s.frontier.clear();
+			s.frontier.push_back(u);
+			s.mass[u] = 1;
 			
-			weight total = 0;
-			
-			BGL_FORALL_OUTEDGES_T(v,e,g,Graph) total += get(w, e);
-			
-			out_edge_iterator ei, eend;
-			for(tie(ei, eend) = out_edges(v, g); ei != eend; ++ei) {
-				// add to the map this edge's weight - if it exists already -- use addition
-				vertex target = boost::target(*ei, g);
-				weight new_running_weight = running_weight * (get(w, *ei) / total);
-				// if new_running_weight is below a certain threshold, let's just ignore it
-				if (use_threshold && new_running_weight < 0.001) continue;
-				if (ns.count(target)) {
-					ns[target] = ns[target] + new_running_weight;
-				} else {
-					ns[target] = new_running_weight;
+			for(int d = 0; d <= depth; d++) {
+				s.next_frontier.clear();
+				for(std::size_t f = 0; f < s.frontier.size(); f++) {
+					std::size_t x = s.frontier[f];
+					Weight m = s.mass[x];
+					s.mass[x] = 0;
+					if (totals[x] == 0) continue;
+					
+					for(std::size_t e = c.first_edge[x]; e < c.first_edge[x + 1]; e++) {
+						Weight flow = m * (c.weights[e] / totals[x]);
+						if (flow < threshold) continue;
+						std::size_t y = c.targets[e];
+						if (!s.in_next[y]) {
+							s.in_next[y] = 1;
+							s.next_frontier.push_back(y);
+						}
+						s.next[y] += flow;
+						if (!s.in_ns[y]) {
+							s.in_ns[y] = 1;
+							s.touched.push_back(y);
+						}
+						s.ns[y] += flow;
+					}
 				}
 				
-				// and go ahead and start spidering it, too
-				ns_spider(g, w, target, ns, cur_depth + 1, limit, new_running_weight, use_threshold);
+				for(std::size_t f = 0; f < s.next_frontier.size(); f++) {
+					std::size_t y = s.next_frontier[f];
+					s.mass[y] = s.next[y];
+					s.next[y] = 0;
+					s.in_next[y] = 0;
+				}
+				s.frontier.swap(s.next_frontier);
+			}
+			for(std::size_t f = 0; f < s.frontier.size(); f++) s.mass[s.frontier[f]] = 0;
+			
+			std::sort(s.touched.begin(), s.touched.end());
+			ns.clear();
+			ns.reserve(s.touched.size());
+			for(std::size_t t = 0; t < s.touched.size(); t++) {
+				std::size_t y = s.touched[t];
+				ns.push_back(std::make_pair(y, s.ns[y]));
+				s.ns[y] = 0;
+				s.in_ns[y] = 0;
 			}
+			s.touched.clear();
 		}
 		
-		template<class Graph, class WeightMap>
-		inline typename harel_bfs_traits<Graph, WeightMap>::weight
+		// the L1 distance between two NS vectors
+		template <class Weight>
+		inline Weight
 		ns_difference(
-			typename harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map &one,
-			typename harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map &two)
+			const std::vector<std::pair<std::size_t, Weight> > &one,
+			const std::vector<std::pair<std::size_t, Weight> > &two)
 		{
-			typedef typename harel_bfs_traits<Graph,WeightMap>::neighbor_similarity_map nsmap;
-			typedef typename harel_bfs_traits<Graph,WeightMap>::weight weight_type;
-			typedef typename harel_bfs_traits<Graph,WeightMap>::vertex key_type;
-			typedef typename nsmap::iterator iter;
-			weight_type diff = 0;
-			
-			iter one_i, two_i;
-			
-			for(one_i = one.begin(), two_i = two.begin(); one_i != one.end(); ++one_i) {
-				iter it;
-				if ((it = two.find((*one_i).first)) != two.end()) {
-					// we found the same key in the other iterator
-
-					// if it's not at our current position, copy all the elements up to
-					// our current position
-					while(two_i != it) {
-						diff += t_abs((*two_i).second);
-						++two_i;
-					}
-					
-					// now do this element
-					diff += t_abs((*one_i).second - (*two_i).second);
-					++two_i;
+			Weight diff = 0;
+			std::size_t i = 0, j = 0;
+			while(i < one.size() && j < two.size()) {
+				if (one[i].first < two[j].first) {
+					diff += t_abs(one[i++].second);
+				} else if (two[j].first < one[i].first) {
+					diff += t_abs(two[j++].second);
 				} else {
-					diff += t_abs((*one_i).second);
+					diff += t_abs(one[i++].second - two[j++].second);
 				}
 			}
+			for(; i < one.size(); i++) diff += t_abs(one[i].second);
+			for(; j < two.size(); j++) diff += t_abs(two[j].second);
 			
-			// lastly if our second list still contains elements, keep going
-			while(two_i != two.end()) {
-				diff += t_abs((*two_i).second);
-				++two_i;
-			}
-
 			return diff;
 		}
 		
+		// the passes of harel_bfs_separation().  vertices go in blocks: the NS
+		// vectors a block needs (its vertices' and their neighbors') are built
+		// in parallel, then its out-edges are weighed in parallel.  vectors stay
+		// cached for later blocks, the least recently used going first once
+		// they're over cache_bytes
+		template <class Graph, class WeightMap>
+		class harel_bfs_separator {
+			typedef typename harel_bfs_traits<Graph, WeightMap>::weight weight;
+			typedef typename harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map NSMap;
+			typedef compact_subgraph<Graph, weight> compact_type;
+			typedef void (harel_bfs_separator::*part_function)(std::size_t, std::size_t, unsigned int);
+			
+			public:
+				harel_bfs_separator(Graph &g, WeightMap w, int k, unsigned int threads, std::size_t cache_bytes)
+					: m_w(w), m_c(g, w), m_k(k), m_threads(threads > 0 ? threads : 1), m_cache_bytes(cache_bytes), m_bytes(0),
+					  m_totals(m_c.size()), m_new_weights(m_c.num_edges()), m_ns(m_c.size()), m_used(m_c.size(), 0), m_stamp(0)
+				{
+					for(unsigned int t = 0; t < m_threads; t++) m_scratch.push_back(harel_ns_scratch<weight>(m_c.size()));
+				}
+				
+				template <class Counter>
+				void pass(Counter &cRef) {
+					for(std::size_t x = 0; x < m_c.size(); x++) {
+						m_totals[x] = 0;
+						for(std::size_t e = m_c.first_edge[x]; e < m_c.first_edge[x + 1]; e++) m_totals[x] += m_c.weights[e];
+					}
+					
+					std::size_t block = harel_bfs_block * m_threads;
+					for(std::size_t first = 0; first < m_c.size(); first += block) {
+						m_first = first;
+						m_last = std::min(first + block, m_c.size());
+						
+						// find what's not cached yet, and mark what is as used
+						m_stamp++;
+						m_missing.clear();
+						for(std::size_t u = m_first; u < m_last; u++) {
+							use(u);
+							for(std::size_t e = m_c.first_edge[u]; e < m_c.first_edge[u + 1]; e++) use(m_c.targets[e]);
+						}
+						in_parts(&harel_bfs_separator::create_ns_maps, m_missing.size());
+						for(std::size_t i = 0; i < m_missing.size(); i++) m_bytes += bytes(m_ns[m_missing[i]]);
+						
+						in_parts(&harel_bfs_separator::separate, m_last - m_first);
+						for(std::size_t u = m_first; u < m_last; u++) ++cRef;
+						
+						if (m_bytes > m_cache_bytes) evict();
+					}
+					
+					// now transfer the new weights over to our old weight map
+					for(std::size_t e = 0; e < m_c.num_edges(); e++) {
+						m_c.weights[e] = m_new_weights[e];
+						put(m_w, m_c.edges[e], m_new_weights[e]);
+					}
+					
+					// (the weights changed under them)
+					for(std::size_t i = 0; i < m_cached.size(); i++) {
+						NSMap().swap(m_ns[m_cached[i]]);
+						m_used[m_cached[i]] = 0;
+					}
+					m_cached.clear();
+					m_bytes = 0;
+				}
+				
+			private:
+				static std::size_t bytes(const NSMap &ns) { return ns.capacity() * sizeof(typename NSMap::value_type); }
+				
+				void use(std::size_t u) {
+					if (!m_used[u]) {
+						m_missing.push_back(u);
+						m_cached.push_back(u);
+					}
+					m_used[u] = m_stamp;
+				}
+				
+				// f(first, last, part) over [0, count), in parts
+				void in_parts(part_function f, std::size_t count) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+					if (m_threads > 1 && count >= 2 * m_threads) {
+						boost::thread_group group;
+						std::size_t first = 0;
+						for(unsigned int t = 0; t < m_threads; t++) {
+							std::size_t last = count * (t + 1) / m_threads;
+							group.create_thread(boost::bind(f, this, first, last, t));
+							first = last;
+						}
+						group.join_all();
+						return;
+					}
+#endif
+					(this->*f)(0, count, 0);
+				}
+				
+				void create_ns_maps(std::size_t first, std::size_t last, unsigned int part) {
+					for(std::size_t i = first; i < last; i++) {
+						std::size_t u = m_missing[i];
+						harel_bfs_create_ns_map(m_c, m_totals, u, m_k, (weight) 0.001, m_scratch[part], m_ns[u]);
+					}
+				}
+				
+				void separate(std::size_t first, std::size_t last, unsigned int) {
+					for(std::size_t u = m_first + first; u < m_first + last; u++) {
+						for(std::size_t e = m_c.first_edge[u]; e < m_c.first_edge[u + 1]; e++) {
+							weight difference = ns_difference(m_ns[u], m_ns[m_c.targets[e]]);
+							// use exp(2k - ||x-y||) - 1  --> where ||x-y|| is difference
+							m_new_weights[e] = exp(2 * m_k - difference)/* - 1*/; // no longer subtracting 1 to avoid getting negative numbers when difference > 2*k
+						}
+					}
+				}
+				
+				struct by_use {
+					by_use(const std::vector<std::size_t> &used) : used(&used) {}
+					bool operator()(std::size_t a, std::size_t b) const { return (*used)[a] < (*used)[b]; }
+					const std::vector<std::size_t> *used;
+				};
+				
+				void evict() {
+					std::sort(m_cached.begin(), m_cached.end(), by_use(m_used));
+					std::size_t i = 0;
+					for(; i < m_cached.size() && m_bytes > m_cache_bytes; i++) {
+						std::size_t u = m_cached[i];
+						m_bytes -= bytes(m_ns[u]);
+						NSMap().swap(m_ns[u]);
+						m_used[u] = 0;
+					}
+					m_cached.erase(m_cached.begin(), m_cached.begin() + i);
+				}
+				
+				WeightMap								m_w;
+				compact_type							m_c;
+				int										m_k;
+				unsigned int							m_threads;
+				std::size_t								m_cache_bytes, m_bytes;
+				std::vector<weight>						m_totals, m_new_weights;
+				std::vector<NSMap>						m_ns;
+				std::vector<std::size_t>				m_used;			// the block each was last needed in; 0 if it isn't cached
+				std::vector<std::size_t>				m_cached, m_missing;
+				std::size_t								m_stamp, m_first, m_last;
+				std::vector<harel_ns_scratch<weight> >	m_scratch;
+		}; // class harel_bfs_separator
+		
 	} // namespace detail
 	
 	// performs the edge separation process (strengthening intra-cluster edges and weakening inter-cluster edges)
-	template <class Graph, class WeightMap>
+	// in `threads` threads.  cRef is incremented for each vertex of each pass
+	template <class Graph, class WeightMap, class Counter>
 	inline void
-	harel_bfs_separation(Graph &g, WeightMap w, int passes, int k = 3)
+	harel_bfs_separation(Graph &g, WeightMap w, int passes, int k, unsigned int threads, Counter &cRef,
+		std::size_t cache_bytes = harel_ns_cache_bytes)
 	{
-		typedef typename graph_traits<Graph>::vertex_descriptor vertex;
 		typedef typename graph_traits<Graph>::edge_descriptor edge;
-		typedef typename graph_traits<Graph>::vertex_iterator vertex_iterator;
-		typedef typename graph_traits<Graph>::out_edge_iterator out_edge_iterator;
 		typedef typename graph_traits<Graph>::directed_category directed;
-		typedef typename property_traits<WeightMap>::value_type weight;
-		typedef typename detail::harel_bfs_traits<Graph, WeightMap>::neighbor_similarity_map NSMap;
 		
 		BOOST_STATIC_ASSERT((is_same<directed, directed_tag>::value));
 		function_requires< WritablePropertyMapConcept<WeightMap, edge> >();
 		
 		// process:
-		//	- iterate through all the edges in this graph (however to save computation time we're going to iterate
-		//			through each vertex and its out_edges so we're only computing half the NS map for each edge)
+		//	- go through each vertex and its out_edges, so we're only computing half the NS maps for each edge
 		//	- calculate the NS map to a depth of k for each vertex
 		//	- use the NS map to apply our separating algorithm
 		//	- ^ do above passes times
-		
-		// this is our new map, which we'll use to hold our new weights until the iteration is done
-		std::map<edge, weight> new_weights;
-		
-		// this will cache our NSMaps
-		std::map<vertex, NSMap> ns_cache;
-		
-		for(int pass = 0; pass < passes; pass++) {
-			std::cout << "starting pass " << pass << std::endl;
-			vertex_iterator vi, vend;
-			vertex target;
-			boost::progress_display dsp(num_vertices(g), std::cout);
-
-			for(tie(vi, vend) = vertices(g); vi != vend; ++vi) {
-				// calculate the NS map for the source node
-				if (!ns_cache.count(*vi)) detail::harel_bfs_create_ns_map(g, w, *vi, k, ns_cache[*vi], true);
-				NSMap &source_map = ns_cache[*vi];
-				
-				// now go through each of the edges coming out of this vertex
-				out_edge_iterator ei, eend;
-				for(tie(ei, eend) = out_edges(*vi, g); ei != eend; ++ei) {
-					// get the NS map for the target node
-					target = boost::target(*ei, g);
-					if (!ns_cache.count(target)) detail::harel_bfs_create_ns_map(g, w, target, k, ns_cache[target], true);
-					NSMap &target_map = ns_cache[target];
-					
-					// calculate their difference
-					weight difference = detail::ns_difference<Graph, WeightMap>(source_map, target_map);
-					// use exp(2k - ||x-y||) - 1  --> where ||x-y|| is difference
-					new_weights.insert(std::make_pair<edge, weight>(*ei, exp(2 * k - difference)/* - 1*/)); // no longer subtracting 1 to avoid getting negative numbers when difference > 2*k
-				}
-				++dsp;
-			}
-			
-			// now transfer the new weights over to our old weight map
-			for(typename std::map<edge, weight>::iterator i = new_weights.begin(); i != new_weights.end(); ++i) {
-				//put(w, (*i).first, (get(w, (*i).first) > 0)?(*i).second:0);
-				put(w, (*i).first, (*i).second); // above line is redundant
-			}
-			new_weights.clear();
-			ns_cache.clear();
-			
-			std::cout << "pass " << pass << " complete." << std::endl;
-		}
+		detail::harel_bfs_separator<Graph, WeightMap> separator(g, w, k, threads, cache_bytes);
+		for(int pass = 0; pass < passes; pass++) separator.pass(cRef);
+	}
+	
+	template <class Graph, class WeightMap>
+	inline void
+	harel_bfs_separation(Graph &g, WeightMap w, int passes, int k = 3, unsigned int threads = 1)
+	{
+		int counter = 0; // dummy counter
+		harel_bfs_separation(g, w, passes, k, threads, counter);
 	}
 
 } } // namespace semantic::analysis
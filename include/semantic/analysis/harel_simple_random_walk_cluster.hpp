@@ -1,4 +1,6 @@
+#include <semantic/config.hpp>
 #include <semantic/semantic.hpp>
+#include <semantic/compact_subgraph.hpp>
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/iteration_macros.hpp>
 #include <semantic/utility.hpp>
@@ -6,9 +8,14 @@
 #include <time.h>
 //#include <ext/hash_map>
 
-	
-	//debug
-	#include <boost/progress.hpp>
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <cstddef>
 
 #ifndef __SEMANTIC_ANALYSIS_STRONG_NEIGHBOR_CLUSTER_HPP__
 #define __SEMANTIC_ANALYSIS_STRONG_NEIGHBOR_CLUSTER_HPP__
@@ -28,86 +35,148 @@ namespace semantic { namespace analysis {
 		{
 			typedef typename property_traits<WeightMap>::value_type weight;
 			typedef typename graph_traits<Graph>::vertex_descriptor vertex;
-			typedef typename std::map<vertex, weight> neighbor_similarity_map;
 		};
 		
-		template <class Graph, class WeightMap, class RandomGenerator>
-		inline void
-		harel_simple_create_ns_map(
-			Graph &g,
-			WeightMap w,
-			typename graph_traits<Graph>::vertex_descriptor v,
-			int depth,
-			int trials,
-			RandomGenerator &rand,
-			typename harel_simple_random_walk_traits<Graph, WeightMap>::neighbor_similarity_map &ns)
-		{
-			typedef typename graph_traits<Graph>::vertex_descriptor Vertex;
-			typedef typename graph_traits<Graph>::edge_descriptor Edge;
-			typedef typename graph_traits<Graph>::out_edge_iterator edge_iterator;
-			typedef typename property_traits<WeightMap>::value_type weight_type;
-			
-			// init
-			std::map<Vertex, int> runs, runs_next;
-			std::map<Vertex, weight_type> total_cache;
-			std::set<Vertex> fringe, fringe_next;
-			
-			runs[v] = trials;
-			fringe.insert(v);
+		// the vertices handed out to the threads at once, per thread
+		const std::size_t harel_simple_random_walk_block = 256;
+		
+		// the passes of harel_simple_random_walk_separation().  an edge's new
+		// weight only needs each end's NS value at the other end, so nothing
+		// is kept per vertex: the walks from v are counted in a dense scratch
+		// array, and v's values at its neighbors go straight to the edges,
+		// from_source for its out-edges and from_target for its in-edges.
+		// each vertex's walks use a generator seeded from (seed, pass, vertex),
+		// so the weights don't depend on the number of threads
+		template <class Graph, class WeightMap>
+		class harel_simple_random_walk_separator {
+			typedef typename harel_simple_random_walk_traits<Graph, WeightMap>::weight weight;
+			typedef compact_subgraph<Graph, weight> compact_type;
 			
-			// trials times, run a random walk of <depth>
-			for(int d = 0; d < depth; d++) {
-				for(typename std::set<Vertex>::iterator f = fringe.begin(); f != fringe.end(); ++f) {
-					Vertex u = *f;
-					weight_type total;
-					if (!total_cache.count(u)) {
-						total = 0;
-						BGL_FORALL_OUTEDGES_T(v,e,g,Graph) total += get(w, e);
-						total_cache[u] = total;
-					} else total = total_cache[u];
+			public:
+				harel_simple_random_walk_separator(Graph &g, WeightMap w, int k, int trials, unsigned int threads, unsigned long seed)
+					: m_w(w), m_c(g, w), m_k(k), m_trials(trials), m_threads(threads > 0 ? threads : 1), m_seed(seed), m_pass(0),
+					  m_totals(m_c.size()), m_from_source(m_c.num_edges()), m_from_target(m_c.num_edges()),
+					  m_rand(m_threads), m_counts(m_threads, std::vector<int>(m_c.size(), 0)), m_touched(m_threads)
+				{
+					// the in-edges of each vertex, as (source, edge) rows like compact_subgraph's
+					m_first_in.assign(m_c.size() + 1, 0);
+					for(std::size_t e = 0; e < m_c.num_edges(); e++) m_first_in[m_c.targets[e] + 1]++;
+					for(std::size_t x = 0; x < m_c.size(); x++) m_first_in[x + 1] += m_first_in[x];
+					m_in.resize(m_c.num_edges());
+					std::vector<std::size_t> at(m_first_in.begin(), m_first_in.end() - 1);
+					for(std::size_t x = 0; x < m_c.size(); x++) {
+						for(std::size_t e = m_c.first_edge[x]; e < m_c.first_edge[x + 1]; e++) {
+							m_in[at[m_c.targets[e]]++] = std::make_pair(x, e);
+						}
+					}
+				}
+				
+				template <class Counter>
+				void pass(Counter &cRef) {
+					for(std::size_t x = 0; x < m_c.size(); x++) {
+						m_totals[x] = 0;
+						for(std::size_t e = m_c.first_edge[x]; e < m_c.first_edge[x + 1]; e++) m_totals[x] += m_c.weights[e];
+					}
 					
-					// perform random neighbor selection runs[u] times
-					for(int i = 0; i < runs[u]; i++) {
-						// get a random number
-						double r = (double) (rand() + RandomGenerator::min_value)/(RandomGenerator::max_value - RandomGenerator::min_value);
-						// now find a neighbor that hits that random number
-						double cum = 0;
-						edge_iterator ei, ei_end;
-						for(boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
-							cum += (double) (get(w, *ei)/total);
-							if (cum >= r) {
-								Vertex target = boost::target(*ei, g);
-								if(!ns.count(target)) ns[target] = 0;
-								ns[target]++;
-								if(!runs_next.count(target)) runs_next[target] = 0;
-								runs_next[target]++;
-								fringe_next.insert(target);
-								break;
+					std::size_t block = harel_simple_random_walk_block * m_threads;
+					for(std::size_t first = 0; first < m_c.size(); first += block) {
+						std::size_t last = std::min(first + block, m_c.size());
+						walk_block(first, last);
+						for(std::size_t u = first; u < last; u++) ++cRef;
+					}
+					
+					// re-populate the weight map with the new info
+					for(std::size_t e = 0; e < m_c.num_edges(); e++) {
+						m_c.weights[e] = m_from_source[e] + m_from_target[e]; // add the two to ensure symmetry. averaging is unnecessary as it is all normalized later
+						put(m_w, m_c.edges[e], m_c.weights[e]);
+					}
+					m_pass++;
+				}
+				
+			private:
+				// walks from vertices first to last-1, in m_threads threads
+				void walk_block(std::size_t first, std::size_t last) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+					if (m_threads > 1) {
+						boost::thread_group group;
+						std::size_t from = first;
+						for(unsigned int t = 0; t < m_threads; t++) {
+							std::size_t to = first + (last - first) * (t + 1) / m_threads;
+							if (to > from) group.create_thread(boost::bind(&harel_simple_random_walk_separator::walk_from, this, from, to, t));
+							from = to;
+						}
+						group.join_all();
+						return;
+					}
+#endif
+					walk_from(first, last, 0);
+				}
+				
+				void walk_from(std::size_t first, std::size_t last, unsigned int part) {
+					boost::minstd_rand &rand = m_rand[part];
+					std::vector<int> &counts = m_counts[part];
+					std::vector<std::size_t> &touched = m_touched[part];
+					
+					for(std::size_t v = first; v < last; v++) {
+						rand.seed(seed_for(v));
+						
+						// trials times, run a random walk of <depth>
+						for(int t = 0; t < m_trials; t++) {
+							std::size_t u = v;
+							for(int d = 0; d < m_k; d++) {
+								if (m_totals[u] == 0) break;
+								// now find a neighbor that hits a random number
+								double r = (double) (rand() - (rand.min)()) / ((rand.max)() - (rand.min)()) * m_totals[u];
+								std::size_t e = m_c.first_edge[u], e_end = m_c.first_edge[u + 1];
+								double cum = 0;
+								for(; e + 1 < e_end; e++) {
+									cum += m_c.weights[e];
+									if (cum >= r) break;
+								}
+								u = m_c.targets[e];
+								if (counts[u]++ == 0) touched.push_back(u);
 							}
 						}
+						
+						for(std::size_t e = m_c.first_edge[v]; e < m_c.first_edge[v + 1]; e++) m_from_source[e] = counts[m_c.targets[e]];
+						for(std::size_t i = m_first_in[v]; i < m_first_in[v + 1]; i++) m_from_target[m_in[i].second] = counts[m_in[i].first];
+						
+						for(std::size_t i = 0; i < touched.size(); i++) counts[touched[i]] = 0;
+						touched.clear();
 					}
 				}
 				
-				fringe.swap(fringe_next);
-				fringe_next.clear();
-				runs.swap(runs_next);
-				runs_next.clear();
-			}
-		}	
+				// a seed for minstd_rand, which wants one in [1, 2^31 - 2]
+				boost::minstd_rand::result_type seed_for(std::size_t v) const {
+					unsigned long h = m_seed;
+					h = h * 2654435761UL + m_pass;
+					h = h * 2654435761UL + v;
+					h ^= h >> 15;
+					return static_cast<boost::minstd_rand::result_type>(h % 2147483646UL + 1);
+				}
+				
+				WeightMap								m_w;
+				compact_type							m_c;
+				int										m_k, m_trials;
+				unsigned int							m_threads;
+				unsigned long							m_seed, m_pass;
+				std::vector<weight>						m_totals, m_from_source, m_from_target;
+				std::vector<std::size_t>				m_first_in;
+				std::vector<std::pair<std::size_t, std::size_t> >	m_in;		// (source, edge)
+				std::vector<boost::minstd_rand>			m_rand;
+				std::vector<std::vector<int> >			m_counts;
+				std::vector<std::vector<std::size_t> >	m_touched;
+		}; // class harel_simple_random_walk_separator
 	} // namespace detail
 	
 	// performs the edge separation process (strengthening intra-cluster edges and weakening inter-cluster edges)
-	template <class Graph, class WeightMap>
+	// in `threads` threads; the same seed gives the same weights.  cRef is incremented for each vertex of each pass
+	template <class Graph, class WeightMap, class Counter>
 	inline void
-	harel_simple_random_walk_separation(Graph &g, WeightMap w, int passes, int k = 3)
+	harel_simple_random_walk_separation(Graph &g, WeightMap w, int passes, int k, unsigned int threads, unsigned long seed, Counter &cRef)
 	{
-		typedef typename graph_traits<Graph>::vertex_descriptor vertex;
 		typedef typename graph_traits<Graph>::edge_descriptor edge;
-		typedef typename graph_traits<Graph>::vertex_iterator vertex_iterator;
-		typedef typename graph_traits<Graph>::edge_iterator edge_iterator;
 		typedef typename graph_traits<Graph>::directed_category directed;
-		typedef typename property_traits<WeightMap>::value_type weight;
-		typedef typename detail::harel_simple_random_walk_traits<Graph, WeightMap>::neighbor_similarity_map NSMap;
 		
 		BOOST_STATIC_ASSERT((is_same<directed, directed_tag>::value));
 		function_requires< WritablePropertyMapConcept<WeightMap, edge> >();
@@ -116,42 +185,17 @@ namespace semantic { namespace analysis {
 		//	- calculate the NS map for all vertices
 		//	- use the NS map to populate the weight map again
 		//	- do this <passes> times
-		
-		// this will cache our NSMaps
-		std::map<vertex, NSMap> ns_cache;
-//		boost::timer clock;
-		
-		boost::minstd_rand rand;
-		rand.seed(static_cast<typename boost::minstd_rand::result_type>(time(0)));
-		
-		for(int pass = 0; pass < passes; pass++) {
-			std::cout << "starting pass " << pass << std::endl;
-			vertex_iterator vi, vend;
-			boost::progress_display dsp(num_vertices(g), std::cout);
-
-			for(tie(vi, vend) = vertices(g); vi != vend; ++vi) {
-				detail::harel_simple_create_ns_map(g, w, *vi, k, 50, rand, ns_cache[*vi]);
-				++dsp;
-			}
-			
-			// re-populate the weight map with the new info
-			edge_iterator ei, ei_end;
-			for(boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
-				vertex u, v;
-				u = source(*ei, g);
-				v = target(*ei, g);
-				
-				weight wu, wv;
-				wu = ns_cache[u].count(v)?ns_cache[u][v]:0;
-				wv = ns_cache[v].count(u)?ns_cache[v][u]:0;
-				
-				put(w, *ei, wu+wv); // add the two to ensure symmetry. averaging is unnecessary as it is all normalized later
-			}
-			
-			std::cout << "pass " << pass << " complete." << std::endl;
-			
-			ns_cache.clear();
-		}
+		detail::harel_simple_random_walk_separator<Graph, WeightMap> separator(g, w, k, 50, threads, seed);
+		for(int pass = 0; pass < passes; pass++) separator.pass(cRef);
+	}
+	
+	template <class Graph, class WeightMap>
+	inline void
+	harel_simple_random_walk_separation(Graph &g, WeightMap w, int passes, int k = 3, unsigned int threads = 1,
+		unsigned long seed = static_cast<unsigned long>(time(0)))
+	{
+		int counter = 0; // dummy counter
+		harel_simple_random_walk_separation(g, w, passes, k, threads, seed, counter);
 	}
 	
 	// takes a graph, weight map, and threshold and performs connected components on that graph
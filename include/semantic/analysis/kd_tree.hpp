@@ -0,0 +1,221 @@
+/*
+	a k-d tree over a set of points (point3d's, or anything else with
+	operator[] for three coordinates), for the questions clustering a layout
+	asks: which points are nearest to a point, and which is the nearest one
+	outside its own group.
+
+		kd_tree<point3d<float> > tree(points);
+		std::vector<kd_tree<point3d<float> >::neighbor> near;
+		tree.nearest(i, 8, near);		// (squared distance, index), nearest first
+
+	points are referred to by their index in the vector, which the tree keeps
+	a reference to.  ties in distance go to the lower index, so the answers
+	don't depend on how the tree happened to split.
+*/
+
+#ifndef __SEMANTIC_ANALYSIS_KD_TREE_HPP__
+#define __SEMANTIC_ANALYSIS_KD_TREE_HPP__
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace semantic { namespace analysis {
+
+	template <class Point>
+	class kd_tree {
+		public:
+			typedef std::size_t index_type;
+			typedef std::pair<double, index_type> neighbor;		// squared distance, point
+
+			explicit kd_tree(const std::vector<Point> &points, std::size_t leaf_size = 8)
+				: m_points(points), m_leaf_size(leaf_size > 0 ? leaf_size : 1)
+			{
+				m_index.resize(points.size());
+				for(index_type i = 0; i < points.size(); i++) m_index[i] = i;
+				if (!points.empty()) build(0, points.size());
+			}
+
+			std::size_t size() const { return m_points.size(); }
+
+			// the k points nearest to point i, not counting i itself
+			void nearest(index_type i, std::size_t k, std::vector<neighbor> &out) const {
+				out.clear();
+				if (k == 0 || m_nodes.empty()) return;
+				search_nearest(0, i, k, out);
+				std::sort_heap(out.begin(), out.end());
+			}
+
+			// the groups the points are in, for nearest_other()
+			void set_labels(const std::vector<std::size_t> &labels) {
+				m_labels = labels;
+				if (!m_nodes.empty()) label(0);
+			}
+
+			// the nearest point to i in another group than i's, if there's
+			// one nearer than `bound` (a squared distance); size() if not
+			neighbor nearest_other(index_type i, double bound = (std::numeric_limits<double>::max)()) const {
+				neighbor best(bound, size());
+				if (!m_nodes.empty()) search_other(0, i, best);
+				return best;
+			}
+
+		private:
+			enum { mixed = -1 };
+
+			struct node {
+				float lo[3], hi[3];				// bounding box
+				index_type first, last;			// its points are m_index[first..last)
+				index_type left, right;			// children (0 for a leaf)
+				std::size_t label;				// the group all its points are in, or mixed
+			};
+
+			index_type build(index_type first, index_type last) {
+				index_type at = m_nodes.size();
+				m_nodes.push_back(node());
+
+				node n;
+				n.first = first;
+				n.last = last;
+				n.left = n.right = 0;
+				n.label = (std::size_t) mixed;
+				for(int d = 0; d < 3; d++) {
+					n.lo[d] = (std::numeric_limits<float>::max)();
+					n.hi[d] = -(std::numeric_limits<float>::max)();
+				}
+				for(index_type j = first; j < last; j++) {
+					const Point &p = m_points[m_index[j]];
+					for(int d = 0; d < 3; d++) {
+						if (p[d] < n.lo[d]) n.lo[d] = p[d];
+						if (p[d] > n.hi[d]) n.hi[d] = p[d];
+					}
+				}
+
+				if (last - first > m_leaf_size) {
+					// split the widest side at the median
+					int dim = 0;
+					for(int d = 1; d < 3; d++) {
+						if (n.hi[d] - n.lo[d] > n.hi[dim] - n.lo[dim]) dim = d;
+					}
+					index_type mid = first + (last - first) / 2;
+					std::nth_element(m_index.begin() + first, m_index.begin() + mid, m_index.begin() + last, by_coordinate(m_points, dim));
+					n.left = build(first, mid);
+					n.right = build(mid, last);
+				}
+
+				m_nodes[at] = n;
+				return at;
+			}
+
+			std::size_t label(index_type at) {
+				node &n = m_nodes[at];
+				std::size_t l;
+				if (n.left) {
+					l = label(n.left);
+					if (label(n.right) != l) l = (std::size_t) mixed;
+				} else {
+					l = m_labels[m_index[n.first]];
+					for(index_type j = n.first + 1; j < n.last; j++) {
+						if (m_labels[m_index[j]] != l) l = (std::size_t) mixed;
+					}
+				}
+				return m_nodes[at].label = l;
+			}
+
+			double distance2(index_type i, index_type j) const {
+				const Point &p = m_points[i], &q = m_points[j];
+				double d2 = 0;
+				for(int d = 0; d < 3; d++) {
+					double t = (double) p[d] - (double) q[d];
+					d2 += t*t;
+				}
+				return d2;
+			}
+
+			// from point i to the nearest spot in a node's box
+			double box_distance2(index_type i, const node &n) const {
+				const Point &p = m_points[i];
+				double d2 = 0;
+				for(int d = 0; d < 3; d++) {
+					double t = 0;
+					if (p[d] < n.lo[d]) t = (double) n.lo[d] - p[d];
+					else if (p[d] > n.hi[d]) t = (double) p[d] - n.hi[d];
+					d2 += t*t;
+				}
+				return d2;
+			}
+
+			// the nearer child first, so the bound tightens sooner
+			std::pair<index_type, index_type> children(index_type i, const node &n) const {
+				if (box_distance2(i, m_nodes[n.right]) < box_distance2(i, m_nodes[n.left])) {
+					return std::make_pair(n.right, n.left);
+				}
+				return std::make_pair(n.left, n.right);
+			}
+
+			// out is a max-heap of the best k so far
+			void search_nearest(index_type at, index_type i, std::size_t k, std::vector<neighbor> &out) const {
+				const node &n = m_nodes[at];
+				if (out.size() == k && box_distance2(i, n) > out.front().first) return;
+
+				if (!n.left) {
+					for(index_type j = n.first; j < n.last; j++) {
+						index_type p = m_index[j];
+						if (p == i) continue;
+						neighbor candidate(distance2(i, p), p);
+						if (out.size() < k) {
+							out.push_back(candidate);
+							std::push_heap(out.begin(), out.end());
+						} else if (candidate < out.front()) {
+							std::pop_heap(out.begin(), out.end());
+							out.back() = candidate;
+							std::push_heap(out.begin(), out.end());
+						}
+					}
+					return;
+				}
+
+				std::pair<index_type, index_type> c = children(i, n);
+				search_nearest(c.first, i, k, out);
+				search_nearest(c.second, i, k, out);
+			}
+
+			void search_other(index_type at, index_type i, neighbor &best) const {
+				const node &n = m_nodes[at];
+				std::size_t own = m_labels[i];
+				if (n.label == own || box_distance2(i, n) > best.first) return;
+
+				if (!n.left) {
+					for(index_type j = n.first; j < n.last; j++) {
+						index_type p = m_index[j];
+						if (m_labels[p] == own) continue;
+						neighbor candidate(distance2(i, p), p);
+						if (candidate < best) best = candidate;
+					}
+					return;
+				}
+
+				std::pair<index_type, index_type> c = children(i, n);
+				search_other(c.first, i, best);
+				search_other(c.second, i, best);
+			}
+
+			struct by_coordinate {
+				by_coordinate(const std::vector<Point> &points, int dim) : points(&points), dim(dim) {}
+				bool operator()(index_type a, index_type b) const { return (*points)[a][dim] < (*points)[b][dim]; }
+				const std::vector<Point> *points;
+				int dim;
+			};
+
+			const std::vector<Point> &m_points;
+			std::size_t m_leaf_size;
+			std::vector<index_type> m_index;
+			std::vector<node> m_nodes;
+			std::vector<std::size_t> m_labels;
+	}; // class kd_tree
+
+}} // namespace semantic::analysis
+
+#endif
@@ -793,6 +793,31 @@ namespace semantic { namespace analysis {
 			
 	}; // class LinLogHelper
 	
+	namespace detail {
+		// steps a minimizer to the end, copying its positions out for each vertex
+		template <class Graph, class Maps, class Minimizer, class PositionMap, typename Counter>
+		inline void
+		run_linlog_minimizer(Graph &g, Maps &maps, Minimizer &minimizer, PositionMap &positions,
+		    Counter &cRef, const bool &stop_if_false, bool positions_on_step)
+		{
+		    while(minimizer.step() != -1) {
+		        if (positions_on_step) {
+		            positions.clear();
+		            BGL_FORALL_VERTICES_T(u, g, Graph) {
+		                positions[u] = maps.position[maps.vertex_index[u]];
+		            }
+		        }
+		        if (!stop_if_false) return;
+		        ++cRef;
+		        if (!stop_if_false) return;
+		    }
+		    
+		    BGL_FORALL_VERTICES_T(u, g, Graph) {
+		        positions[u] = maps.position[maps.vertex_index[u]];
+		    }
+		}
+	} // namespace detail
+	
 	// a helper function to perform basic linlog layout
 	template <class Graph, class WeightMap, typename Counter>
 	inline void
@@ -810,21 +835,7 @@ namespace semantic { namespace analysis {
 	        minimizer(maps, 1.0f, 0.0f, 0.01f);
 	    
 	    minimizer.setIterations(iterations);
-	    while(minimizer.step() != -1) {
-	        if (positions_on_step) {
-	            positions.clear();
-	            BGL_FORALL_VERTICES_T(u, g, Graph) {
-        	        positions[u] = maps.position[maps.vertex_index[u]];
-        	    }
-	        }
-	        if (!stop_if_false) return;
-	        ++cRef;
-	        if (!stop_if_false) return;
-	    }
-	    
-	    BGL_FORALL_VERTICES_T(u, g, Graph) {
-	        positions[u] = maps.position[maps.vertex_index[u]];
-	    }
+	    detail::run_linlog_minimizer(g, maps, minimizer, positions, cRef, stop_if_false, positions_on_step);
 	}
 
 	template <class Graph, class WeightMap>
@@ -0,0 +1,695 @@
+/*
+	a multi-threaded Barnes-Hut minimizer for the LinLog layout in linlog.hpp.
+
+	MinimizerBarnesHutHelper moves the nodes one after another, each against a
+	pointer-based OcTree that it rebuilds every step and patches as nodes move.
+	ParallelMinimizerBarnesHutHelper colors the graph so that no edge joins two
+	nodes of a color, and moves all the nodes of a color at once, Jacobi style:
+	each one's direction and line search are worked out against the tree and
+	the other colors' positions as they were, which the nodes of the color
+	don't touch, so they can be split between threads.  the tree catches up
+	between colors.  (moving every node at once doesn't settle: two neighbors
+	each jump the whole way to the other and past.)
+
+	its octree is a flat array, rebuilt each step in one pass over the nodes
+	sorted by Morton code.  every cell is followed by its subtree and knows where
+	the one after it starts, so a walk is a forward scan without recursion or
+	pointer chasing.  the line search tries four candidate moves per walk, with
+	the arithmetic for the four done side by side.
+
+	it takes the same maps and parameters as the serial one:
+
+		ParallelMinimizerBarnesHutHelper<Maps> minimizer(maps, 1.0f, 0.0f, 0.01f);
+		minimizer.setThreads(4);
+		minimizer.run();
+
+	the nodes don't move in the same order as the serial one's, so the layout
+	isn't the same, but it ends up with the same energy.  the result doesn't
+	depend on the number of threads.
+*/
+
+#ifndef __SEMANTIC_ANALYSIS_PARALLEL_LINLOG_HPP__
+#define __SEMANTIC_ANALYSIS_PARALLEL_LINLOG_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/analysis/linlog.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <math.h>
+
+namespace semantic { namespace analysis {
+
+	namespace detail {
+
+		// nodes it takes before a step is split between threads
+		const std::size_t parallel_linlog_nodes = 256;
+
+		// a cell or a leaf of a flat_octree
+		struct flat_octree_node {
+			float position[4];			// center of mass (the fourth is padding)
+			float weight;				// total repulsion of the nodes below
+			float width;				// longest side of the cell
+			boost::uint32_t leaf;		// 1 + the node's index for a leaf, 0 for a cell
+			boost::uint32_t next;		// the first entry past this one's subtree
+		};
+
+		// an octree laid out depth first in one array
+		class flat_octree {
+			public:
+				typedef flat_octree_node node;
+
+				// the nodes with a non-zero repulsion go in, split at the
+				// middle of their bounding box the way OcTree does
+				template <class Positions, class Repulsions>
+				void build(const Positions &position, const Repulsions &repulsion) {
+					m_nodes.clear();
+					m_codes.clear();
+
+					float minPos[3], maxPos[3];
+					for(int k = 0; k < 3; k++) {
+						minPos[k] = (std::numeric_limits<float>::max)();
+						maxPos[k] = -(std::numeric_limits<float>::max)();
+					}
+					for(std::size_t i = 0; i < position.size(); i++) {
+						if (repulsion[i] == 0) continue;
+						for(int k = 0; k < 3; k++) {
+							if (position[i][k] < minPos[k]) minPos[k] = position[i][k];
+							if (position[i][k] > maxPos[k]) maxPos[k] = position[i][k];
+						}
+					}
+
+					// Morton codes: the cell a node is in at each depth is
+					// three bits of its code, so sorting by code groups the
+					// nodes of every cell together
+					double scale[3];
+					for(int k = 0; k < 3; k++) {
+						scale[k] = maxPos[k] > minPos[k] ? (double) cells / (maxPos[k] - minPos[k]) : 0;
+					}
+					for(std::size_t i = 0; i < position.size(); i++) {
+						if (repulsion[i] == 0) continue;
+						boost::uint64_t code = 0;
+						for(int k = 0; k < 3; k++) {
+							boost::uint32_t q = (boost::uint32_t) ((position[i][k] - minPos[k]) * scale[k]);
+							if (q >= cells) q = cells - 1;
+							for(int b = 0; b < max_depth; b++) {
+								code |= (boost::uint64_t) ((q >> b) & 1) << (3*b + k);
+							}
+						}
+						m_codes.push_back(std::make_pair(code, (boost::uint32_t) i));
+					}
+					std::sort(m_codes.begin(), m_codes.end());
+
+					m_order.resize(m_codes.size());
+					for(std::size_t i = 0; i < m_codes.size(); i++) m_order[i] = m_codes[i].second;
+
+					if (m_codes.empty()) return;
+					m_nodes.reserve(2 * m_codes.size());
+					add_cell(position, repulsion, 0, m_codes.size(), 0, minPos, maxPos);
+				}
+
+				// moves the leaves to where their nodes are now and the cells'
+				// centers of mass with them, leaving the cells where they were
+				// (which is what OcTree::moveNode() does)
+				template <class Positions>
+				void refit(const Positions &position) {
+					for(std::size_t n = m_nodes.size(); n-- > 0; ) {
+						if (m_nodes[n].leaf) {
+							for(int k = 0; k < 3; k++) m_nodes[n].position[k] = position[m_nodes[n].leaf - 1][k];
+						} else {
+							center_of_mass(n);
+						}
+					}
+				}
+
+				std::size_t size() const { return m_nodes.size(); }
+				bool empty() const { return m_nodes.empty(); }
+				const node *nodes() const { return m_nodes.empty() ? 0 : &m_nodes[0]; }
+
+				// the width of the root cell
+				float width() const { return m_nodes.empty() ? 0 : m_nodes[0].width; }
+
+				// the indices of the nodes in the tree, in Morton order
+				const std::vector<boost::uint32_t> &order() const { return m_order; }
+
+			private:
+				enum { max_depth = 21 };			// OcTree drops nodes past 20
+				static const boost::uint32_t cells = 1 << max_depth;
+
+				template <class Positions, class Repulsions>
+				void add_cell(const Positions &position, const Repulsions &repulsion,
+				              std::size_t lo, std::size_t hi, int depth, const float *minPos, const float *maxPos)
+				{
+					std::size_t at = m_nodes.size();
+					m_nodes.push_back(node());
+
+					float width = 0;
+					for(int k = 0; k < 3; k++) {
+						if (maxPos[k] - minPos[k] > width) width = maxPos[k] - minPos[k];
+					}
+					m_nodes[at].width = width;
+					m_nodes[at].position[3] = 0;
+
+					if (hi - lo == 1) {
+						boost::uint32_t i = m_codes[lo].second;
+						for(int k = 0; k < 3; k++) m_nodes[at].position[k] = position[i][k];
+						m_nodes[at].weight = (float) repulsion[i];
+						m_nodes[at].leaf = i + 1;
+						m_nodes[at].next = m_nodes.size();
+						return;
+					}
+
+					if (depth == max_depth) {
+						// nodes that are (all but) on top of each other
+						for(std::size_t j = lo; j < hi; j++) {
+							add_cell(position, repulsion, j, j + 1, depth, minPos, maxPos);
+						}
+					} else {
+						int shift = 3 * (max_depth - 1 - depth);
+						for(std::size_t j = lo; j < hi; ) {
+							int octant = (int) ((m_codes[j].first >> shift) & 7);
+							std::size_t end = j;
+							while(end < hi && (int) ((m_codes[end].first >> shift) & 7) == octant) end++;
+
+							float childMin[3], childMax[3];
+							for(int k = 0; k < 3; k++) {
+								float mid = (minPos[k] + maxPos[k]) / 2;
+								childMin[k] = (octant & (1 << k)) ? mid : minPos[k];
+								childMax[k] = (octant & (1 << k)) ? maxPos[k] : mid;
+							}
+							add_cell(position, repulsion, j, end, depth + 1, childMin, childMax);
+							j = end;
+						}
+					}
+
+					m_nodes[at].leaf = 0;
+					m_nodes[at].next = m_nodes.size();
+					center_of_mass(at);
+				}
+
+				// a cell's weight and center from its children's
+				void center_of_mass(std::size_t at) {
+					double sum[3] = {0, 0, 0}, weight = 0;
+					for(std::size_t c = at + 1; c < m_nodes[at].next; c = m_nodes[c].next) {
+						for(int k = 0; k < 3; k++) sum[k] += (double) m_nodes[c].position[k] * m_nodes[c].weight;
+						weight += m_nodes[c].weight;
+					}
+					for(int k = 0; k < 3; k++) m_nodes[at].position[k] = weight > 0 ? (float) (sum[k] / weight) : 0;
+					m_nodes[at].weight = (float) weight;
+				}
+
+				std::vector<node> m_nodes;
+				std::vector<std::pair<boost::uint64_t, boost::uint32_t> > m_codes;
+				std::vector<boost::uint32_t> m_order;
+		}; // class flat_octree
+
+
+		// a Barnes-Hut minimizer that moves all the nodes at once
+		template <class Maps>
+		class ParallelMinimizerBarnesHutHelper {
+			typedef double float_type;
+			typedef typename Maps::weight_type weight_type;
+			typedef typename Maps::point_type point;
+			typedef typename Maps::size_type size_type;
+
+			enum { lanes = 4 };				// candidate moves per walk of the tree
+
+			public:
+				ParallelMinimizerBarnesHutHelper(Maps &all_maps, const float_type ae,
+				                                 const float_type re, const float_type gf) :
+											m_maps(all_maps), m_attrExp(ae),
+											m_repuExp(re), m_gravFactor(gf),
+											m_step(0), m_iterations(100), m_noVary(20), m_threads(1)
+				{
+					// the same pulsing as MinimizerBarnesHutHelper
+					int i = 0;
+					for(float f = 1.0f; f > 0.75f; f -= 0.05f, i++) s_repuStrategy[i] = f;
+					for(float f = 0.75f; f < 1.0f; f += 0.05f, i++) s_repuStrategy[i] = f;
+					for(float f = 1.0f; f < 1.5f; f+= 0.1f, i++) s_repuStrategy[i] = f;
+					for(float f = 1.5; f > 1.0f; f-=0.1f, i++) s_repuStrategy[i] = f;
+
+					reset();
+				}
+
+				void reset() {
+					m_step = 0;
+					computeRepuFactor();
+					computeColors();
+					m_repuFactor = m_finalRepuFactor;
+				}
+
+				void setIterations(int i) {
+					if (i < 0) i = 0;
+					m_noVary = i - (m_iterations - m_noVary);
+					m_iterations = i;
+				}
+
+				int getIterations() const { return m_iterations; }
+				int getCurrentStep() const { return m_step; }
+
+				void setVariationSteps(int i) {
+					if (i < 0) i = 0;
+					if (i > m_iterations) i = m_iterations;
+					m_noVary = m_iterations - i;
+				}
+
+				// threads to move the nodes in (without Boost.Thread, always one)
+				void setThreads(unsigned int threads) { m_threads = threads > 0 ? threads : 1; }
+				unsigned int getThreads() const { return m_threads; }
+
+				void run() {
+					while(m_step < m_iterations) step();
+				}
+
+				// returns the current step
+				int step(bool force = false) {
+					if (!force && m_step >= m_iterations) return -1;
+					if (m_maps.repulsion.size() <= 1) return -1;
+
+					computeBaryCenter();
+					m_tree.build(m_maps.position, m_maps.repulsion);
+
+					// except in the last m_noVary iterations, vary the repulsion factor
+					m_repuFactor = m_finalRepuFactor;
+					if(m_step < (m_iterations-m_noVary)) {
+						m_repuFactor *= (float_type)pow((float_type)s_repuStrategy[m_step%s_repuStrategy_length], m_attrExp - m_repuExp);
+					}
+
+					// the nodes by color, and in Morton order within one, so
+					// the nodes a thread moves in a row walk much the same cells
+					std::vector<std::vector<boost::uint32_t> > byColor(m_colors);
+					const std::vector<boost::uint32_t> &order = m_tree.order();
+					for(std::size_t w = 0; w < order.size(); w++) byColor[m_color[order[w]]].push_back(order[w]);
+					for(size_type i = 0; i < m_maps.repulsion.size(); i++) {
+						if (m_maps.repulsion[i] == 0) byColor[m_color[i]].push_back((boost::uint32_t) i);
+					}
+
+					for(std::size_t c = 0; c < byColor.size(); c++) {
+						m_work.swap(byColor[c]);
+						moveNodes();
+						m_tree.refit(m_maps.position);
+					}
+
+					return m_step++;
+				}
+
+			private:
+				void computeRepuFactor() {
+					m_attrSum = 0;
+					for(size_type i = 0; i < m_maps.weight.size(); i++) {
+						m_attrSum = accumulate(m_maps.weight[i].begin(), m_maps.weight[i].end(), m_attrSum);
+					}
+					m_repuSum = 0;
+					m_repuSum = accumulate(m_maps.repulsion.begin(), m_maps.repulsion.end(), m_repuSum);
+
+					m_finalRepuFactor = 1.0;
+					if (m_repuSum > 0 && m_attrSum > 0) {
+						m_finalRepuFactor = m_attrSum / m_repuSum / m_repuSum * (float_type) pow(m_repuSum, 0.5 * (m_attrExp - m_repuExp));
+					}
+				}
+
+				void computeBaryCenter() {
+					m_baryCenter.set(0,0,0);
+					for(size_type i = 0; i < m_maps.repulsion.size(); i++) {
+						m_baryCenter += m_maps.position[i] * m_maps.repulsion[i];
+					}
+					if (m_repuSum > 0) {
+						m_baryCenter /= m_repuSum;
+					}
+				}
+
+				// a greedy coloring of the graph, so that no two nodes of a
+				// color share an edge
+				void computeColors() {
+					size_type n = m_maps.adjacency.size();
+					std::vector<std::vector<size_type> > in(n);
+					for(size_type i = 0; i < n; i++) {
+						for(size_type k = 0; k < m_maps.adjacency[i].size(); k++) in[m_maps.adjacency[i][k]].push_back(i);
+					}
+
+					const boost::uint32_t none = (std::numeric_limits<boost::uint32_t>::max)();
+					m_color.assign(n, none);
+					m_colors = 0;
+					std::vector<size_type> taken;				// the last node to take each color
+					for(size_type i = 0; i < n; i++) {
+						for(size_type k = 0; k < m_maps.adjacency[i].size(); k++) {
+							boost::uint32_t c = m_color[m_maps.adjacency[i][k]];
+							if (c != none) taken[c] = i;
+						}
+						for(size_type k = 0; k < in[i].size(); k++) {
+							boost::uint32_t c = m_color[in[i][k]];
+							if (c != none) taken[c] = i;
+						}
+
+						boost::uint32_t c = 0;
+						while(c < m_colors && taken[c] == i) c++;
+						if (c == m_colors) {
+							taken.push_back(n);
+							m_colors++;
+						}
+						m_color[i] = c;
+					}
+				}
+
+				// moves the nodes in m_work, in m_threads threads
+				void moveNodes() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+					if (m_threads > 1 && m_work.size() >= parallel_linlog_nodes) {
+						boost::thread_group group;
+						std::size_t first = 0;
+						for(unsigned int t = 1; t <= m_threads; t++) {
+							std::size_t last = m_work.size() * t / m_threads;
+							if (last > first) {
+								group.create_thread(boost::bind(&ParallelMinimizerBarnesHutHelper::moveNodeRange, this, first, last));
+							}
+							first = last;
+						}
+						group.join_all();
+						return;
+					}
+#endif
+					moveNodeRange(0, m_work.size());
+				}
+
+				// nodes m_work[first] to m_work[last-1].  they're all of one
+				// color, so none of them is a neighbor of another, and the tree
+				// isn't touched until they're all done: what each one's move
+				// depends on doesn't change while the others move
+				void moveNodeRange(std::size_t first, std::size_t last) {
+					for(std::size_t w = first; w < last; w++) {
+						size_type i = m_work[w];
+						m_maps.position[i] = movedNode(i);
+					}
+				}
+
+				// where node i goes: the direction and line search of
+				// MinimizerBarnesHutHelper::step(), evaluated four moves at a time
+				point movedNode(size_type i) {
+					const point &oldPos = m_maps.position[i];
+
+					point bestDir(0,0,0);
+					float_type dir2 = 0;
+					float_type oldEnergy = repulsionAndDirection(i, bestDir, dir2)
+						+ attractionEnergy(i, oldPos) + gravitationEnergy(i, oldPos);
+					dir2 += addAttractionDir(i, bestDir) + addGravitationDir(i, bestDir);
+
+					if (dir2 != 0) {
+						// normalize force vector with second derivation of energy
+						bestDir /= dir2;
+
+						// ensure that the length of dir is at most 1/8
+						// of the maximum Euclidean distance between nodes
+						float_type length = point3d_dist(point(0,0,0), bestDir);
+						if (length > m_tree.width()/8) {
+							length /= m_tree.width()/8;
+							bestDir /= length;
+						}
+					} else {
+						return oldPos;
+					}
+					bestDir /= 32;
+
+					// the serial search tries 32, 16, ... 1 and then 64, 128, as
+					// far as each improves.  most moves end up 32 or 16 long, which
+					// the first walk settles; the second is for the rest
+					static const int multiples[2][lanes] = { {32, 16, 8, 64}, {4, 2, 1, 128} };
+					float_type energies[2][lanes];
+					bool walked[2] = {false, false};
+
+					float_type bestEnergy = oldEnergy;
+					int bestMultiple = 0;
+					for(	int multiple = 32;
+							multiple >= 1 && (bestMultiple==0 || bestMultiple/2==multiple);
+							multiple /= 2)
+					{
+						float_type curEnergy = candidateEnergy(i, bestDir, multiple, multiples, energies, walked);
+						if (curEnergy < bestEnergy) {
+							bestEnergy = curEnergy;
+							bestMultiple = multiple;
+						}
+					}
+
+					for(	int multiple = 64;
+							multiple <= 128 && bestMultiple == multiple/2;
+							multiple *= 2)
+					{
+						float_type curEnergy = candidateEnergy(i, bestDir, multiple, multiples, energies, walked);
+						if (curEnergy < bestEnergy) {
+							bestEnergy = curEnergy;
+							bestMultiple = multiple;
+						}
+					}
+
+					return oldPos + bestDir * bestMultiple;
+				}
+
+				float_type candidateEnergy(size_type i, const point &dir, int multiple, const int multiples[2][lanes],
+				                           float_type energies[2][lanes], bool walked[2])
+				{
+					for(int b = 0; b < 2; b++) {
+						for(int l = 0; l < lanes; l++) {
+							if (multiples[b][l] != multiple) continue;
+							if (!walked[b]) {
+								point candidates[lanes];
+								for(int c = 0; c < lanes; c++) candidates[c] = m_maps.position[i] + dir * multiples[b][c];
+								energyAt(i, candidates, energies[b]);
+								walked[b] = true;
+							}
+							return energies[b][l];
+						}
+					}
+					return 0;
+				}
+
+				// the energy of node i if it were at each of the candidates
+				void energyAt(size_type i, const point *candidates, float_type *energy) {
+					repulsionEnergy(i, candidates, energy);
+					for(int l = 0; l < lanes; l++) {
+						energy[l] += attractionEnergy(i, candidates[l]) + gravitationEnergy(i, candidates[l]);
+					}
+				}
+
+				float_type repulsionTerm(float_type dist2) const {
+					return (m_repuExp == 0)
+						? (float_type) log(sqrt(dist2))
+						: (float_type) pow(sqrt(dist2), m_repuExp) / m_repuExp;
+				}
+
+				// one walk for the four candidates: a lane that takes a cell as
+				// a whole skips over its subtree while the others go down into it
+				void repulsionEnergy(size_type i, const point *candidates, float_type *energy) {
+					float px[lanes], py[lanes], pz[lanes];
+					boost::uint32_t skip[lanes];
+					for(int l = 0; l < lanes; l++) {
+						px[l] = candidates[l].x(); py[l] = candidates[l].y(); pz[l] = candidates[l].z();
+						skip[l] = 0;
+						energy[l] = 0;
+					}
+					if (m_maps.repulsion[i] == 0) return;
+
+					const flat_octree_node *tree = m_tree.nodes();
+					const boost::uint32_t self = (boost::uint32_t) i + 1, end = (boost::uint32_t) m_tree.size();
+					for(boost::uint32_t n = 0; n < end; ) {
+						const flat_octree_node &t = tree[n];
+						if (t.leaf == self) {
+							n = t.next;
+							continue;
+						}
+
+						float dist2[lanes];
+						for(int l = 0; l < lanes; l++) {
+							float dx = px[l] - t.position[0], dy = py[l] - t.position[1], dz = pz[l] - t.position[2];
+							dist2[l] = dx*dx + dy*dy + dz*dz;
+						}
+
+						float_type width = 2*t.width;
+						bool open = false;
+						for(int l = 0; l < lanes; l++) {
+							if (n < skip[l]) continue;
+							if (!t.leaf && dist2[l] < width*width) {
+								open = true;
+							} else {
+								energy[l] += t.weight * repulsionTerm(dist2[l]);
+								skip[l] = t.next;
+							}
+						}
+						n = open ? n + 1 : t.next;
+					}
+
+					for(int l = 0; l < lanes; l++) energy[l] *= -m_repuFactor * m_maps.repulsion[i];
+				}
+
+				// the repulsion energy where node i is now, and the push on it
+				float_type repulsionAndDirection(size_type i, point &dir, float_type &dir2) {
+					if (m_maps.repulsion[i] == 0) return 0;
+
+					const point &pos = m_maps.position[i];
+					const float_type factor = m_repuFactor * m_maps.repulsion[i];
+					float_type energy = 0;
+
+					const flat_octree_node *tree = m_tree.nodes();
+					const boost::uint32_t self = (boost::uint32_t) i + 1, end = (boost::uint32_t) m_tree.size();
+					for(boost::uint32_t n = 0; n < end; ) {
+						const flat_octree_node &t = tree[n];
+						if (t.leaf == self) {
+							n = t.next;
+							continue;
+						}
+
+						point center(t.position[0], t.position[1], t.position[2]);
+						float_type dist2 = point3d_dist2(pos, center);
+						float_type width = 2*t.width;
+						if (!t.leaf && dist2 < width*width) {
+							n++;
+							continue;
+						}
+
+						energy += t.weight * repulsionTerm(dist2);
+						float_type dist = sqrt(dist2);
+						if (dist != 0) {
+							float_type tmp = factor * t.weight * (float_type) pow(dist, m_repuExp-2);
+							dir -= (center - pos) * tmp;
+							dir2 += tmp * t_abs(m_repuExp - 1);
+						}
+						n = t.next;
+					}
+					return -factor * energy;
+				}
+
+				float_type attractionEnergy(size_type i, const point &pos) const {
+					float_type energy = 0;
+					for(size_type k = 0; k < m_maps.adjacency[i].size(); k++) {
+						if (m_maps.adjacency[i][k] == i) continue;
+						float_type dist = point3d_dist(m_maps.position[m_maps.adjacency[i][k]], pos);
+						energy += m_maps.weight[i][k] * (m_attrExp == 1 ? dist : (float_type)pow(dist, m_attrExp) / m_attrExp);
+					}
+					return energy;
+				}
+
+				float_type gravitationEnergy(size_type i, const point &pos) const {
+					float_type dist = point3d_dist(pos, m_baryCenter);
+					return m_gravFactor * m_repuFactor * m_maps.repulsion[i] * (float_type) pow(dist, m_attrExp) / m_attrExp;
+				}
+
+				float_type addAttractionDir(size_type i, point &dir) const {
+					const point &pos = m_maps.position[i];
+					float_type dir2 = 0;
+					for(size_type k = 0; k < m_maps.adjacency[i].size(); k++) {
+						const point &other = m_maps.position[m_maps.adjacency[i][k]];
+						float_type dist = point3d_dist(other, pos);
+						if (dist == 0) continue;
+						float_type tmp = m_maps.weight[i][k] * (float_type) pow(dist, m_attrExp - 2);
+						dir2 += tmp * t_abs(m_attrExp - 1);
+						dir += (other - pos) * tmp;
+					}
+					return dir2;
+				}
+
+				float_type addGravitationDir(size_type i, point &dir) const {
+					const point &pos = m_maps.position[i];
+					float_type dist = point3d_dist(pos, m_baryCenter);
+					float_type tmp = m_gravFactor * m_repuFactor * m_maps.repulsion[i] * (float_type) pow(dist, m_attrExp - 2);
+					dir += (m_baryCenter - pos) * tmp;
+					return tmp * t_abs(m_attrExp - 1);
+				}
+
+				Maps &m_maps;
+
+				float_type m_attrExp;				// attraction exponent
+				float_type m_repuExp;				// repulsion exponent (0 for logarithmic)
+				float_type m_repuFactor;			// current factor for repulsion energy
+				float_type m_gravFactor;			// gravitational factor
+				float_type m_attrSum, m_repuSum, m_finalRepuFactor;
+
+				point m_baryCenter;
+
+				int m_step, m_iterations, m_noVary;
+				unsigned int m_threads;
+
+				std::vector<boost::uint32_t> m_color;	// the color of each node
+				boost::uint32_t m_colors;
+
+				flat_octree m_tree;
+				std::vector<boost::uint32_t> m_work;	// the nodes being moved
+
+				enum { s_repuStrategy_length = 20 };
+				float s_repuStrategy[s_repuStrategy_length];
+		}; // class ParallelMinimizerBarnesHutHelper
+
+	} // namespace detail
+
+
+	// linlog_layout() with the parallel minimizer, in `threads` threads
+	template <class Graph, class WeightMap, typename Counter>
+	inline void
+	parallel_linlog_layout(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads,
+	    Counter &cRef, const bool &stop_if_false, bool threeD = false, bool positions_on_step = false)
+	{
+	    typedef linlog_traits<Graph, WeightMap> traits;
+	    typedef LinLogHelper<Graph, WeightMap> helper;
+	    typename traits::all_maps maps;
+	    helper::populate_all_maps(g, w, maps, threeD);
+
+	    detail::ParallelMinimizerBarnesHutHelper<typename traits::all_maps>
+	        minimizer(maps, 1.0f, 0.0f, 0.01f);
+
+	    minimizer.setIterations(iterations);
+	    minimizer.setThreads(threads);
+	    detail::run_linlog_minimizer(g, maps, minimizer, positions, cRef, stop_if_false, positions_on_step);
+	}
+
+	template <class Graph, class WeightMap>
+	inline void
+	parallel_linlog_layout(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads, bool threeD = false)
+	{
+	    int counter = 0; // dummy counter
+	    bool dummy_bool = true;
+	    parallel_linlog_layout(g, w, iterations, positions, threads, counter, dummy_bool, threeD);
+	}
+
+	// aliases
+	template <class Graph, class WeightMap>
+	inline void
+	parallel_linlog_layout_2d(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads)
+	{
+	    parallel_linlog_layout(g, w, iterations, positions, threads, false);
+	}
+	template <class Graph, class WeightMap, class Counter>
+	inline void
+	parallel_linlog_layout_2d(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads,
+	    Counter &cRef, const bool &stop_if_false = true, bool positions_on_step = false)
+	{
+	    parallel_linlog_layout(g, w, iterations, positions, threads, cRef, stop_if_false, false, positions_on_step);
+	}
+	template <class Graph, class WeightMap>
+	inline void
+	parallel_linlog_layout_3d(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads)
+	{
+	    parallel_linlog_layout(g, w, iterations, positions, threads, true);
+	}
+	template <class Graph, class WeightMap, class Counter>
+	inline void
+	parallel_linlog_layout_3d(Graph &g, WeightMap w, int iterations,
+	    typename linlog_traits<Graph, WeightMap>::vertex_position_map &positions, unsigned int threads,
+	    Counter &cRef, const bool &stop_if_false = true, bool positions_on_step = false)
+	{
+	    parallel_linlog_layout(g, w, iterations, positions, threads, cRef, stop_if_false, true, positions_on_step);
+	}
+
+} } // namespace semantic::analysis
+
+#endif
@@ -7,9 +7,19 @@
 #ifndef __SEMANTIC_ANALYSIS_SILHOUETTE_HPP__
 #define __SEMANTIC_ANALYSIS_SILHOUETTE_HPP__
 
+#include <semantic/config.hpp>
 #include <semantic/semantic.hpp>
 #include <semantic/analysis/shortest_paths.hpp>
 
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
 namespace semantic { namespace analysis {
 
 	template <class Graph>
@@ -108,6 +118,197 @@ namespace semantic { namespace analysis {
 		return average / cluster_count;
 	}
 	
+	// the same measure for vertices laid out in space, with the straight-line
+	// distance between their positions (point3d's) for the path lengths.  this
+	// needs no table of distances: each vertex's a and b come from one pass over
+	// the positions of the others
+	template <class Graph, class PositionMap, class ComponentMap, class OutputMap>
+	inline typename property_traits<OutputMap>::value_type
+	layout_silhouette(Graph &g, PositionMap positions, ComponentMap components, OutputMap quality)
+	{
+		typedef typename boost::property_traits<OutputMap>::value_type quality_measure_type;
+		typedef typename boost::property_traits<PositionMap>::value_type point;
+		typedef typename se_graph_traits<Graph>::vertex_descriptor vertex;
+		
+		std::vector<vertex> index_vertex;
+		std::vector<point> points;
+		std::vector<unsigned long> component;
+		unsigned long cluster_count = 0;
+		BGL_FORALL_VERTICES_T(u, g, Graph) {
+			index_vertex.push_back(u);
+			points.push_back(get(positions, u));
+			component.push_back(get(components, u));
+			if (component.back() + 1 > cluster_count) cluster_count = component.back() + 1;
+		}
+		
+		std::vector<quality_measure_type> cluster_quality(cluster_count, 0);
+		std::vector<unsigned long> cluster_size(cluster_count, 0);
+		std::vector<quality_measure_type> b(cluster_count);
+		std::vector<unsigned long> b_count(cluster_count);
+		
+		for(std::size_t i = 0; i < points.size(); i++) {
+			std::fill(b.begin(), b.end(), 0);
+			std::fill(b_count.begin(), b_count.end(), 0);
+			for(std::size_t j = 0; j < points.size(); j++) {
+				if (j == i) continue;
+				b[component[j]] += points[i].dist(points[j]);
+				b_count[component[j]]++;
+			}
+			
+			// a is the one for our own cluster; find the smallest of the rest
+			unsigned long this_component = component[i];
+			unsigned long a_count = b_count[this_component];
+			quality_measure_type a = a_count == 0 ? 0 : b[this_component] / a_count;
+			quality_measure_type b_best = 0;
+			for(unsigned long c = 0; c < cluster_count; c++) {
+				if (c == this_component || b[c] == 0) continue;
+				b[c] /= b_count[c];
+				if (b[c] < b_best || b_best == 0) b_best = b[c];
+			}
+			quality_measure_type m = a>b_best?a:b_best;
+			
+			quality_measure_type s = (b_best - a) / m;
+			if (a_count == 0) s = 0;
+			put(quality, index_vertex[i], s);
+			cluster_quality[this_component] += s;
+			cluster_size[this_component]++;
+		}
+		
+		quality_measure_type average = 0;
+		for(unsigned long c = 0; c < cluster_count; c++) {
+			if (cluster_size[c] == 0) continue;
+			average += cluster_quality[c] / cluster_size[c];
+		}
+		
+		return cluster_count == 0 ? 0 : average / cluster_count;
+	}
+	
+	namespace detail {
+		// layout_silhouette() for a run of clusterings of the same points, each
+		// the last with two of its clusters merged.  every point keeps the sum
+		// of its distances to each cluster, so a merge just adds two of those
+		// together: all the distances are taken once, for the first clustering,
+		// and each silhouette after that is a pass over points x clusters.  the
+		// points are split between `threads` threads
+		template <class Point>
+		class silhouette_sweep {
+			public:
+				// cluster[i] is the cluster (0 to clusters-1) point i starts in
+				silhouette_sweep(const std::vector<Point> &points, const std::vector<std::size_t> &cluster, std::size_t clusters, unsigned int threads = 1)
+					: m_points(points), m_cluster(cluster), m_clusters(clusters), m_threads(threads > 0 ? threads : 1),
+					  m_sum(points.size() * clusters, 0), m_size(clusters, 0), m_parent(clusters),
+					  m_part_quality(m_threads, std::vector<double>(clusters, 0))
+				{
+					for(std::size_t c = 0; c < clusters; c++) {
+						m_parent[c] = c;
+						m_live.push_back(c);
+					}
+					for(std::size_t i = 0; i < points.size(); i++) m_size[cluster[i]]++;
+					in_parts(&silhouette_sweep::sum_distances);
+				}
+
+				// the number of clusters there are now
+				std::size_t size() const { return m_live.size(); }
+
+				// of the clustering as it is now
+				double silhouette() {
+					in_parts(&silhouette_sweep::point_silhouettes);
+
+					double average = 0;
+					for(std::size_t l = 0; l < m_live.size(); l++) {
+						std::size_t c = m_live[l];
+						double q = 0;
+						for(unsigned int t = 0; t < m_threads; t++) q += m_part_quality[t][c];
+						if (m_size[c] > 0) average += q / m_size[c];
+					}
+					return m_live.empty() ? 0 : average / m_live.size();
+				}
+
+				// the clusters points i and j are in become one
+				void merge_with(std::size_t i, std::size_t j) {
+					std::size_t a = m_parent[m_cluster[i]], b = m_parent[m_cluster[j]];
+					if (a == b) return;
+					for(std::size_t c = 0; c < m_clusters; c++) {
+						if (m_parent[c] == b) m_parent[c] = a;
+					}
+					m_size[a] += m_size[b];
+					m_live.erase(std::find(m_live.begin(), m_live.end(), b));
+					for(std::size_t p = 0; p < m_points.size(); p++) {
+						m_sum[p * m_clusters + a] += m_sum[p * m_clusters + b];
+					}
+				}
+
+			private:
+				typedef void (silhouette_sweep::*part_function)(std::size_t, std::size_t, unsigned int);
+
+				// f(first, last, part) over the points, in parts
+				void in_parts(part_function f) {
+					std::size_t n = m_points.size();
+#if SEMANTIC_HAVE_BOOST_THREAD
+					if (m_threads > 1 && n >= 2 * m_threads) {
+						boost::thread_group group;
+						std::size_t first = 0;
+						for(unsigned int t = 0; t < m_threads; t++) {
+							std::size_t last = n * (t + 1) / m_threads;
+							group.create_thread(boost::bind(f, this, first, last, t));
+							first = last;
+						}
+						group.join_all();
+						return;
+					}
+#endif
+					for(unsigned int t = 1; t < m_threads; t++) {
+						std::fill(m_part_quality[t].begin(), m_part_quality[t].end(), 0);
+					}
+					(this->*f)(0, n, 0);
+				}
+
+				// (each part writes only its own points' rows)
+				void sum_distances(std::size_t first, std::size_t last, unsigned int) {
+					for(std::size_t i = first; i < last; i++) {
+						double *sum = &m_sum[i * m_clusters];
+						for(std::size_t j = 0; j < m_points.size(); j++) {
+							if (j == i) continue;
+							sum[m_cluster[j]] += m_points[i].dist(m_points[j]);
+						}
+					}
+				}
+
+				// the same a, b and s as layout_silhouette(), summed per cluster
+				void point_silhouettes(std::size_t first, std::size_t last, unsigned int part) {
+					std::vector<double> &quality = m_part_quality[part];
+					std::fill(quality.begin(), quality.end(), 0);
+					for(std::size_t i = first; i < last; i++) {
+						const double *sum = &m_sum[i * m_clusters];
+						std::size_t own = m_parent[m_cluster[i]];
+						std::size_t a_count = m_size[own] - 1;
+						double a = a_count == 0 ? 0 : sum[own] / a_count;
+						double b_best = 0;
+						for(std::size_t l = 0; l < m_live.size(); l++) {
+							std::size_t c = m_live[l];
+							if (c == own || sum[c] == 0) continue;
+							double b = sum[c] / m_size[c];
+							if (b < b_best || b_best == 0) b_best = b;
+						}
+						double m = a>b_best?a:b_best;
+
+						double s = (b_best - a) / m;
+						if (a_count == 0) s = 0;
+						quality[own] += s;
+					}
+				}
+
+				const std::vector<Point> &			m_points;
+				std::vector<std::size_t>			m_cluster;
+				std::size_t							m_clusters;
+				unsigned int						m_threads;
+				std::vector<double>					m_sum;		// points x clusters
+				std::vector<std::size_t>			m_size, m_live;
+				std::vector<std::size_t>			m_parent;	// the cluster each first one is now part of
+				std::vector<std::vector<double> >	m_part_quality;
+		}; // class silhouette_sweep
+	} // namespace detail
+	
 }} // namespace semantic::analysis
 
 
@@ -0,0 +1,137 @@
+/*
+a front end for the stemmers in semantic/stem/ that remembers what it has
+stemmed.  word frequencies fall off so quickly that most of the words in a
+text are ones we've seen many times already, and looking a word up costs a
+good deal less than running the stemming rules over it again.
+
+the cache is a fixed number of slots that a word hashes to; a new word
+takes over its slot from whatever was there, so the cache never grows past
+its capacity and the common words, which come back before anything can
+push them out, stay in it.
+
+a cached_stemmer isn't locked.  for_this_thread() keeps one for each thread
+(one in all when the Boost thread library wasn't found at configure time),
+which is how the parser, the query and the summarizer use it.
+*/
+
+#ifndef __SEMANTIC_CACHED_STEMMER_HPP__
+#define __SEMANTIC_CACHED_STEMMER_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/stem/english_stem.h>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/tss.hpp>
+#endif
+#include <boost/cstdint.hpp>
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace semantic {
+
+	template <class Stemmer = stemming::english_stem>
+	class cached_stemmer {
+		public:
+			typedef std::basic_string<xchar> string_type;
+
+			struct statistics {
+				unsigned long hits, misses;		// words found / not found
+				unsigned long evictions;		// words that took another's slot
+				std::size_t entries, capacity;
+			};
+
+			// the capacity is rounded up to a power of two; 0 turns the cache off
+			explicit cached_stemmer(std::size_t capacity = 16 * 1024) {
+				set_capacity(capacity);
+				reset_statistics();
+			}
+
+			static cached_stemmer &for_this_thread() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				static boost::thread_specific_ptr<cached_stemmer> stemmer;
+				if (!stemmer.get()) stemmer.reset(new cached_stemmer);
+				return *stemmer;
+#else
+				static cached_stemmer stemmer;
+				return stemmer;
+#endif
+			}
+
+			// stems word in place, just like Stemmer does
+			void operator()(string_type &word) {
+				if (m_slots.empty()) {
+					m_stemmer(word);
+					return;
+				}
+
+				slot &s = m_slots[hash(word) & (m_slots.size() - 1)];
+				if (s.used && s.word == word) {
+					m_stats.hits++;
+					word = s.stem;
+					return;
+				}
+
+				m_stats.misses++;
+				if (s.used) m_stats.evictions++;
+				else m_entries++;
+				s.used = true;
+				s.word = word;
+				m_stemmer(word);
+				s.stem = word;
+			}
+
+			void set_capacity(std::size_t capacity) {
+				std::size_t slots = 0;
+				if (capacity > 0) for(slots = 1; slots < capacity; slots <<= 1);
+				m_slots.clear();
+				m_slots.resize(slots);
+				m_entries = 0;
+			}
+
+			std::size_t get_capacity() const {
+				return m_slots.size();
+			}
+
+			void clear() {
+				set_capacity(m_slots.size());
+			}
+
+			statistics get_statistics() const {
+				statistics s = m_stats;
+				s.entries = m_entries;
+				s.capacity = m_slots.size();
+				return s;
+			}
+
+			void reset_statistics() {
+				m_stats.hits = m_stats.misses = m_stats.evictions = 0;
+				m_stats.entries = m_stats.capacity = 0;
+			}
+
+		private:
+			struct slot {
+				slot() : used(false) {}
+				bool used;
+				string_type word, stem;
+			};
+
+			Stemmer m_stemmer;
+			std::vector<slot> m_slots;
+			std::size_t m_entries;
+			statistics m_stats;
+
+			static std::size_t hash(const string_type &word) {
+				boost::uint32_t h = 2166136261u;	// FNV-1a
+				for(typename string_type::size_type i = 0; i < word.size(); ++i) {
+					h ^= static_cast<boost::uint32_t>(word[i]);
+					h *= 16777619u;
+				}
+				return h;
+			}
+	};
+
+} // namespace semantic
+
+#endif
@@ -0,0 +1,221 @@
+/*
+an array copy of a (sub)graph for the algorithms that run over it.
+
+SEGraph keeps its vertices in a list, so there's no vertex index, and the
+weight and rank maps from weighting_traits are hash maps keyed on
+descriptors.  a compact_subgraph numbers the vertices 0..size()-1, in the
+graph's vertex order, and the edges 0..num_edges()-1, grouped by source as
+compressed sparse rows with each row in the graph's out-edge order.  values
+per vertex or per edge can then live in plain vectors, and index_map_of() makes
+a property map over one of those:
+
+	compact_subgraph<Graph> c(g);		// weighed with g's weighting policy
+	std::vector<double> rank(c.size());
+	compact_spreading_activation(c, g, nodes, rank);
+
+vertex_map() and edge_map() wrap the same vectors in property maps keyed on
+the graph's descriptors, for code that still wants those (and which the
+weighting policies write through; a descriptor that isn't in the copy gets a
+spare slot there, which reads as T() and drops what's written to it).  the
+copy doesn't follow later changes to the graph, which has to outlive it.
+*/
+
+#ifndef __SEMANTIC_COMPACT_SUBGRAPH_HPP__
+#define __SEMANTIC_COMPACT_SUBGRAPH_HPP__
+
+#include <semantic/semantic.hpp>
+#include <semantic/utility.hpp>
+
+#include <boost/graph/properties.hpp>
+#include <boost/graph/iteration_macros.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+
+namespace semantic {
+
+    template <class Compact, class T> class compact_vertex_map;
+    template <class Compact, class T> class compact_edge_map;
+
+    template <class Graph, class Value = typename weighting_traits<Graph>::weight_type>
+    class compact_subgraph {
+        public:
+            typedef typename se_graph_traits<Graph>::vertex_descriptor vertex_descriptor;
+            typedef typename se_graph_traits<Graph>::edge_descriptor edge_descriptor;
+            typedef Value value_type;
+            typedef std::size_t index_type;
+
+            // a property map over vertex or edge numbers, backed by a vector
+            template <class T>
+            struct index_map {
+                typedef boost::iterator_property_map<typename std::vector<T>::iterator,
+                                                     boost::identity_property_map> type;
+            };
+
+            compact_subgraph() : m_graph(0), m_sorted_rows(true) {}
+
+            // weighed by the graph's weighting policy (an SESubgraph's)
+            explicit compact_subgraph(Graph &g) {
+                build(g);
+                g.populate_weight_map(edge_map(weights));
+            }
+
+            // weighed by a weight map keyed on edge descriptors
+            template <class WeightMap>
+            compact_subgraph(Graph &g, WeightMap w) {
+                build(g);
+                for (std::size_t e = 0; e < edges.size(); ++e) weights[e] = get(w, edges[e]);
+            }
+
+            std::size_t size() const { return descriptors.size(); }
+            std::size_t num_edges() const { return targets.size(); }
+
+            void swap(compact_subgraph &other) {
+                descriptors.swap(other.descriptors);
+                first_edge.swap(other.first_edge);
+                targets.swap(other.targets);
+                edges.swap(other.edges);
+                weights.swap(other.weights);
+                hits.swap(other.hits);
+                m_index.swap(other.m_index);
+                std::swap(m_graph, other.m_graph);
+                std::swap(m_sorted_rows, other.m_sorted_rows);
+            }
+
+            // the number of a vertex; size() if it isn't here
+            index_type index_of(vertex_descriptor v) const {
+                typename maps::unordered<vertex_descriptor, index_type>::const_iterator i = m_index.find(v);
+                return i == m_index.end() ? size() : i->second;
+            }
+
+            // the number of an edge; num_edges() if it isn't here
+            index_type edge_index(edge_descriptor e) const {
+                if (!m_graph) return num_edges();
+                index_type u = index_of(source(e, *m_graph));
+                if (u == size()) return num_edges();
+                vertex_descriptor v = target(e, *m_graph);
+
+                std::size_t lo = first_edge[u], hi = first_edge[u + 1];
+                if (m_sorted_rows) {
+                    // (out-edges in a set are kept in target order)
+                    std::less<vertex_descriptor> before;
+                    while (lo < hi) {
+                        std::size_t mid = lo + (hi - lo) / 2;
+                        if (before(descriptors[targets[mid]], v)) lo = mid + 1;
+                        else hi = mid;
+                    }
+                    return lo < first_edge[u + 1] && descriptors[targets[lo]] == v ? lo : num_edges();
+                }
+                for (; lo < hi; ++lo) if (descriptors[targets[lo]] == v) return lo;
+                return num_edges();
+            }
+
+            template <class T>
+            typename index_map<T>::type index_map_of(std::vector<T> &values) const {
+                return typename index_map<T>::type(values.begin(), boost::identity_property_map());
+            }
+
+            template <class T>
+            compact_vertex_map<compact_subgraph, T> vertex_map(std::vector<T> &values) const {
+                return compact_vertex_map<compact_subgraph, T>(*this, values);
+            }
+
+            template <class T>
+            compact_edge_map<compact_subgraph, T> edge_map(std::vector<T> &values) const {
+                return compact_edge_map<compact_subgraph, T>(*this, values);
+            }
+
+            // the vertices, and their out-edges as compressed sparse rows:
+            // vertex i's are edges first_edge[i] up to first_edge[i+1]
+            std::vector<vertex_descriptor> descriptors;
+            std::vector<std::size_t> first_edge;
+            std::vector<index_type> targets;
+            std::vector<edge_descriptor> edges;
+            std::vector<Value> weights;
+            std::vector<int> hits;              // energy_hits
+
+        private:
+            maps::unordered<vertex_descriptor, index_type> m_index;
+            Graph *m_graph;
+            bool m_sorted_rows;
+
+            void build(Graph &g) {
+                m_graph = &g;
+                descriptors.reserve(num_vertices(g));
+                BGL_FORALL_VERTICES_T(v, g, Graph) {
+                    m_index[v] = descriptors.size();
+                    descriptors.push_back(v);
+                }
+
+                m_sorted_rows = true;
+                std::less<vertex_descriptor> before;
+                first_edge.reserve(descriptors.size() + 1);
+                BGL_FORALL_VERTICES_T(u, g, Graph) {
+                    std::size_t row = targets.size();
+                    first_edge.push_back(row);
+                    BGL_FORALL_OUTEDGES_T(u, e, g, Graph) {
+                        vertex_descriptor v = target(e, g);
+                        if (targets.size() > row && !before(descriptors[targets.back()], v)) m_sorted_rows = false;
+                        targets.push_back(m_index[v]);
+                        edges.push_back(e);
+                        hits.push_back(g[e].energy_hits);
+                    }
+                }
+                first_edge.push_back(targets.size());
+                weights.assign(targets.size(), Value());
+            }
+    };
+
+
+    // a vector of values per vertex, keyed on vertex descriptors
+    template <class Compact, class T>
+    class compact_vertex_map : public boost::put_get_helper<T &, compact_vertex_map<Compact, T> > {
+        public:
+            typedef typename Compact::vertex_descriptor key_type;
+            typedef T value_type;
+            typedef T &reference;
+            typedef boost::lvalue_property_map_tag category;
+
+            compact_vertex_map(const Compact &c, std::vector<T> &values) : c(&c), values(&values), spare(new T()) {}
+            T &operator[](const key_type &v) const {
+                std::size_t i = c->index_of(v);
+                if (i < c->size()) return (*values)[i];
+                *spare = T();
+                return *spare;
+            }
+
+        private:
+            const Compact *c;
+            std::vector<T> *values;
+            boost::shared_ptr<T> spare;
+    };
+
+    // and per edge, keyed on edge descriptors
+    template <class Compact, class T>
+    class compact_edge_map : public boost::put_get_helper<T &, compact_edge_map<Compact, T> > {
+        public:
+            typedef typename Compact::edge_descriptor key_type;
+            typedef T value_type;
+            typedef T &reference;
+            typedef boost::lvalue_property_map_tag category;
+
+            compact_edge_map(const Compact &c, std::vector<T> &values) : c(&c), values(&values), spare(new T()) {}
+            T &operator[](const key_type &e) const {
+                std::size_t i = c->edge_index(e);
+                if (i < c->num_edges()) return (*values)[i];
+                *spare = T();
+                return *spare;
+            }
+
+        private:
+            const Compact *c;
+            std::vector<T> *values;
+            boost::shared_ptr<T> spare;
+    };
+
+} // namespace semantic
+
+#endif
@@ -0,0 +1,96 @@
+/*
+small helpers for the multi-threaded parts of the engine (the indexing pipeline
+and friends).  these need the Boost thread library, which is checked for at
+configure time.
+*/
+
+#include <semantic/config.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+
+#ifndef __SEMANTIC_CONCURRENCY_HPP__
+#define __SEMANTIC_CONCURRENCY_HPP__
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/utility.hpp>
+
+#include <deque>
+#include <cstddef>
+
+namespace semantic {
+
+/* *******************************************************
+        BOUNDED QUEUE
+
+        a fixed capacity FIFO between pipeline stages.  push()
+        blocks while the queue is full, which is what keeps a fast
+        stage from running away from a slow one.
+
+        the queue knows how many producers feed it; once each of
+        them has called done(), pop() drains what's left and then
+        returns false.  cancel() wakes everybody up and makes both
+        push() and pop() fail, for bailing out on errors.
+   ******************************************************* */
+    template <class T>
+    class bounded_queue : boost::noncopyable {
+        public:
+            explicit bounded_queue(std::size_t capacity, unsigned int producers = 1)
+                : m_capacity(capacity > 0 ? capacity : 1), m_producers(producers), m_cancelled(false) {}
+
+            bool push(const T &item) {
+                boost::mutex::scoped_lock lock(m_mutex);
+                while (m_items.size() >= m_capacity && !m_cancelled) m_not_full.wait(lock);
+                if (m_cancelled) return false;
+
+                m_items.push_back(item);
+                m_not_empty.notify_one();
+                return true;
+            }
+
+            bool pop(T &item) {
+                boost::mutex::scoped_lock lock(m_mutex);
+                while (m_items.empty() && m_producers > 0 && !m_cancelled) m_not_empty.wait(lock);
+                if (m_cancelled || m_items.empty()) return false;
+
+                item = m_items.front();
+                m_items.pop_front();
+                m_not_full.notify_one();
+                return true;
+            }
+
+            // called by each producer when it has nothing more to push
+            void done() {
+                boost::mutex::scoped_lock lock(m_mutex);
+                if (m_producers > 0) m_producers--;
+                if (m_producers == 0) m_not_empty.notify_all();
+            }
+
+            void cancel() {
+                boost::mutex::scoped_lock lock(m_mutex);
+                m_cancelled = true;
+                m_not_empty.notify_all();
+                m_not_full.notify_all();
+            }
+
+            std::size_t size() {
+                boost::mutex::scoped_lock lock(m_mutex);
+                return m_items.size();
+            }
+
+        private:
+            std::deque<T> m_items;
+            std::size_t m_capacity;
+            unsigned int m_producers;
+            bool m_cancelled;
+
+            boost::mutex m_mutex;
+            boost::condition m_not_empty, m_not_full;
+    };
+
+} // namespace semantic
+
+#endif
+#else // !SEMANTIC_HAVE_BOOST_THREAD
+	#error "Boost thread support was not enabled at install time for the Semantic Engine package."
+#endif
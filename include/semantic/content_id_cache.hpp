@@ -0,0 +1,239 @@
+/*
+a process-wide cache of which vertex each piece of content (a term, a
+document's name) belongs to, shared by every graph using the same storage
+policy.
+
+the storage policies look here in fetch_vertex_ids_by_content_and_type()
+before going to the database, so the terms of one query are found for the
+next without a trip to the database -- and so are the ones that aren't
+there at all, which is remembered too.  contents are filed under a
+collection key (which database, which collection) and their type, and the
+least recently used are thrown out once there are more than the cache's
+capacity.
+
+like the neighbor_cache, a collection's entries go when changes to it are
+committed from this process, and when the storage policy sees a new
+collection version, which it checks once per search.
+
+the cache is locked with a mutex when the Boost thread library was found
+at configure time, and is for single threaded use otherwise.
+*/
+
+#ifndef __SEMANTIC_CONTENT_ID_CACHE_HPP__
+#define __SEMANTIC_CONTENT_ID_CACHE_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/properties.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/utility.hpp>
+
+#include <string>
+#include <map>
+#include <list>
+#include <utility>
+#include <limits>
+#include <cstddef>
+
+namespace semantic {
+
+	template <class StoragePolicySelector>
+	class content_id_cache : boost::noncopyable {
+		typedef se_graph_traits<StoragePolicySelector> traits;
+		typedef typename traits::vertex_id_type id_type;
+
+		public:
+			struct statistics {
+				unsigned long hits, misses;		// contents found / not found
+				unsigned long evictions;		// entries thrown out to stay in capacity
+				unsigned long invalidations;	// collections dropped after a change
+				std::size_t entries, capacity;
+			};
+
+			explicit content_id_cache(std::size_t capacity = 64 * 1024) : m_capacity(capacity) {
+				reset_statistics();
+			}
+
+			// the one every graph of this storage policy uses
+			static content_id_cache &shared() {
+				static content_id_cache cache;
+				return cache;
+			}
+
+			// a capacity of 0 turns the cache off
+			void set_capacity(std::size_t entries) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_capacity = entries;
+				trim();
+			}
+
+			std::size_t get_capacity() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_capacity;
+			}
+
+			bool enabled() {
+				return get_capacity() > 0;
+			}
+
+			// looks up the contents i -> i_end of the given type: found gets a
+			// std::pair<std::string, id_type> for each one with a vertex, and
+			// missing gets the ones we know nothing about (contents known not
+			// to have a vertex go to neither)
+			template <class ContentIterator, class FoundIterator, class MissingIterator>
+			void find(const std::string &collection, int type, ContentIterator i, ContentIterator i_end,
+					  FoundIterator found, MissingIterator missing) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				for(; i != i_end; ++i) {
+					typename index_type::iterator e = m_index.find(key_type(collection, type, *i));
+					if (e == m_index.end()) {
+						m_stats.misses++;
+						*missing = *i;
+						continue;
+					}
+
+					m_entries.splice(m_entries.begin(), m_entries, e->second);
+					if (e->second->found) *found = std::make_pair(std::string(*i), e->second->id);
+					m_stats.hits++;
+				}
+			}
+
+			// remembers what was fetched for the contents i -> i_end; the ones
+			// that aren't in fetched have no vertex of this type
+			template <class ContentIterator>
+			void insert(const std::string &collection, int type, ContentIterator i, ContentIterator i_end,
+						const std::map<std::string, id_type> &fetched) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				if (m_capacity == 0) return;
+
+				for(; i != i_end; ++i) {
+					key_type key(collection, type, *i);
+					typename index_type::iterator old = m_index.find(key);
+					if (old != m_index.end()) remove(old);
+
+					m_entries.push_front(entry());
+					entry &e = m_entries.front();
+					e.key = key;
+					typename std::map<std::string, id_type>::const_iterator f = fetched.find(*i);
+					e.found = f != fetched.end();
+					e.id = e.found ? f->second : id_type();
+					m_index.insert(std::make_pair(key, m_entries.begin()));
+				}
+				trim();
+			}
+
+			// drops the collection's entries if they were cached against some
+			// other version of it
+			void validate(const std::string &collection, const std::string &version) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				std::map<std::string, std::string>::iterator v = m_versions.find(collection);
+				if (v != m_versions.end() && v->second == version) return;
+				if (v != m_versions.end()) drop(collection);
+				m_versions[collection] = version;
+			}
+
+			void invalidate(const std::string &collection) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				drop(collection);
+				m_versions.erase(collection);
+			}
+
+			void clear() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_entries.clear();
+				m_index.clear();
+				m_versions.clear();
+			}
+
+			statistics get_statistics() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				statistics s = m_stats;
+				s.entries = m_index.size();
+				s.capacity = m_capacity;
+				return s;
+			}
+
+			void reset_statistics() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_stats.hits = m_stats.misses = m_stats.evictions = m_stats.invalidations = 0;
+				m_stats.entries = m_stats.capacity = 0;
+			}
+
+		private:
+			// (collection, type, content), ordered by collection first so
+			// drop() can find a collection's entries together
+			struct key_type {
+				key_type() : type(0) {}
+				key_type(const std::string &c, int t, const std::string &s) : collection(c), type(t), content(s) {}
+				std::string collection;
+				int type;
+				std::string content;
+
+				bool operator<(const key_type &k) const {
+					if (collection != k.collection) return collection < k.collection;
+					if (type != k.type) return type < k.type;
+					return content < k.content;
+				}
+			};
+			struct entry {
+				key_type key;
+				bool found;
+				id_type id;
+			};
+			typedef std::list<entry> list_type;
+			typedef std::map<key_type, typename list_type::iterator> index_type;
+
+			list_type m_entries;	// most recently used first
+			index_type m_index;
+			std::map<std::string, std::string> m_versions;
+			std::size_t m_capacity;
+			statistics m_stats;
+#if SEMANTIC_HAVE_BOOST_THREAD
+			boost::mutex m_mutex;
+#endif
+
+			// (the lock is held for all of these)
+			void remove(typename index_type::iterator i) {
+				m_entries.erase(i->second);
+				m_index.erase(i);
+			}
+
+			void drop(const std::string &collection) {
+				typename index_type::iterator i = m_index.lower_bound(key_type(collection, (std::numeric_limits<int>::min)(), ""));
+				if (i == m_index.end() || i->first.collection != collection) return;
+				while (i != m_index.end() && i->first.collection == collection) remove(i++);
+				m_stats.invalidations++;
+			}
+
+			void trim() {
+				while (m_index.size() > m_capacity && !m_entries.empty()) {
+					m_index.erase(m_entries.back().key);
+					m_entries.pop_back();
+					m_stats.evictions++;
+				}
+			}
+	};
+
+} // namespace semantic
+
+#endif
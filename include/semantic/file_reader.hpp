@@ -7,11 +7,21 @@ classes to help with indexing texts (or other things) into a Semantic Graph
 
 #include <semantic/semantic.hpp>
 #include <semantic/filter.hpp>
+#include <boost/utility.hpp>
+#include <boost/cstdint.hpp>
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/tss.hpp>
+#endif
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <deque>
+#include <vector>
 #include <string>
+#include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstring>
 #if SEMANTIC_HAVE_MSWORD_READER
 #include <msword-reader.hpp>
 #endif
@@ -23,74 +33,500 @@ classes to help with indexing texts (or other things) into a Semantic Graph
 namespace semantic {
 
 
-	inline std::string
-	convert_to_utf8( const std::string& text, const std::string& encoding )
+	// how much of [p, end) is plain ASCII, checked eight bytes at a time
+	inline const char* ascii_prefix( const char* p, const char* end )
 	{
-		std::string lower(encoding);
-		std::transform(encoding.begin(),encoding.end(),lower.begin(),tolower);
-		
-		if( lower == "utf8" || lower == "utf-8" ){
-			return text;
-
-		} else if ( encoding.size() > 0 ) {
-			iconv_t cd;
-			cd = iconv_open( "utf8", encoding.c_str() );
-			if( cd != (iconv_t)(-1) && text.size() > 0 ){
-				
-				std::string::size_type len = text.size();
-				char *utfForm = new char[len*3+1];
-				std::string mtext = text;
-#if ICONV_CONST					
-				const char *pin = const_cast<char *>(mtext.c_str());
+		const boost::uint64_t highs = (~boost::uint64_t(0) / 255) * 0x80;
+		while( end - p >= 8 ){
+			boost::uint64_t w;
+			std::memcpy( &w, p, 8 );
+			if( w & highs ) break;
+			p += 8;
+		}
+		while( p < end && !(*p & 0x80) ) ++p;
+		return p;
+	}
+
+	// how much of [p, end) is well formed UTF-8: no stray continuation
+	// bytes, truncated or overlong sequences, surrogates or code points
+	// past U+10FFFF
+	inline const char* valid_utf8_prefix( const char* p, const char* end )
+	{
+		while( (p = ascii_prefix( p, end )) < end ){
+			unsigned char c = *p;
+			std::size_t length = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+			if( c < 0xc2 || c > 0xf4 || static_cast<std::size_t>(end - p) < length )
+				return p;
+
+			unsigned char b = p[1];
+			// the second byte's range depends on the first
+			unsigned char low = c == 0xe0 ? 0xa0 : c == 0xf0 ? 0x90 : 0x80;
+			unsigned char high = c == 0xed ? 0x9f : c == 0xf4 ? 0x8f : 0xbf;
+			if( b < low || b > high )
+				return p;
+			for( std::size_t i = 2; i < length; ++i ){
+				if( (static_cast<unsigned char>(p[i]) & 0xc0) != 0x80 )
+					return p;
+			}
+			p += length;
+		}
+		return p;
+	}
+
+	// bytes that can't be read as anything else are taken to be Latin-1
+	inline void append_latin1( const char* p, const char* end, std::string& out )
+	{
+		for( ; p < end; ++p ){
+			unsigned char c = *p;
+			if( c < 0x80 ){
+				out += static_cast<char>(c);
+			} else {
+				out += static_cast<char>(0xc0 | (c >> 6));
+				out += static_cast<char>(0x80 | (c & 0x3f));
+			}
+		}
+	}
+
+	// copies what's valid UTF-8 in [p, end) onto the end of out, and the
+	// bytes that aren't as Latin-1
+	inline void append_repaired_utf8( const char* p, const char* end, std::string& out )
+	{
+		const char* valid = valid_utf8_prefix( p, end );
+		while( valid < end ){
+			out.append( p, valid );
+			append_latin1( valid, valid + 1, out );
+			p = valid + 1;
+			valid = valid_utf8_prefix( p, end );
+		}
+		out.append( p, end );
+	}
+
+	// where a UTF-8 character cut off by the end of [p, end) starts; end if
+	// the last one's whole
+	inline const char* utf8_cut_off( const char* p, const char* end )
+	{
+		for( const char* q = end; q > p && end - q < 4; ){
+			unsigned char c = *--q;
+			if( (c & 0xc0) == 0x80 ) continue;		// a continuation byte
+			std::size_t length = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : c >= 0xc0 ? 2 : 1;
+			return static_cast<std::size_t>(end - q) < length ? q : end;
+		}
+		return end;
+	}
+
+	// iconvs [p, end) onto the end of out (through buffer), reading bytes
+	// that aren't from the source character set as Latin-1.  returns where
+	// it stopped: end, or the start of a character cut off by the end
+	inline const char* iconv_append( iconv_t cd, const char* p, const char* end,
+									 std::vector<char>& buffer, std::string& out )
+	{
+#if ICONV_CONST
+		const char *pin = p;
 #else
-				char *pin = const_cast<char *>(mtext.c_str());
+		char *pin = const_cast<char *>(p);
 #endif
+		size_t in_left = end - p;
+		while( in_left > 0 ){
+			char *pout = &buffer[0];
+			size_t out_left = buffer.size();
+			size_t r = iconv( cd, &pin, &in_left, &pout, &out_left );
+			out.append( &buffer[0], pout - &buffer[0] );
+			if( r != (size_t)(-1) || errno == E2BIG ) continue;
+			if( errno == EINVAL ) break;				// incomplete character
+			if( errno != EILSEQ ){
+				std::cerr << "Iconv error: " << strerror(errno) << std::endl;
+				append_latin1( pin, end, out );
+				return end;
+			}
+			// not from the source character set
+			append_latin1( pin, pin + 1, out );
+			pin++;
+			in_left--;
+		}
+		return end - in_left;
+	}
 
-				size_t inLeft = len;
-				size_t outLeft = len*3+1;
-				char *pout = utfForm;
-				while( inLeft != 0 ){
-					size_t conversion = iconv( cd, &pin, &inLeft, &pout, &outLeft );
-					if( conversion == (size_t) -1 ){
-						switch( errno ){
-							case EILSEQ:
-								/* input char encountered that doesn't belong */
-								std::cerr << "Character not from source char set: " << strerror(errno) << std::endl;
-								delete[] utfForm;
-								return text;
-							case EINVAL:
-								/* incomplete character encountered */
-								std::cerr << "Incomplete character or shift sequence: " << strerror(errno) << std::endl;
-								delete[] utfForm;
-								return text;
-							case E2BIG:
-								std::cerr << "Ran out of space in the buffer" << std::endl;
-							
-							default:
-								std::cerr << "Iconv error: " << strerror(errno) << std::endl;
-								delete[] utfForm;
-								return text;
-						}
+
+/* *******************************************************
+		UTF-8 CONVERTER
+
+		converts text to UTF-8, keeping the iconv descriptor for
+		each source encoding it has seen open for the next
+		document rather than opening (and leaking) one per call.
+		the converted text goes out through a fixed buffer, so
+		there's no copy of the input and no worst case sized
+		allocation either.
+
+		text that doesn't need iconv doesn't get it: the pure
+		ASCII start of text in an ASCII compatible encoding is
+		copied as it is, and text that's meant to be UTF-8
+		already is only checked (any bytes that aren't part of
+		a proper UTF-8 sequence are taken to be Latin-1, as are
+		bytes iconv can't convert -- document_stream does the
+		same, so a file reads the same either way).
+
+		iconv descriptors can't be shared between threads, so
+		each thread should have its own converter --
+		for_this_thread() keeps one per thread.
+   ******************************************************* */
+	class utf8_converter : boost::noncopyable {
+		public:
+			utf8_converter() : m_buffer(64 * 1024) {}
+
+			~utf8_converter(){
+				for( source_map::iterator s = m_sources.begin(); s != m_sources.end(); ++s ){
+					if( s->second.cd != (iconv_t)(-1) ) iconv_close( s->second.cd );
+				}
+			}
+
+			static utf8_converter& for_this_thread(){
+#if SEMANTIC_HAVE_BOOST_THREAD
+				static boost::thread_specific_ptr<utf8_converter> converter;
+				if( !converter.get() ) converter.reset( new utf8_converter );
+				return *converter;
+#else
+				static utf8_converter converter;
+				return converter;
+#endif
+			}
+
+			std::string operator()( const std::string& text, const std::string& encoding ){
+				std::string utf8;
+				convert( text, encoding, utf8 );
+				return utf8;
+			}
+
+			// text (in encoding) -> out in UTF-8.  if there's no converting
+			// from encoding out gets the text as it is and we return false
+			bool convert( const std::string& text, const std::string& encoding, std::string& out ){
+				const char* begin = text.data();
+				const char* end = begin + text.size();
+
+				out.clear();
+				if( text.empty() ) return true;
+
+				// (with no encoding it had better be UTF-8)
+				source& s = lookup( encoding.empty() ? std::string("utf-8") : encoding );
+				if( s.utf8 ){
+					if( valid_utf8_prefix( begin, end ) == end ){
+						out = text;
+					} else {
+						out.reserve( text.size() + 16 );
+						append_repaired_utf8( begin, end, out );
 					}
+					return true;
+				}
+				if( s.cd == (iconv_t)(-1) ){
+					out = text;
+					return false;
 				}
-				std::string utf8(utfForm);
-				delete[] utfForm;
-				iconv_close(cd);
-				if( utf8.length() > text.length() ) {
-					//std::cout << utf8.substr(0,text.length()+1) << std::endl;
-					return utf8.substr(0,text.length()+1 );
 
-				} else {
-					return utf8;
+				const char* p = begin;
+				if( s.ascii_compatible ){
+					p = ascii_prefix( begin, end );
+					if( p == end ){
+						out = text;
+						return true;
+					}
 				}
-				
+
+				out.reserve( text.size() + text.size() / 4 );
+				out.append( begin, p );
+
+				// start from the initial shift state, whatever the last one left
+				iconv( s.cd, NULL, NULL, NULL, NULL );
+				p = iconv_append( s.cd, p, end, m_buffer, out );
+				if( p < end ){
+					std::cerr << "Incomplete character or shift sequence at the end of the text, read as Latin-1" << std::endl;
+					append_latin1( p, end, out );
+				}
+
+				// and anything it needs to get back to the initial state
+				char *pout = &m_buffer[0];
+				size_t out_left = m_buffer.size();
+				iconv( s.cd, NULL, NULL, &pout, &out_left );
+				out.append( &m_buffer[0], pout - &m_buffer[0] );
+				return true;
 			}
+
+		private:
+			struct source {
+				iconv_t cd;
+				bool utf8;				// no conversion, just checking
+				bool ascii_compatible;	// ASCII comes through iconv unchanged
+			};
+			typedef std::map<std::string, source> source_map;
+
+			source_map m_sources;
+			std::vector<char> m_buffer;
+
+			source& lookup( const std::string& encoding ){
+				source_map::iterator i = m_sources.find( encoding );
+				if( i != m_sources.end() ) return i->second;
+
+				std::string lower(encoding);
+				std::transform(encoding.begin(),encoding.end(),lower.begin(),tolower);
+
+				source s;
+				s.cd = (iconv_t)(-1);
+				s.utf8 = lower == "utf8" || lower == "utf-8";
+				s.ascii_compatible = lower.compare(0, 8, "iso-8859") == 0 || lower.compare(0, 7, "iso8859") == 0 ||
+									 lower.compare(0, 5, "latin") == 0 || lower.compare(0, 10, "windows-12") == 0 ||
+									 lower.compare(0, 4, "cp12") == 0 || lower == "ascii" || lower == "us-ascii";
+				if( !s.utf8 ){
+					s.cd = iconv_open( "utf8", encoding.c_str() );
+					if( s.cd == (iconv_t)(-1) )
+						std::cerr << "Couldn't convert from " << encoding << ", reading the text as it is" << std::endl;
+				}
+				return m_sources.insert( std::make_pair(encoding, s) ).first->second;
+			}
+	};
+
+
+	inline std::string
+	convert_to_utf8( const std::string& text, const std::string& encoding )
+	{
+		return utf8_converter::for_this_thread()( text, encoding );
+	}
+
+
+
+	// reads the rest of a stream a block at a time, the way the getline()
+	// loops did (every line ends up ending in a newline) but without growing
+	// the string a line at a time
+	inline std::string read_text( std::istream& in )
+	{
+		std::string text;
+		std::vector<char> block(64 * 1024);
+		while( in ){
+			in.read( &block[0], block.size() );
+			text.append( &block[0], (std::string::size_type)in.gcount() );
 		}
+		if( text.size() > 0 && text[text.size()-1] != '\n' )
+			text += '\n';
 		return text;
 	}
-	
-	
-	
+
+
+/* *******************************************************
+		DOCUMENT STREAM
+
+		reads plain text from a stream in fixed size blocks and
+		hands it back one document at a time, so arbitrarily
+		large inputs (mailing list archives, log exports) can be
+		indexed without holding more than a block and a document
+		in memory.  the blocks are converted to UTF-8 as they're
+		read, carrying multibyte characters split between blocks
+		over to the next one, and reading the bytes that can't
+		be converted (or a character cut off by the end of the
+		stream) as Latin-1, like utf8_converter does.  UTF-8
+		is only checked, the same way.
+
+		where one document ends and the next begins:
+			- split_on_paragraphs(n): after every n paragraphs
+			  (runs of lines ending at a blank line)
+			- split_on_delimiter(line): at each line that is
+			  exactly `line`, which is dropped
+			- otherwise the whole stream is one document
+		either way no document grows past the maximum document
+		size (1MB by default); a longer one is cut at the last
+		sentence end before the limit, or at the last space if
+		there isn't one, so the tagger never gets half a
+		sentence.
+   ******************************************************* */
+	class document_stream : boost::noncopyable {
+		public:
+			// UTF-8 (or an empty encoding) is checked rather than converted
+			document_stream( std::istream& in, const std::string& encoding = "" )
+				: m_in(in), m_block_size(64 * 1024), m_max_document_size(1024 * 1024),
+				  m_paragraphs(0), m_paragraph_count(0), m_in_paragraph(false),
+				  m_documents(0), m_cd((iconv_t)(-1))
+			{
+				std::string lower(encoding);
+				std::transform(encoding.begin(),encoding.end(),lower.begin(),tolower);
+				m_utf8 = lower.size() == 0 || lower == "utf8" || lower == "utf-8";
+				if( !m_utf8 ){
+					m_cd = iconv_open( "utf8", encoding.c_str() );
+					if( m_cd == (iconv_t)(-1) )
+						std::cerr << "Couldn't convert from " << encoding << ", reading the text as it is" << std::endl;
+				}
+			}
+
+			~document_stream() {
+				if( m_cd != (iconv_t)(-1) ) iconv_close( m_cd );
+			}
+
+			void set_block_size( std::size_t bytes ){ m_block_size = bytes > 0 ? bytes : 1; }
+			std::size_t get_block_size() const { return m_block_size; }
+
+			// 0 means no limit
+			void set_max_document_size( std::size_t bytes ){ m_max_document_size = bytes; }
+			std::size_t get_max_document_size() const { return m_max_document_size; }
+
+			void split_on_paragraphs( unsigned int n ){ m_paragraphs = n; }
+			void split_on_delimiter( const std::string& line ){ m_delimiter = line; }
+
+			// the next document's text; false once the stream has run out
+			bool next( std::string& text ){
+				while( m_ready.empty() ){
+					if( !fill() ){
+						// whatever's left over is the last document
+						take_line( m_partial );
+						m_partial.clear();
+						finish_document();
+						if( m_ready.empty() ) return false;
+						break;
+					}
+				}
+				text.swap( m_ready.front() );
+				m_ready.pop_front();
+				m_documents++;
+				return true;
+			}
+
+			// how many documents next() has handed out
+			unsigned int count() const { return m_documents; }
+
+		private:
+			std::istream& m_in;
+			std::size_t m_block_size, m_max_document_size;
+			unsigned int m_paragraphs, m_paragraph_count;
+			bool m_in_paragraph;
+			std::string m_delimiter;
+			unsigned int m_documents;
+
+			bool m_utf8;					// check it, don't convert it
+			iconv_t m_cd;
+			std::vector<char> m_raw;		// read but not converted yet
+			std::vector<char> m_converted;
+			std::string m_partial;			// the line we're in the middle of
+			std::string m_document;			// the document we're building
+			std::deque<std::string> m_ready;
+
+			// reads and converts another block, and splits its lines into
+			// documents; false at the end of the stream
+			bool fill(){
+				if( m_in ){
+					std::size_t kept = m_raw.size();
+					m_raw.resize( kept + m_block_size );
+					m_in.read( &m_raw[kept], m_block_size );
+					m_raw.resize( kept + (std::size_t)m_in.gcount() );
+				}
+				if( m_raw.empty() ) return false;
+
+				// (once the stream's run out, nothing's coming to finish a
+				// character that's been cut off)
+				convert( !m_in );
+
+				// whole lines go to the document, the rest waits for the next block
+				std::string::size_type start = 0, end;
+				while( (end = m_partial.find('\n', start)) != std::string::npos ){
+					take_line( m_partial.substr(start, end - start + 1) );
+					start = end + 1;
+				}
+				m_partial.erase( 0, start );
+
+				// a line that long isn't going to end in a delimiter
+				if( m_max_document_size && m_partial.size() > m_max_document_size ){
+					m_document += m_partial;
+					m_partial.clear();
+					cut_document();
+				}
+				return true;
+			}
+
+			// converts the raw bytes onto the end of m_partial, keeping a
+			// character that's split across blocks for next time -- unless
+			// it's the last block
+			void convert( bool last ){
+				const char *begin = &m_raw[0], *end = begin + m_raw.size();
+				const char *p = end;
+				if( m_utf8 ){
+					if( !last ) p = utf8_cut_off( begin, end );
+					append_repaired_utf8( begin, p, m_partial );
+				} else if( m_cd == (iconv_t)(-1) ){
+					m_partial.append( begin, end );
+				} else {
+					m_converted.resize( m_raw.size() * 4 + 16 );
+					p = iconv_append( m_cd, begin, end, m_converted, m_partial );
+					if( last ){
+						if( p < end ){
+							std::cerr << "Incomplete character or shift sequence at the end of the text, read as Latin-1" << std::endl;
+							append_latin1( p, end, m_partial );
+							p = end;
+						}
+						// and anything it needs to get back to the initial state
+						char *pout = &m_converted[0];
+						size_t out_left = m_converted.size();
+						iconv( m_cd, NULL, NULL, &pout, &out_left );
+						m_partial.append( &m_converted[0], pout - &m_converted[0] );
+					}
+				}
+				m_raw.erase( m_raw.begin(), m_raw.begin() + (p - begin) );
+			}
+
+			// a line, newline and all (except maybe at the very end)
+			void take_line( const std::string& line ){
+				if( line.empty() ) return;
+
+				if( m_delimiter.size() > 0 ){
+					std::string::size_type n = line.size();
+					while( n > 0 && (line[n-1] == '\n' || line[n-1] == '\r') ) n--;
+					if( line.compare(0, n, m_delimiter) == 0 && n == m_delimiter.size() ){
+						finish_document();
+						return;
+					}
+				}
+
+				bool blank = line.find_first_not_of(" \t\r\n") == std::string::npos;
+				if( blank && m_document.empty() ) return;	// between documents
+				m_document += line;
+				if( m_paragraphs > 0 ){
+					if( blank && m_in_paragraph && ++m_paragraph_count >= m_paragraphs )
+						finish_document();
+					m_in_paragraph = !blank;
+				}
+				cut_document();
+			}
+
+			void finish_document(){
+				if( m_document.find_first_not_of(" \t\r\n") != std::string::npos ){
+					m_ready.push_back( std::string() );
+					m_ready.back().swap( m_document );
+				}
+				m_document.clear();
+				m_paragraph_count = 0;
+				m_in_paragraph = false;
+			}
+
+			// split an oversized document, at a sentence end if we can
+			void cut_document(){
+				while( m_max_document_size && m_document.size() > m_max_document_size ){
+					std::string::size_type cut = sentence_end( m_max_document_size );
+					m_ready.push_back( m_document.substr(0, cut) );
+					std::string::size_type next = m_document.find_first_not_of(" \t\r\n", cut);
+					m_document.erase( 0, next == std::string::npos ? m_document.size() : next );
+				}
+			}
+
+			// where to cut the document so the first part is at most `limit` bytes
+			std::string::size_type sentence_end( std::string::size_type limit ) const {
+				const std::string& d = m_document;
+				for( std::string::size_type i = limit; i > 1; i-- ){
+					char c = d[i-2];
+					if( (c == '.' || c == '!' || c == '?') && isspace((unsigned char)d[i-1]) ) return i;
+				}
+				for( std::string::size_type i = limit; i > 0; i-- ){
+					if( isspace((unsigned char)d[i-1]) ) return i;
+				}
+				// no spaces at all; don't split a UTF-8 character
+				std::string::size_type i = limit;
+				while( i > 1 && (d[i] & 0xC0) == 0x80 ) i--;
+				return i;
+			}
+	};
+
+
 	class file_reader {
 		public:
 			file_reader(){ pdfLayout = "layout"; }
@@ -156,13 +592,8 @@ namespace semantic {
 			std::string default_encoding;
 			
 			std::string stream_to_text( std::istream& filestream, const std::string& mime_type ){
-				std::string line;
-				std::string text;
+				std::string text = read_text( filestream );
 				std::string encoding;
-				while( std::getline( filestream, line )) 
-				{
-					text.append(line+'\n');
-				}
 				
 				if( mime_type == "application/rtf" ){
 					rtf_filter filter;
@@ -232,17 +663,13 @@ namespace semantic {
 
 				} else {
 
-					std::string line;
 					std::ifstream file(filename.c_str(), std::ios_base::in);
 					
 					if( ! file ){
 						std::cerr << "Warning: Could not read file!" << std::endl;
 						exit(EXIT_FAILURE);
 					}
-					while( std::getline( file, line )) 
-					{
-						text.append(line+'\n');
-					}
+					text = read_text( file );
 					file.clear();
 					file.close();
 									
@@ -7,9 +7,15 @@
 */
 
 
+#include <boost/cstdint.hpp>
+
 #include <string>
 #include <set>
+#include <map>
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 
@@ -207,115 +213,248 @@ namespace semantic {
 
     };
 
-    class smart_quotes_filter : public text_filter {
+/* *******************************************************
+        TEXT NORMALIZER
+
+    cleans text up on its way to the parser in one pass:
+    the typographic dashes, quotes and bullets become their
+    ASCII equivalents (a run of them becomes just one), and
+    optionally HTML entities are decoded and whitespace is
+    folded.  runs of plain ASCII are checked and copied
+    eight bytes at a time, so English text goes through at
+    close to the speed of a copy.
+   ******************************************************* */
+
+    class text_normalizer : public text_filter {
 
         public:
+            text_normalizer() : entities(false), whitespace(false) {}
+
+            // &amp; &quot; &rsquo; &#8220; &#x2019; etc. become the
+            // characters they stand for
+            void decode_entities( bool b ){ entities = b; }
+
+            // runs of spaces, tabs and no-break spaces become one space,
+            // and more than two line breaks in a row become two
+            void fold_whitespace( bool b ){ whitespace = b; }
+
             std::string operator()( const std::string& text ){
-                std::string cleaned(text);
-                std::string delim;
-                std::string replace;
-                std::string::size_type nextPos;
-                std::string::size_type pos;
-
-#ifndef WIN32
-				delim = "\u2015";
-                replace = "";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
-                    } else {
-                        cleaned.replace(pos,1,replace);
+                std::string cleaned;
+                normalize( text, cleaned );
+                return cleaned;
+            }
+
+            // the same, into a buffer the caller can reuse
+            void normalize( const std::string& text, std::string& out ){
+                out.clear();
+                out.reserve( text.size() );
+
+                const char* p = text.data();
+                const char* end = p + text.size();
+                int last = none;        // what the last character was
+                int newlines = 0;       // line breaks in a row so far
+
+                while( p < end ){
+                    const char* q = plain_run( p, end );
+                    if( q != p ){
+                        out.append( p, q - p );
+                        p = q;
+                        last = none;
+                        newlines = 0;
+                        continue;
                     }
-                    pos = cleaned.find_first_of(delim,pos);
-                }
-                
 
-                delim = "\u2010\u2011";
-                replace = "-";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
+                    unsigned char c = *p;
+                    unsigned long code = c;
+                    std::size_t length = 1;
+                    if( c >= 0x80 )
+                        length = decode( p, end, code );
+                    else if( c == '&' && entities )
+                        length = entity( p, end, code );
+
+                    int kind = classify( code );
+                    if( kind == blank ){
+                        if( last != blank && !out.empty() && out[out.size()-1] != '\n' )
+                            out += ' ';
+                    } else if( kind == newline ){
+                        if( !out.empty() && out[out.size()-1] == ' ' )
+                            out.erase( out.size()-1 );
+                        if( newlines++ < 2 )
+                            out += '\n';
+                    } else if( kind != none ){
+                        if( kind != last )
+                            out += replacement( kind );
+                    } else if( c == '&' && length > 1 ){
+                        append_utf8( code, out );
                     } else {
-                        cleaned.replace(pos,1,replace);
+                        out.append( p, length );
                     }
-                    pos = cleaned.find_first_of(delim,pos);
+
+                    if( kind != blank && kind != newline )
+                        newlines = 0;
+                    last = kind;
+                    p += length;
                 }
-#endif                
+            }
 
-#ifdef WIN32
-                delim = "\u2013\u2014";
-#else
-				delim = "\u2012\u2013\u2014";
-#endif
-                replace = "--";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
-                    } else {
-                        cleaned.replace(pos,1,replace);
-                    }
-                    pos = cleaned.find_first_of(delim,pos);
+        private:
+            typedef boost::uint64_t word;
+
+            enum { none, blank, newline, bar, hyphen, dash, single_quote, double_quote, bullet };
+
+            bool entities;
+            bool whitespace;
+
+            static const char* replacement( int kind ){
+                switch( kind ){
+                    case hyphen:        return "-";
+                    case dash:          return "--";
+                    case single_quote:  return "'";
+                    case double_quote:  return "\"";
+                    case bullet:        return "*";
+                    default:            return "";
                 }
-                
+            }
 
-                delim = "\u2018\u2019";
-                replace = "'";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
-                    } else {
-                        cleaned.replace(pos,1,replace);
-                    }
-                    pos = cleaned.find_first_of(delim,pos);
+            int classify( unsigned long code ) const {
+                switch( code ){
+                    case 0x2015:                        return bar;
+                    case 0x2010: case 0x2011:           return hyphen;
+                    case 0x2012: case 0x2013:
+                    case 0x2014:                        return dash;
+                    case 0x2018: case 0x2019:           return single_quote;
+                    case 0x201c: case 0x201d:           return double_quote;
+                    case 0x2022:                        return bullet;
+                    case ' ': case '\t': case '\r':
+                    case '\f': case '\v': case 0xa0:    return whitespace ? blank : none;
+                    case '\n':                          return whitespace ? newline : none;
+                    default:                            return none;
                 }
-                
+            }
 
-                delim = "\u201d\u201c";
-                replace = "\"";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
-                    } else {
-                        cleaned.replace(pos,1,replace);
+            // a byte we can copy straight through
+            bool plain( unsigned char c ) const {
+                return c < 0x80 && !(entities && c == '&') && !(whitespace && c <= ' ');
+            }
+
+            // how far from p the text can be copied as it is
+            const char* plain_run( const char* p, const char* end ) const {
+                const word ones = ~word(0) / 255;
+                const word highs = ones * 0x80;
+                const word amps = ones * '&';
+                const char* start = p;
+
+                while( p < end ){
+                    if( end - p >= 8 ){
+                        word w;
+                        std::memcpy( &w, p, 8 );
+                        word found = w & highs;
+                        if( entities ){
+                            word x = w ^ amps;
+                            found |= (x - ones) & ~x & highs;
+                        }
+                        if( whitespace )
+                            found |= (w - ones * 0x21) & ~w & highs;
+                        if( !found ){
+                            p += 8;
+                            continue;
+                        }
                     }
-                    pos = cleaned.find_first_of(delim,pos);
-                }
-                
 
-                delim = "\u2022";
-                replace = "*";
-                
-                pos = cleaned.find_first_of(delim,0);
-                while( pos != std::string::npos ){
-                    nextPos = cleaned.find_first_not_of(delim,pos);
-                    if( nextPos != std::string::npos ){
-                        cleaned.replace(pos,nextPos-pos,replace);
-                    } else {
-                        cleaned.replace(pos,1,replace);
+                    // something in the next eight bytes, find it. a single
+                    // space between two words is fine as it is, though
+                    const char* stop = std::min( p + 8, end );
+                    for( ; p < stop; ++p ){
+                        if( plain( *p ) ) continue;
+                        if( whitespace && *p == ' ' && p != start && p + 1 < end &&
+                            plain( p[-1] ) && plain( p[1] ) ) continue;
+                        return p;
                     }
-                    pos = cleaned.find_first_of(delim,pos);
                 }
-                
+                return p;
+            }
 
-                return cleaned;
+            // the UTF-8 sequence at p; anything malformed is passed on a
+            // byte at a time
+            static std::size_t decode( const char* p, const char* end, unsigned long& code ){
+                unsigned char c = *p;
+                std::size_t length = c >= 0xf8 ? 1 : c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : c >= 0xc0 ? 2 : 1;
+                code = c;
+                if( length == 1 || static_cast<std::size_t>(end - p) < length )
+                    return 1;
+
+                unsigned long decoded = c & (0x7f >> length);
+                for( std::size_t i = 1; i < length; ++i ){
+                    unsigned char b = p[i];
+                    if( (b & 0xc0) != 0x80 )
+                        return 1;
+                    decoded = (decoded << 6) | (b & 0x3f);
+                }
+                code = decoded;
+                return length;
+            }
+
+            // the entity at p, or just the '&' if it isn't one we know
+            static std::size_t entity( const char* p, const char* end, unsigned long& code ){
+                static const struct { const char* name; unsigned long code; } named[] = {
+                    { "amp", '&' }, { "lt", '<' }, { "gt", '>' }, { "quot", '"' },
+                    { "apos", '\'' }, { "nbsp", 0xa0 }, { "ndash", 0x2013 },
+                    { "mdash", 0x2014 }, { "lsquo", 0x2018 }, { "rsquo", 0x2019 },
+                    { "ldquo", 0x201c }, { "rdquo", 0x201d }, { "bull", 0x2022 },
+                    { "hellip", 0x2026 }
+                };
+
+                code = '&';
+                const char* semi = p + 1;
+                while( semi < end && semi - p < 12 && *semi != ';' ) ++semi;
+                if( semi >= end || *semi != ';' || semi - p < 3 )
+                    return 1;
+
+                std::string name( p + 1, semi );
+                unsigned long value = 0;
+                if( name[0] == '#' ){
+                    bool hex = name[1] == 'x' || name[1] == 'X';
+                    const char* digits = name.c_str() + (hex ? 2 : 1);
+                    if( !std::isxdigit( static_cast<unsigned char>(*digits) ) )
+                        return 1;
+                    char* rest;
+                    value = std::strtoul( digits, &rest, hex ? 16 : 10 );
+                    if( *rest || value == 0 || value > 0x10ffff || (value >= 0xd800 && value <= 0xdfff) )
+                        return 1;
+                } else {
+                    std::size_t i = 0, n = sizeof(named) / sizeof(named[0]);
+                    while( i < n && name != named[i].name ) ++i;
+                    if( i == n )
+                        return 1;
+                    value = named[i].code;
+                }
+
+                code = value;
+                return semi - p + 1;
+            }
+
+            static void append_utf8( unsigned long code, std::string& out ){
+                if( code < 0x80 ){
+                    out += static_cast<char>(code);
+                } else if( code < 0x800 ){
+                    out += static_cast<char>(0xc0 | (code >> 6));
+                    out += static_cast<char>(0x80 | (code & 0x3f));
+                } else if( code < 0x10000 ){
+                    out += static_cast<char>(0xe0 | (code >> 12));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                    out += static_cast<char>(0x80 | (code & 0x3f));
+                } else {
+                    out += static_cast<char>(0xf0 | (code >> 18));
+                    out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                    out += static_cast<char>(0x80 | (code & 0x3f));
+                }
             }
     };
 
+    // the typographic clean up alone, which everything we index goes through
+    class smart_quotes_filter : public text_normalizer {};
+
     class html_filter : public text_filter {
         public:
 
@@ -9,10 +9,22 @@ classes to help with indexing texts (or other things) into a Semantic Graph
 
 #include <semantic/semantic.hpp>
 #include <semantic/parsing.hpp>
+#include <semantic/term_dictionary.hpp>
 #include <semantic/filter.hpp>
 #include <semantic/file_reader.hpp>
+#include <semantic/weighting/precomputed.hpp>
+#include <semantic/posting_runs.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <semantic/concurrency.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#endif
+#include <boost/shared_ptr.hpp>
 
 #include <map>
+#include <vector>
 #include <sstream>
 #include <string>
 #include <cctype>
@@ -35,15 +47,8 @@ namespace semantic {
             std::pair<Edge, Edge> add_doc_term_edge(const string& doc_string,
                                                     const string& term_string,
                                                     unsigned int strength) {
-                Vertex doc, term;
-                doc = add_doc_vertex(doc_string);
-                term = add_term_vertex(term_string);
-
-                typename graph_traits::edge_properties_type eprop;
-                eprop.strength = strength;
-
-                return std::make_pair(add_edge(doc, term, eprop, g).first,
-                                      add_edge(term, doc, eprop, g).first);
+                return add_doc_term_edge(add_doc_vertex(doc_string),
+                                         term_dict.intern(term_string), strength);
             }
 
             Edge add_single_doc_term_edge(const string& doc_string,
@@ -51,7 +56,7 @@ namespace semantic {
                                           unsigned int strength) {
                 Vertex doc, term;
                 doc = add_doc_vertex(doc_string);
-                term = add_term_vertex(term_string);
+                term = add_term_vertex(term_dict.intern(term_string));
 
                 typename graph_traits::edge_properties_type eprop;
                 eprop.strength = strength;
@@ -62,41 +67,73 @@ namespace semantic {
             Graph &graph() { return g; }
             const Graph &graph() const { return g; }
 
+            // the terms we've seen, by id
+            term_dictionary &dictionary() { return term_dict; }
+
 
         protected:
             Graph &g;
 
-        private:
-            Vertex add_term_vertex(string term) {
-                if (term.find_first_of(' ') != std::string::npos) return add_phrase_vertex(term);
-                return do_vertex(term, node_type_major_term, node_type_minor_term, term_cache);
+            // a term the dictionary already has
+            std::pair<Edge, Edge> add_doc_term_edge(Vertex doc,
+                                                    term_id id,
+                                                    unsigned int strength) {
+                Vertex term = add_term_vertex(id);
+
+                typename graph_traits::edge_properties_type eprop;
+                eprop.strength = strength;
+
+                return std::make_pair(add_edge(doc, term, eprop, g).first,
+                                      add_edge(term, doc, eprop, g).first);
+            }
+
+            Vertex add_doc_vertex(const string& doc) {
+                typename std::map<string, Vertex>::iterator i = doc_cache.find(doc);
+                if (i != doc_cache.end()) return i->second;
+
+                Vertex v = new_vertex(doc, node_type_major_doc, node_type_minor_undef);
+                doc_cache.insert(std::make_pair(doc, v));
+                return v;
             }
 
-            Vertex add_phrase_vertex(string phrase){
-                return do_vertex(phrase, node_type_major_term, node_type_minor_phrase, term_cache);
+            // after the graph's been cleared: the vertices we know are gone
+            void forget_vertices() {
+                doc_cache.clear();
+                term_vertices.clear();
             }
 
-            Vertex add_doc_vertex(string doc) {
-                return do_vertex(doc, node_type_major_doc, node_type_minor_undef, doc_cache);
+        private:
+            Vertex add_term_vertex(term_id term) {
+                if (term < term_vertices.size() && term_vertices[term] != null_vertex())
+                    return term_vertices[term];
+
+                string content = term_dict.str(term);
+                int type_minor = content.find_first_of(' ') != std::string::npos ?
+                                     node_type_minor_phrase : node_type_minor_term;
+                Vertex v = new_vertex(content, node_type_major_term, type_minor);
+
+                if (term >= term_vertices.size()) term_vertices.resize(term + 1, null_vertex());
+                term_vertices[term] = v;
+                return v;
             }
 
-            Vertex do_vertex(string content,
-                             int type_major,
-                             int type_minor,
-                             std::map<string, Vertex> &cache) {
-                if (cache.count(content)) return cache[content];
+            Vertex new_vertex(const string& content,
+                              int type_major,
+                              int type_minor) {
                 typename graph_traits::vertex_properties_type vprop;
                 vprop.content = content;
                 vprop.type_major = type_major;
                 vprop.type_minor = type_minor;
+                return add_vertex(vprop, g);
+            }
 
-                Vertex v = add_vertex(vprop, g);
-                cache.insert(std::make_pair<string, Vertex>(content, v));
-                return v;
+            static Vertex null_vertex() {
+                return graph_traits::graph_traits::null_vertex();
             }
 
             std::map<string, Vertex> doc_cache;
-            std::map<string, Vertex> term_cache;
+            term_dictionary term_dict;
+            std::vector<Vertex> term_vertices;     // by term id
 
     };
 
@@ -121,6 +158,11 @@ namespace semantic {
             {
                 init();
             }
+            text_indexer(Graph & graph, compiled_lexicon::pointer lexicon)
+                     : base_type(graph), parser(lexicon)
+            {
+                init();
+            }
 
 /* **************************************************** *
  *        METHODS
@@ -136,6 +178,84 @@ namespace semantic {
                 parser.set_parsing_method(method);
             }
 
+/* **************************************************** *
+ *        set_language ( language )
+ *
+ *        the language the collection is written in, by
+ *        ISO 639-1 code or English name (see language.hpp);
+ *        it's kept with the collection ("language"), so
+ *        later indexing and searches use it too.  throws
+ *        UnsupportedLanguageException for a language we
+ *        have no analyzer for.  a collection that was
+ *        never given one is English.
+ * **************************************************** */
+            void set_language( const std::string& language ){
+                parser.set_language( language );
+                collectionLanguage = parser.get_language();
+                set_collection_value( "language", collectionLanguage );
+            }
+
+            std::string get_language(){
+                load_language();
+                return collectionLanguage;
+            }
+
+/* **************************************************** *
+ *        set_weighting < WeightingPolicy > ()
+ *
+ *        the weighting the storage precomputes edge
+ *        weights with (see weighting/precomputed.hpp);
+ *        it's kept with the collection ("weighting").
+ *        lg(tf,idf) when it's never set.
+ * **************************************************** */
+            template <class WeightingPolicy>
+            void set_weighting(){
+                weighting_registry::shared().add<WeightingPolicy>();
+                set_collection_value( "weighting", WeightingPolicy::name() );
+            }
+
+/* **************************************************** *
+ *        detect_languages ( bool )
+ *
+ *        guess each document's language from its text
+ *        (see detect_language()), falling back on the
+ *        collection's when it can't tell
+ * **************************************************** */
+            void detect_languages( bool val ){
+                detectLanguages = val;
+            }
+
+/* **************************************************** *
+ *        set_memory_budget ( bytes )
+ *
+ *        index out of core: rather than building the
+ *        graph in memory, keep about this many bytes of
+ *        postings (document, term, strength), writing
+ *        them out to a sorted temporary file each time
+ *        they fill up, and send each document's name and
+ *        text straight to another one.  finish() merges
+ *        it all back and stores it a block of documents
+ *        at a time, so the graph never holds more than a
+ *        block either.  the term dictionary and word list
+ *        still live in memory, but they grow with the
+ *        vocabulary, not with the collection.
+ *
+ *        0 (the default) builds the whole graph in
+ *        memory.  set it before indexing anything, and
+ *        only with a storage backend to finish() into.
+ * **************************************************** */
+            void set_memory_budget( std::size_t bytes ){
+                memoryBudget = bytes;
+                spilledCount = 0;
+                if( bytes > 0 ){
+                    spilledPostings.reset( new posting_runs( bytes ) );
+                    spilledDocuments.reset( new temporary_file );
+                } else {
+                    spilledPostings.reset();
+                    spilledDocuments.reset();
+                }
+            }
+
 /* **************************************************** *
  *        index ( filename, filestream, [mime_type], [weight=1] )
  * **************************************************** */
@@ -148,9 +268,8 @@ namespace semantic {
                 if( default_encoding.size() > 0 )
                     reader.set_default_encoding( default_encoding );
 
+                // (the reader has already cleaned it up)
                 std::string text = reader( filestream, mime_type );
-                smart_quotes_filter filter;
-                text = filter(text);
 
                 if( text.size() > 10 ){
                     add_to_index( filename, text, multiplier );
@@ -215,6 +334,83 @@ namespace semantic {
 
 
 
+/* **************************************************** *
+ *        index_files ( begin, end, [threads=1], [verbose=false] )
+ *
+ *        indexes every filename in begin -> end and returns the
+ *        number of documents that made it into the graph.
+ *
+ *        with more than one thread this runs as a pipeline: one
+ *        thread reads and converts the files, `threads` workers
+ *        tag, filter and stem them (each with its own copy of the
+ *        parser), and the calling thread is the only one touching
+ *        the graph.  the stages talk through bounded queues, so a
+ *        slow stage holds the others back instead of piling up
+ *        documents in memory.  documents end up in the graph in
+ *        the order they finish parsing, not in filename order.
+ * **************************************************** */
+            template <class Iterator>
+            unsigned int index_files( Iterator begin, Iterator end,
+                                      unsigned int threads=1,
+                                      bool verbose=false )
+            {
+#if SEMANTIC_HAVE_BOOST_THREAD
+                if( threads > 1 ){
+                    return index_files_in_parallel( begin, end, threads, verbose );
+                }
+#endif
+                unsigned int before = files_indexed;
+                for( ; begin != end; ++begin ){
+                    if( verbose )
+                        std::cout << "Indexing " << *begin << std::endl;
+                    try {
+                        index( *begin );
+                    } catch ( std::exception &e ){
+                        std::cerr << "Error indexing file: " << *begin << " (" << e.what() << ")" << std::endl;
+                    }
+                }
+                return files_indexed - before;
+            }
+
+
+/* **************************************************** *
+ *        index_stream ( name, documents, [threads=1], [verbose=false] )
+ *
+ *        indexes each document a document_stream hands out as
+ *        "name#1", "name#2" and so on, and returns the number
+ *        that made it into the graph.  only the document being
+ *        read is held in memory (plus the few waiting in the
+ *        pipeline's queues with more than one thread), apart
+ *        from the text kept for the "body" meta data -- turn
+ *        that off with store_text(false) for really big inputs.
+ * **************************************************** */
+            unsigned int index_stream( const std::string& name,
+                                       document_stream& documents,
+                                       unsigned int threads=1,
+                                       bool verbose=false )
+            {
+#if SEMANTIC_HAVE_BOOST_THREAD
+                if( threads > 1 ){
+                    return run_pipeline( boost::bind( &text_indexer::read_stream_documents,
+                                                      this, name, &documents, _1, verbose ), threads );
+                }
+#endif
+                unsigned int before = files_indexed;
+                smart_quotes_filter filter;
+                std::string text, cleaned;
+                while( documents.next(text) ){
+                    std::string doc_id = stream_document_id( name, documents.count() );
+                    if( verbose )
+                        std::cout << "Indexing " << doc_id << std::endl;
+                    filter.normalize( text, cleaned );
+                    if( cleaned.size() > 10 ){
+                        add_to_index( doc_id, cleaned, 1 );
+                    }
+                }
+                return files_indexed - before;
+            }
+
+
 /* **************************************************** *
  *        unindex ( doc_id )
  * **************************************************** */
@@ -285,31 +481,37 @@ namespace semantic {
                      std::pair<std::string,int> > prune_wordlist(const int min_occurrence=2){
 
                 std::map<std::string, std::pair<std::string,int> > new_wordlist;
-                typedef std::multimap< int, std::string, std::greater<int> > RevMap;
+                term_dictionary& dictionary = base_type::dictionary();
+
+                std::vector<variant_counts::variant> variants;
+                wordlist.variants( back_inserter(variants) );
+
+                // the total for each term, and its most common word (the
+                // first alphabetically, if it's a tie)
+                std::vector<int> totals( dictionary.size(), 0 );
+                std::vector<variant_counts::variant> best( dictionary.size() );
+                std::vector<variant_counts::variant>::iterator v;
+                for( v = variants.begin(); v != variants.end(); ++v ){
+                    variant_counts::variant& b = best[v->term];
+                    if( totals[v->term] == 0 || v->count > b.count ||
+                        (v->count == b.count && dictionary.str(v->word) < dictionary.str(b.word)) ){
+                        b = *v;
+                    }
+                    totals[v->term] += v->count;
+                }
 
-                std::map<std::string,UnstemmedCount>::iterator pos;
-                for( pos = wordlist.begin(); pos != wordlist.end(); ++pos ){
-                    std::string stemmed = pos->first;
-                    UnstemmedCount unstemmed = pos->second;
+                for( term_id term = 0; term < totals.size(); term++ ){
+                    if( totals[term] == 0 || totals[term] < min_occurrence ) continue;
 
-                    RevMap lookup;
-                    int total = wordlist[stemmed]["__count"];
-                    UnstemmedCount::iterator cpos;
-                    for( cpos = unstemmed.begin(); cpos != unstemmed.end(); ++cpos ){
-                        if( cpos->first != "__count" && total >= min_occurrence ){
-                            lookup.insert( make_pair( cpos->second, cpos->first ) );
-                        }
-                    }
-                    if( lookup.size() >= 1 ){
-                        std::string word = lookup.begin()->second;
-                        std::string lower(word);
-                        std::transform(word.begin(),word.end(),lower.begin(),tolower);
-
-                        // skip words that don't have differing stems
-                        if( lower != stemmed ){
-                            new_wordlist.insert(
-                                std::make_pair(stemmed, std::make_pair(word, total) ) );
-                        }
+                    std::string stemmed = dictionary.str(term);
+                    std::string word = dictionary.str(best[term].word);
+                    std::string lower(word);
+                    std::transform(word.begin(),word.end(),lower.begin(),tolower);
+
+                    // skip words that don't have differing stems
+                    if( lower != stemmed ){
+                        new_wordlist.insert(
+                            std::make_pair(stemmed, std::make_pair(word, totals[term]) ) );
                     }
                 }
                 return new_wordlist;
@@ -349,6 +551,9 @@ namespace semantic {
  *         finish( min=2 )
  * **************************************************** */
             bool finish(int min=2){
+                if( spilledPostings ){
+                    return finish_spilled(min);
+                }
 
                 try {
                     base_type::g.commit_changes_to_storage();
@@ -411,39 +616,87 @@ namespace semantic {
 
 
         private:
-            std::map<std::string,UnstemmedCount> wordlist;
+            variant_counts wordlist;
             text_parser parser;
             std::string default_encoding;
+            std::string collectionLanguage;
             int files_indexed;
             bool storeText;
+            bool detectLanguages;
+
+            // out of core indexing (see set_memory_budget)
+            std::size_t memoryBudget;
+            boost::shared_ptr<posting_runs> spilledPostings;
+            boost::shared_ptr<temporary_file> spilledDocuments;   // name and text, by document number
+            boost::uint32_t spilledCount;
+
+            // about what a posting takes up once it's in the graph: an edge
+            // each way, and its share of the vertices
+            static const std::size_t graph_bytes_per_posting = 256;
 
             void init(){
                 pdfLayout = "layout";
                 files_indexed = 0;
                 storeText = true;
+                detectLanguages = false;
                 text_store.clear();
+                memoryBudget = 0;
+                spilledCount = 0;
+            }
+
+            // the collection's language, from its meta data the
+            // first time we need it
+            void load_language(){
+                if( collectionLanguage.size() > 0 ) return;
+                parser.set_language( get_collection_value( "language", "en" ) );
+                collectionLanguage = parser.get_language();
+            }
+
+            // the language to parse text in
+            std::string language_of( const std::string& text ){
+                if( !detectLanguages ) return collectionLanguage;
+                return detect_language( text, collectionLanguage );
             }
 
             void add_to_index( const std::string& doc_id,
                                const std::string& text,
                                const int multiplier )
+            {
+                // start every document from a clean tagger, so the terms we get
+                // don't depend on which document happened to come before
+                parser.reset();
+                load_language();
+                parser.set_language( language_of( text ) );
+                text_parser::term_vector terms;
+				parser.parse( text, base_type::dictionary(), terms, wordlist );
+                add_terms_to_index( doc_id, text, terms, multiplier );
+            }
+
+            // the part of add_to_index that touches the graph, once the
+            // text has been parsed into terms
+            void add_terms_to_index( const std::string& doc_id,
+                                     const std::string& text,
+                                     const text_parser::term_vector& terms,
+                                     const int multiplier )
             {
                 files_indexed++;
+                if( spilledPostings ){
+                    spill_terms( doc_id, text, terms, multiplier );
+                    return;
+                }
                 //std::cout << "adding: " << doc_id << " => " << text << std::endl;
                 if( storeText ){
                     text_store[doc_id] = text;
                 }
-				std::map<std::string,int> terms = parser.parse( text, wordlist );
-                std::map<std::string,int>::iterator tpos;
+                text_parser::term_vector::const_iterator tpos;
 				
 				std::string value = base_type::g.get_meta_value("doc_min","1");
                 int min = atoi(value.c_str());
+                typename se_graph_traits<Graph>::vertex_descriptor doc = base_type::add_doc_vertex( doc_id );
 				for( tpos = terms.begin(); tpos != terms.end(); ++tpos ){
-                    std::string term = tpos->first;
                     if( tpos->second >= min ){
                         unsigned int weight = tpos->second * multiplier;
-                        // std::cout << "adding: " << doc_id << " - " << term << std::endl;
-                        base_type::add_doc_term_edge( doc_id, term, weight );
+                        base_type::add_doc_term_edge( doc, tpos->first, weight );
                     }
                 }
 
@@ -452,6 +705,254 @@ namespace semantic {
 //                }
             }
 
+            // add_terms_to_index, out of core: the document gets the next
+            // number, and it and its postings go to the temporary files
+            void spill_terms( const std::string& doc_id,
+                              const std::string& text,
+                              const text_parser::term_vector& terms,
+                              const int multiplier )
+            {
+                boost::uint32_t doc = spilledCount++;
+                spilledDocuments->write_string( doc_id );
+                spilledDocuments->write_string( storeText ? text : std::string() );
+
+                std::string value = base_type::g.get_meta_value("doc_min","1");
+                int min = atoi(value.c_str());
+                text_parser::term_vector::const_iterator tpos;
+                for( tpos = terms.begin(); tpos != terms.end(); ++tpos ){
+                    if( tpos->second >= min ){
+                        spilledPostings->add( doc, tpos->first, tpos->second * multiplier );
+                    }
+                }
+            }
+
+            // finish(), out of core.  the merged postings come in document
+            // order, as do the documents in their file, so both are read
+            // through once: the graph gets a block of documents and their
+            // terms, which is stored, and then let go of before the next.
+            // the storage's indexes are only brought up to date with the
+            // last block, all at once
+            bool finish_spilled( int min ){
+                typedef typename se_graph_traits<Graph>::vertex_descriptor Vertex;
+                Graph& g = base_type::g;
+
+                std::map<std::string,
+                         std::pair<std::string,int>
+                    > my_wordlist = prune_wordlist(min);
+
+                // the blocks and the merge's read buffers share the budget
+                std::size_t block_bytes = memoryBudget - memoryBudget / 4;
+                bool defer = g.get_defer_indexing_cleanup();
+                try {
+                    spilledPostings->start_merge( memoryBudget / 4 );
+                    spilledDocuments->rewind();
+
+                    posting p;
+                    bool more = spilledPostings->next(p);
+                    std::string name, text;
+                    std::vector<std::pair<Vertex, std::string> > bodies;
+                    std::size_t bytes = 0;
+                    for( boost::uint32_t doc = 0; doc < spilledCount; doc++ ){
+                        if( !spilledDocuments->read_string(name) || !spilledDocuments->read_string(text) )
+                            throw TemporaryFileException();
+
+                        Vertex u = base_type::add_doc_vertex( name );
+                        for( ; more && p.doc == doc; more = spilledPostings->next(p) ){
+                            base_type::add_doc_term_edge( u, p.term, p.strength );
+                            bytes += graph_bytes_per_posting;
+                        }
+                        if( storeText ){
+                            bytes += text.size();
+                            bodies.push_back( std::make_pair( u, std::string() ) );
+                            bodies.back().second.swap( text );
+                        }
+
+                        if( doc + 1 == spilledCount ){
+                            g.set_defer_indexing_cleanup( defer );
+                            store_block( bodies, my_wordlist );
+                        } else if( bytes >= block_bytes ){
+                            g.set_defer_indexing_cleanup( true );
+                            store_block( bodies, my_wordlist );
+                            bytes = 0;
+                        }
+                    }
+                } catch ( std::exception &e){
+                    g.set_defer_indexing_cleanup( defer );
+                    std::cerr << "Error Indexing to Database: " << e.what() << std::endl;
+                    return false;
+                } catch ( char * e ){
+                    g.set_defer_indexing_cleanup( defer );
+                    std::cerr << "Error: " << e << std::endl;
+                    return false;
+                }
+
+                // ready for more
+                set_memory_budget( memoryBudget );
+                return true;
+            }
+
+            // commits the graph, with the text and word list meta values
+            // that go with it, and then empties it (but not the storage)
+            template <class Bodies, class Wordlist>
+            void store_block( Bodies& bodies, Wordlist& my_wordlist ){
+                Graph& g = base_type::g;
+                g.commit_changes_to_storage();
+
+                for( typename Bodies::iterator i = bodies.begin(); i != bodies.end(); ++i ){
+                    g.set_vertex_meta_value( i->first, "body", i->second );
+                }
+                bodies.clear();
+
+                // (a term in more than one block just gets the same value again)
+                BGL_FORALL_VERTICES_T(u, g, Graph) {
+                    if (g[u].type_major == node_type_major_term && my_wordlist.count(g[u].content)){
+                        std::pair<std::string, int> wordpair = my_wordlist[g[u].content];
+                        std::ostringstream oss;
+                        oss << wordpair.second;
+                        g.set_vertex_meta_value(u, "term", wordpair.first+":"+oss.str());
+                    }
+                }
+
+                bool mirror = g.get_mirror_changes_to_storage();
+                g.set_mirror_changes_to_storage(false);
+                g.clear();
+                g.set_mirror_changes_to_storage(mirror);
+                base_type::forget_vertices();
+            }
+
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+/* **************************************************** *
+ *        the parallel indexing pipeline (see index_files)
+ * **************************************************** */
+            struct pipeline_document {
+                std::string doc_id;
+                std::string text;
+                text_parser::term_vector terms;
+                variant_counts unstemmed;
+            };
+            typedef boost::shared_ptr<pipeline_document> DocumentPtr;
+            typedef bounded_queue<DocumentPtr> DocumentQueue;
+
+            template <class Iterator>
+            unsigned int index_files_in_parallel( Iterator begin, Iterator end,
+                                                  unsigned int threads,
+                                                  bool verbose )
+            {
+                return run_pipeline( boost::bind( &text_indexer::template read_documents<Iterator>,
+                                                  this, begin, end, _1, verbose ), threads );
+            }
+
+            // `reader` fills the first queue and calls done() on it
+            unsigned int run_pipeline( boost::function<void (DocumentQueue*)> reader,
+                                       unsigned int threads )
+            {
+                unsigned int before = files_indexed;
+                load_language();
+
+                // a couple of documents per worker in each queue keeps
+                // everybody busy without holding much in memory
+                DocumentQueue to_parse( 2*threads, 1 );
+                DocumentQueue to_write( 2*threads, threads );
+
+                // every worker gets its own parser - the tagger keeps
+                // per-text state - but they all share our (read-only)
+                // lexicon and keep our settings and filters
+                std::vector<boost::shared_ptr<text_parser> > parsers;
+                for( unsigned int i = 0; i < threads; i++ ){
+                    parsers.push_back( boost::shared_ptr<text_parser>( new text_parser(parser) ) );
+                }
+
+                boost::thread_group group;
+                group.create_thread( boost::bind( reader, &to_parse ) );
+                for( unsigned int i = 0; i < threads; i++ ){
+                    group.create_thread( boost::bind( &text_indexer::parse_documents,
+                                                      this, parsers[i].get(), &to_parse, &to_write ) );
+                }
+
+                // and we're the writer
+                try {
+                    DocumentPtr doc;
+                    while( to_write.pop(doc) ){
+                        wordlist.merge( doc->unstemmed );
+                        add_terms_to_index( doc->doc_id, doc->text, doc->terms, 1 );
+                    }
+                } catch ( ... ){
+                    to_parse.cancel();
+                    to_write.cancel();
+                    group.join_all();
+                    throw;
+                }
+
+                group.join_all();
+                return files_indexed - before;
+            }
+
+            // reader stage: file -> utf8 text
+            template <class Iterator>
+            void read_documents( Iterator begin, Iterator end, DocumentQueue *out, bool verbose )
+            {
+                file_reader reader;
+                if( default_encoding.size() > 0 )
+                    reader.set_default_encoding( default_encoding );
+
+                if( pdfLayout.size() && pdfLayout != "layout")
+                    reader.set_pdfLayout( pdfLayout );
+
+                for( ; begin != end; ++begin ){
+                    if( verbose )
+                        std::cout << "Indexing " << *begin << std::endl;
+
+                    DocumentPtr doc( new pipeline_document );
+                    doc->doc_id = *begin;
+                    try {
+                        doc->text = reader( doc->doc_id );
+                    } catch ( std::exception &e ){
+                        std::cerr << "Error indexing file: " << *begin << " (" << e.what() << ")" << std::endl;
+                        continue;
+                    }
+                    if( doc->text.size() <= 10 ) continue;
+                    if( !out->push(doc) ) break; // cancelled
+                }
+                out->done();
+            }
+
+            // reader stage for index_stream: the next document -> utf8 text
+            void read_stream_documents( const std::string& name, document_stream *documents,
+                                        DocumentQueue *out, bool verbose )
+            {
+                smart_quotes_filter filter;
+                std::string text;
+                while( documents->next(text) ){
+                    DocumentPtr doc( new pipeline_document );
+                    doc->doc_id = stream_document_id( name, documents->count() );
+                    if( verbose )
+                        std::cout << "Indexing " << doc->doc_id << std::endl;
+                    filter.normalize( text, doc->text );
+                    if( doc->text.size() <= 10 ) continue;
+                    if( !out->push(doc) ) break; // cancelled
+                }
+                out->done();
+            }
+
+            // worker stage: text -> stemmed terms and unstemmed counts
+            void parse_documents( text_parser *p, DocumentQueue *in, DocumentQueue *out )
+            {
+                DocumentPtr doc;
+                while( in->pop(doc) ){
+                    try {
+                        p->reset();
+                        p->set_language( language_of( doc->text ) );
+                        p->parse( doc->text, base_type::dictionary(), doc->terms, doc->unstemmed );
+                    } catch ( std::exception &e ){
+                        std::cerr << "Error indexing file: " << doc->doc_id << " (" << e.what() << ")" << std::endl;
+                        continue;
+                    }
+                    if( !out->push(doc) ) break; // cancelled
+                }
+                out->done();
+            }
+#endif
 
 /*
             void manage_wordlist(const unsigned int max=3)
@@ -487,6 +988,13 @@ namespace semantic {
             }
 
 */
+            static std::string stream_document_id( const std::string& name, unsigned int n )
+            {
+                std::ostringstream oss;
+                oss << name << "#" << n;
+                return oss.str();
+            }
+
 			std::string get_mime_type_from_filename( const std::string& filename )
             {
                 std::string::size_type pos = filename.find_last_of(".");
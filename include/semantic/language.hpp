@@ -0,0 +1,407 @@
+/*
+what the parser and the query need to know about the language a collection
+is written in: how to split a text into words, which of them are too common
+to be worth indexing, and how to stem the rest.
+
+there's an analyzer for each language we have a stemmer for (see
+semantic/stem/).  English is the only one we have a part of speech lexicon
+for, so it's the only one whose terms come from the tagger; the others take
+every word that isn't a stopword.  the stemmers other than the English one
+work in Latin-1, so words are converted for them and back (and left alone if
+they can't be).
+
+an analyzer doesn't change once it's built, so for_language() builds each
+one the first time it's asked for and hands out the same one after that, to
+any number of parsers and threads.
+
+detect_language() guesses the language of a text from the stopwords in it,
+for collections that mix languages.
+*/
+
+#ifndef __SEMANTIC_LANGUAGE_HPP__
+#define __SEMANTIC_LANGUAGE_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/cached_stemmer.hpp>
+#include <semantic/stem/english_stem.h>
+#include <semantic/stem/danish_stem.h>
+#include <semantic/stem/dutch_stem.h>
+#include <semantic/stem/finnish_stem.h>
+#include <semantic/stem/french_stem.h>
+#include <semantic/stem/german_stem.h>
+#include <semantic/stem/italian_stem.h>
+#include <semantic/stem/norwegian_stem.h>
+#include <semantic/stem/portuguese_stem.h>
+#include <semantic/stem/spanish_stem.h>
+#include <semantic/stem/swedish_stem.h>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include <exception>
+#include <cctype>
+#include <cstddef>
+
+namespace semantic {
+
+	struct UnsupportedLanguageException : public std::exception {
+		UnsupportedLanguageException(const std::string &m) : msg(m) {}
+		~UnsupportedLanguageException() throw() {}
+		const char * what() const throw() { return msg.c_str(); }
+		std::string msg;
+	};
+
+	class text_analyzer : boost::noncopyable {
+		public:
+			typedef boost::shared_ptr<const text_analyzer> pointer;
+
+			// the analyzer for a language, by its ISO 639-1 code ("fr") or its
+			// English name ("french")
+			static pointer for_language(const std::string &language) {
+				const language_info *info = find(language);
+				if (!info) throw UnsupportedLanguageException("there is no analyzer for the language '" + language + "'");
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(registry_mutex());
+#endif
+				pointer &analyzer = registry()[info->code];
+				if (!analyzer) analyzer.reset(new text_analyzer(*info));
+				return analyzer;
+			}
+
+			static bool supported(const std::string &language) {
+				return find(language) != 0;
+			}
+
+			// out gets the code of each language there's an analyzer for
+			template <class OutIterator>
+			static void languages(OutIterator out) {
+				for(const language_info *l = table(); l->code; ++l, ++out) *out = std::string(l->code);
+			}
+
+			// the language's ISO 639-1 code
+			const std::string &language() const {
+				return m_code;
+			}
+
+			// whether the parser should take terms from the tagger (true) or
+			// from tokenize()
+			bool tagged() const {
+				return m_tagged;
+			}
+
+			// stems a lower case word in place, just like the stemmers do
+			void stem(std::string &word) const {
+				m_stem(word);
+			}
+
+			// text in lower case: just ASCII for English, which is what the
+			// tagger has always done, and Latin-1 as well for the others
+			std::string lowercase(const std::string &text) const {
+				std::string lower(text);
+				for(std::string::size_type i = 0; i < lower.size(); ++i) {
+					unsigned char c = lower[i];
+					if (c >= 'A' && c <= 'Z') lower[i] = c + ('a' - 'A');
+					else if (!m_tagged && c == 0xc3 && i + 1 < lower.size()) {
+						unsigned char d = lower[i + 1];
+						if (d >= 0x80 && d <= 0x9e && d != 0x97) lower[++i] = d + 0x20;
+					}
+				}
+				return lower;
+			}
+
+			bool is_stopword(const std::string &word) const {
+				return m_stopwords.count(word) > 0;
+			}
+
+			// counts the words in text, lower cased, leaving out stopwords,
+			// numbers and single letters
+			void tokenize(const std::string &text, std::map<std::string,int> &words) const {
+				std::string word;
+				std::size_t length;
+				bool letters;
+				for(std::string::size_type pos = 0; next_word(text, pos, word, length, letters, !m_tagged);) {
+					if (length > 1 && letters && !is_stopword(word)) words[word]++;
+				}
+			}
+
+			// the code of the language text seems to be written in, going by
+			// the stopwords in its first few thousand words; fallback when
+			// there aren't enough of them to tell
+			static std::string detect(const std::string &text, const std::string &fallback) {
+				const std::map<std::string, unsigned int> &stopwords = all_stopwords();
+				std::vector<unsigned int> hits(table_size(), 0);
+
+				std::string word;
+				std::size_t length;
+				bool letters;
+				for(std::string::size_type pos = 0; pos < detection_bytes && next_word(text, pos, word, length, letters, true);) {
+					std::map<std::string, unsigned int>::const_iterator s = stopwords.find(word);
+					if (s == stopwords.end()) continue;
+					for(std::size_t l = 0; l < hits.size(); ++l) {
+						if (s->second & (1u << l)) hits[l]++;
+					}
+				}
+
+				// a clear winner, or we don't know
+				std::size_t best = 0;
+				unsigned int runner_up = 0;
+				for(std::size_t l = 1; l < hits.size(); ++l) {
+					if (hits[l] > hits[best]) {
+						runner_up = hits[best];
+						best = l;
+					} else if (hits[l] > runner_up) {
+						runner_up = hits[l];
+					}
+				}
+				if (hits[best] < 3 || hits[best] == runner_up) return fallback;
+				return table()[best].code;
+			}
+
+		private:
+			struct language_info {
+				const char *code, *name;
+				void (*stem)(std::string &);
+				const char *stopwords;		// separated by spaces, in UTF-8
+			};
+
+			enum { detection_bytes = 16 * 1024 };
+
+			std::string m_code;
+			bool m_tagged;
+			void (*m_stem)(std::string &);
+			std::set<std::string> m_stopwords;
+
+			explicit text_analyzer(const language_info &info)
+				: m_code(info.code), m_tagged(m_code == "en"), m_stem(info.stem) {
+				split(info.stopwords, m_stopwords);
+			}
+
+			template <class Stemmer>
+			static void stem_utf8(std::string &word) {
+				cached_stemmer<Stemmer>::for_this_thread()(word);
+			}
+
+			template <class Stemmer>
+			static void stem_latin1(std::string &word) {
+				std::string latin1;
+				latin1.reserve(word.size());
+				for(std::string::size_type i = 0; i < word.size();) {
+					unsigned int c = decode(word, i);
+					if (c > 0xff) return;	// nothing the stemmer could read
+					latin1 += static_cast<char>(c);
+				}
+
+				cached_stemmer<Stemmer>::for_this_thread()(latin1);
+
+				word.clear();
+				for(std::string::size_type i = 0; i < latin1.size(); ++i) {
+					unsigned char c = latin1[i];
+					if (c < 0x80) {
+						word += static_cast<char>(c);
+					} else {
+						word += static_cast<char>(0xc0 | (c >> 6));
+						word += static_cast<char>(0x80 | (c & 0x3f));
+					}
+				}
+			}
+
+			// the code point at i, moving i past it; invalid UTF-8 comes back
+			// as something above U+10FFFF, a byte at a time
+			static unsigned int decode(const std::string &s, std::string::size_type &i) {
+				unsigned char c = s[i++];
+				if (c < 0x80) return c;
+
+				std::size_t more;
+				unsigned int cp;
+				if ((c & 0xe0) == 0xc0) { more = 1; cp = c & 0x1f; }
+				else if ((c & 0xf0) == 0xe0) { more = 2; cp = c & 0x0f; }
+				else if ((c & 0xf8) == 0xf0) { more = 3; cp = c & 0x07; }
+				else return 0xffffffffu;
+
+				if (i + more > s.size()) return 0xffffffffu;
+				for(std::size_t k = 0; k < more; ++k) {
+					unsigned char d = s[i + k];
+					if ((d & 0xc0) != 0x80) return 0xffffffffu;
+					cp = (cp << 6) | (d & 0x3f);
+				}
+				i += more;
+				return cp;
+			}
+
+			// letters and digits; everything else (punctuation, symbols,
+			// spaces, the Latin-1 ones and the general punctuation block
+			// included) separates words
+			static bool is_word_char(unsigned int c) {
+				if (c < 0x80) return std::isalnum(c) != 0;
+				if (c < 0xc0 || c == 0xd7 || c == 0xf7) return false;
+				if (c >= 0x2000 && c < 0x2c00) return false;
+				if (c >= 0x3000 && c < 0x3040) return false;
+				if (c == 0xfeff || c > 0x10ffff) return false;
+				return true;
+			}
+
+			// the next word from pos, lower cased (Latin-1 too, if asked);
+			// false once there are no more
+			static bool next_word(const std::string &text, std::string::size_type &pos,
+								  std::string &word, std::size_t &length, bool &letters, bool fold_latin1) {
+				word.clear();
+				length = 0;
+				letters = false;
+				while (pos < text.size()) {
+					std::string::size_type start = pos;
+					unsigned int c = decode(text, pos);
+					if (!is_word_char(c)) {
+						if (length > 0) return true;
+						continue;
+					}
+
+					length++;
+					if (c < 0x80) {
+						if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+						if (c < '0' || c > '9') letters = true;
+						word += static_cast<char>(c);
+					} else {
+						letters = true;
+						if (fold_latin1 && c >= 0xc0 && c <= 0xde) {
+							word += static_cast<char>(0xc3);
+							word += static_cast<char>(0x80 | ((c + 0x20) & 0x3f));
+						} else {
+							word.append(text, start, pos - start);
+						}
+					}
+				}
+				return length > 0;
+			}
+
+			static void split(const char *words, std::set<std::string> &out) {
+				std::string list(words);
+				std::string::size_type b = list.find_first_not_of(' ');
+				while (b != std::string::npos) {
+					std::string::size_type e = list.find(' ', b);
+					out.insert(list.substr(b, e == std::string::npos ? std::string::npos : e - b));
+					b = list.find_first_not_of(' ', e);
+				}
+			}
+
+			static const language_info *find(const std::string &language) {
+				std::string l(language);
+				for(std::string::size_type i = 0; i < l.size(); ++i) l[i] = std::tolower(static_cast<unsigned char>(l[i]));
+				for(const language_info *info = table(); info->code; ++info) {
+					if (l == info->code || l == info->name) return info;
+				}
+				return 0;
+			}
+
+			static std::size_t table_size() {
+				std::size_t n = 0;
+				while (table()[n].code) n++;
+				return n;
+			}
+
+			// each stopword, with a bit set for each language it's a stopword in
+			static const std::map<std::string, unsigned int> &all_stopwords() {
+				static std::map<std::string, unsigned int> stopwords = build_all_stopwords();
+				return stopwords;
+			}
+
+			static std::map<std::string, unsigned int> build_all_stopwords() {
+				std::map<std::string, unsigned int> stopwords;
+				for(std::size_t l = 0; table()[l].code; ++l) {
+					std::set<std::string> words;
+					split(table()[l].stopwords, words);
+					for(std::set<std::string>::iterator w = words.begin(); w != words.end(); ++w) stopwords[*w] |= 1u << l;
+				}
+				return stopwords;
+			}
+
+			static std::map<std::string, pointer> &registry() {
+				static std::map<std::string, pointer> analyzers;
+				return analyzers;
+			}
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+			static boost::mutex &registry_mutex() {
+				static boost::mutex mutex;
+				return mutex;
+			}
+#endif
+
+			static const language_info *table() {
+				static const language_info languages[] = {
+					{ "en", "english", &text_analyzer::stem_utf8<stemming::english_stem>,
+						"a an and are as at be been but by can do for from had has have he her his if in "
+						"is it its no not of on or our she so than that the their them then there these "
+						"they this those to was we were what which who will with would you" },
+					{ "fr", "french", &text_analyzer::stem_latin1<stemming::french_stem>,
+						"a au aux avec c ce ces cette comme d dans de des du elle elles en est et "
+						"\xc3\xa9t\xc3\xa9 \xc3\xa9tait \xc3\xaatre il ils j je l la le les leur leurs "
+						"lui m mais n ne nous on ont ou o\xc3\xb9 par pas plus pour qu que qui s sa se "
+						"ses son sont sur t tout un une vous y \xc3\xa0" },
+					{ "de", "german", &text_analyzer::stem_latin1<stemming::german_stem>,
+						"als am an auch auf aus bei bis das dass da\xc3\x9f dem den der des die durch "
+						"ein eine einem einen einer er es f\xc3\xbcr haben hat ich im in ist man mit "
+						"mehr nach nicht noch nur oder sein sich sie sind so um und von vor war wie wird "
+						"wurde zu zum zur \xc3\xbc" "ber" },
+					{ "es", "spanish", &text_analyzer::stem_latin1<stemming::spanish_stem>,
+						"a al algunos como con contra cuando de del desde donde durante e el ella ellos "
+						"en entre es esta este esto est\xc3\xa1 fue hasta hay la las le les lo los me "
+						"muy m\xc3\xa1s ni no nos o otra otro para pero por porque que qu\xc3\xa9 se sin "
+						"sobre son su sus tambi\xc3\xa9n todo todos un una uno y ya \xc3\xa9l" },
+					{ "it", "italian", &text_analyzer::stem_latin1<stemming::italian_stem>,
+						"a al alla anche che ci come con cui da dal degli dei del della delle di e era "
+						"essere gli ha i il in io la le lo loro ma mi ne nel nella noi non o per "
+						"pi\xc3\xb9 quando questo se si sono sua sul suo tra un una \xc3\xa8" },
+					{ "pt", "portuguese", &text_analyzer::stem_latin1<stemming::portuguese_stem>,
+						"a ao aos as at\xc3\xa9 com como da das de depois do dos e ela ele eles em entre "
+						"era esse est\xc3\xa1 eu foi h\xc3\xa1 isso j\xc3\xa1 mais mas mesmo muito na "
+						"nas no nos n\xc3\xa3o o os ou para pela pelo por quando que se sem ser seu seus "
+						"sua s\xc3\xb3 tamb\xc3\xa9m tem um uma voc\xc3\xaa \xc3\xa0 \xc3\xa9" },
+					{ "nl", "dutch", &text_analyzer::stem_latin1<stemming::dutch_stem>,
+						"aan al als bij dan dat de deze die dit door een en er geen had heb hebben heeft "
+						"het hij hoe ik in is je maar met mijn naar niet nog nu of om omdat ook op over "
+						"te tot uit van voor was wat werd worden ze zich zij zijn zo zou" },
+					{ "sv", "swedish", &text_analyzer::stem_latin1<stemming::swedish_stem>,
+						"att av de dem den denna det detta du d\xc3\xa4r efter eller ett fr\xc3\xa5n "
+						"f\xc3\xb6r han hade har hon honom hans henne hennes i inte jag kan med men mig "
+						"min mot n\xc3\xa4r och om p\xc3\xa5 sig sin sina skulle som till under upp ut "
+						"utan var vara vi vid \xc3\xa4n \xc3\xa4r \xc3\xa5t \xc3\xb6ver" },
+					{ "no", "norwegian", &text_analyzer::stem_latin1<stemming::norwegian_stem>,
+						"at av bare ble blir da de deg dem den der dere det dette du eller en er et "
+						"etter for fra ha hadde han hans har hun hva hvor i ikke ikkje jeg kan med meg "
+						"men mot noe noen n\xc3\xa5r og ogs\xc3\xa5 om opp p\xc3\xa5 seg selv sin skal "
+						"som til ut var vi vil v\xc3\xa6re \xc3\xa5" },
+					{ "da", "danish", &text_analyzer::stem_latin1<stemming::danish_stem>,
+						"af alle at blev bliver da de dem den denne der deres det dette dig du efter "
+						"eller en end er et for fra ham han hans har havde hende hun hvad hvis hvor i "
+						"ikke jeg kan med meget men mig min mod nogle noget n\xc3\xa5r og ogs\xc3\xa5 om "
+						"op p\xc3\xa5 sig sin skal som til ud var vi vil v\xc3\xa6re" },
+					{ "fi", "finnish", &text_analyzer::stem_latin1<stemming::finnish_stem>,
+						"ei ennen ett\xc3\xa4 he heid\xc3\xa4n h\xc3\xa4n h\xc3\xa4nen ja jo joka jos "
+						"jossa jotka kanssa kaikki koska kuin kun me mik\xc3\xa4 min\xc3\xa4 mit\xc3\xa4 "
+						"mukaan mutta my\xc3\xb6s ne niin nyt oli olla ollut on ovat se sek\xc3\xa4 sen "
+						"siin\xc3\xa4 sill\xc3\xa4 siit\xc3\xa4 sin\xc3\xa4 sit\xc3\xa4 tai te "
+						"t\xc3\xa4m\xc3\xa4 t\xc3\xa4m\xc3\xa4n vain viel\xc3\xa4 voi" },
+					{ 0, 0, 0, 0 }
+				};
+				return languages;
+			}
+	};
+
+
+	// the code of the language text seems to be written in (see
+	// text_analyzer::detect())
+	inline std::string detect_language(const std::string &text, const std::string &fallback = "en") {
+		return text_analyzer::detect(text, fallback);
+	}
+
+} // namespace semantic
+
+#endif
@@ -0,0 +1,494 @@
+
+#ifndef __SEMANTIC_LEXICON_HPP__
+#define __SEMANTIC_LEXICON_HPP__
+
+#include <semantic/config.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#ifndef WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace semantic {
+
+    struct LexiconException : public std::exception {
+        LexiconException(const std::string &m) : msg(m) {}
+        ~LexiconException() throw() {}
+        const char * what() const throw() { return msg.c_str(); }
+
+        std::string msg;
+    };
+
+/* *******************************************************
+        COMPILED LEXICON
+
+        the read-only form of the tagger's lexicon.  the text
+        lexicon (share/lexicon.txt) is compiled into one flat
+        block of memory:
+
+            - the POS tags, interned to small integers in
+              alphabetical order
+            - the words, sorted, each pointing to a run of
+              (tag, count) pairs
+            - the tag-to-tag transition counts of the Hidden
+              Markov Model as a dense num_tags x num_tags matrix
+
+        nothing in it changes after loading, so one copy can be
+        shared by any number of taggers (and threads) through a
+        boost::shared_ptr.  the block can also be written out with
+        save() and mapped straight back into memory by load(),
+        which skips the parsing altogether.  the binary format is
+        in the native byte order; load() refuses files that were
+        written on a machine with a different one.
+
+        shared() keeps one lexicon per file name for the whole
+        process.  it's locked when the Boost thread library was
+        found, so taggers can be made from any thread.
+   ******************************************************* */
+    class compiled_lexicon : boost::noncopyable {
+        public:
+            typedef boost::uint32_t tag_id;
+            typedef boost::uint32_t word_id;
+            typedef boost::shared_ptr<const compiled_lexicon> pointer;
+
+            struct tag_count {
+                boost::uint32_t tag;
+                boost::uint32_t count;
+            };
+
+            static const tag_id no_tag = 0xffffffff;
+
+
+            // compile a lexicon in the text format
+            compiled_lexicon( std::istream& lex_stream ) : m_map(0), m_map_size(0) {
+                compile( lex_stream );
+            }
+
+            ~compiled_lexicon() {
+#ifndef WIN32
+                if( m_map ) munmap( m_map, m_map_size );
+#endif
+            }
+
+/* *********************************************************************
+ *        load( filename ) -- a compiled (binary) or text lexicon,
+ *                             whichever the file turns out to be
+ *********************************************************************** */
+            static pointer load( const std::string& filename ){
+                std::ifstream file( filename.c_str(), std::ios_base::in | std::ios_base::binary );
+                if( !file )
+                    throw LexiconException( "Couldn't open lexicon " + filename );
+
+                char magic[8];
+                file.read( magic, sizeof(magic) );
+                if( file.gcount() == sizeof(magic) && memcmp( magic, file_magic(), sizeof(magic) ) == 0 ){
+                    file.close();
+                    return pointer( new compiled_lexicon( filename ) );
+                }
+
+                file.clear();
+                file.seekg( 0 );
+                return pointer( new compiled_lexicon( file ) );
+            }
+
+/* *********************************************************************
+ *        shared( filename ) -- load(), but only once per file name
+ *********************************************************************** */
+            static pointer shared( const std::string& filename ){
+                static std::map<std::string, pointer> lexicons;
+#if SEMANTIC_HAVE_BOOST_THREAD
+                // (held while loading, so a lexicon is only loaded once)
+                boost::mutex::scoped_lock lock( shared_mutex() );
+#endif
+                std::map<std::string, pointer>::iterator pos = lexicons.find( filename );
+                if( pos != lexicons.end() )
+                    return pos->second;
+
+                pointer lexicon = load( filename );
+                lexicons[filename] = lexicon;
+                return lexicon;
+            }
+
+/* *********************************************************************
+ *        save( filename ) -- write the compiled form for load()
+ *********************************************************************** */
+            void save( const std::string& filename ) const {
+                std::ofstream file( filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+                if( !file )
+                    throw LexiconException( "Couldn't write lexicon " + filename );
+                file.write( m_base, m_size );
+                if( !file )
+                    throw LexiconException( "Couldn't write lexicon " + filename );
+            }
+
+
+            // tags
+            std::size_t num_tags() const { return m_header->num_tags; }
+
+            const char *tag_name( tag_id tag ) const {
+                return m_pool + m_tag_names[tag];
+            }
+
+            tag_id find_tag( const std::string& name ) const {
+                for( tag_id t = 0; t < m_header->num_tags; t++ ){
+                    if( name == tag_name(t) ) return t;
+                }
+                return no_tag;
+            }
+
+            // how often `to` follows `from`; zero when it never does
+            boost::uint32_t transition( tag_id from, tag_id to ) const {
+                return m_transitions[from * m_header->num_tags + to];
+            }
+
+            // words
+            std::size_t num_words() const { return m_header->num_words; }
+
+            // what find_word() returns for words we don't know
+            word_id no_word() const { return m_header->num_words; }
+
+            // binary search of the sorted word table
+            word_id find_word( const char *word, std::size_t length ) const {
+                boost::uint32_t lo = 0, hi = m_header->num_words;
+                while( lo < hi ){
+                    boost::uint32_t mid = lo + (hi - lo) / 2;
+                    int cmp = compare( m_pool + m_words[mid], word, length );
+                    if( cmp == 0 ) return mid;
+                    if( cmp < 0 ) lo = mid + 1;
+                    else hi = mid;
+                }
+                return m_header->num_words;
+            }
+
+            word_id find_word( const std::string& word ) const {
+                return find_word( word.data(), word.size() );
+            }
+
+            bool contains( const std::string& word ) const {
+                return find_word( word ) != m_header->num_words;
+            }
+
+            // the (tag, count) pairs of a word, in tag order; empty for
+            // words we don't know
+            std::pair<const tag_count*, const tag_count*> tags( word_id w ) const {
+                if( w >= m_header->num_words )
+                    return std::make_pair( m_entries, m_entries );
+                return std::make_pair( m_entries + m_word_entries[w], m_entries + m_word_entries[w+1] );
+            }
+
+            std::pair<const tag_count*, const tag_count*> tags( const std::string& word ) const {
+                return tags( find_word( word ) );
+            }
+
+
+        private:
+            static const char *file_magic() { return "SELEX01"; } // 8 bytes with the NUL
+            static const boost::uint32_t byte_order = 0x01020304;
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+            static boost::mutex& shared_mutex(){
+                static boost::mutex mutex;
+                return mutex;
+            }
+#endif
+
+            struct header {
+                char magic[8];
+                boost::uint32_t byte_order;
+                boost::uint32_t num_tags;
+                boost::uint32_t num_words;
+                boost::uint32_t num_entries;
+                boost::uint32_t pool_size;
+                boost::uint32_t reserved;
+            };
+
+            // the block is laid out as
+            //   header | tag names | words | word entries | entries | transitions | pool
+            // where names and words are offsets into the string pool
+            std::vector<char> m_data;   // when we compiled it ourselves
+            void *m_map;                // when it's mapped from a file
+            std::size_t m_map_size;
+
+            const char *m_base;
+            std::size_t m_size;
+            const header *m_header;
+            const boost::uint32_t *m_tag_names;
+            const boost::uint32_t *m_words;
+            const boost::uint32_t *m_word_entries;
+            const tag_count *m_entries;
+            const boost::uint32_t *m_transitions;
+            const char *m_pool;
+
+
+            // open a compiled lexicon
+            compiled_lexicon( const std::string& filename ) : m_map(0), m_map_size(0) {
+#ifndef WIN32
+                int fd = open( filename.c_str(), O_RDONLY );
+                if( fd < 0 )
+                    throw LexiconException( "Couldn't open lexicon " + filename );
+                struct stat st;
+                if( fstat( fd, &st ) != 0 ){
+                    close( fd );
+                    throw LexiconException( "Couldn't open lexicon " + filename );
+                }
+                void *map = mmap( 0, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+                close( fd );
+                if( map == MAP_FAILED )
+                    throw LexiconException( "Couldn't map lexicon " + filename );
+                m_map = map;
+                m_map_size = st.st_size;
+                try {
+                    attach( (const char *)map, st.st_size, filename );
+                    check( filename );
+                } catch ( LexiconException& ){
+                    // (the destructor won't be run)
+                    munmap( m_map, m_map_size );
+                    throw;
+                }
+#else
+                std::ifstream file( filename.c_str(), std::ios_base::in | std::ios_base::binary );
+                if( !file )
+                    throw LexiconException( "Couldn't open lexicon " + filename );
+                m_data.assign( std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() );
+                attach( &m_data[0], m_data.size(), filename );
+                check( filename );
+#endif
+            }
+
+            // point the accessors into a block, checking that it holds
+            // everything the header says it does
+            void attach( const char *base, std::size_t size, const std::string& name ){
+                if( size < sizeof(header) )
+                    throw LexiconException( "Lexicon " + name + " is truncated" );
+                const header *h = (const header *)base;
+                if( memcmp( h->magic, file_magic(), sizeof(h->magic) ) != 0 )
+                    throw LexiconException( "Lexicon " + name + " isn't a compiled lexicon" );
+                if( h->byte_order != byte_order )
+                    throw LexiconException( "Lexicon " + name + " was compiled with a different byte order" );
+
+                std::size_t needed = sizeof(header)
+                    + sizeof(boost::uint32_t) * ( (std::size_t)h->num_tags + 2 * (std::size_t)h->num_words + 1 )
+                    + sizeof(tag_count) * (std::size_t)h->num_entries
+                    + sizeof(boost::uint32_t) * (std::size_t)h->num_tags * h->num_tags
+                    + h->pool_size;
+                if( size < needed )
+                    throw LexiconException( "Lexicon " + name + " is truncated" );
+
+                m_base = base;
+                m_size = needed;
+                m_header = h;
+                m_tag_names = (const boost::uint32_t *)(base + sizeof(header));
+                m_words = m_tag_names + h->num_tags;
+                m_word_entries = m_words + h->num_words;
+                m_entries = (const tag_count *)(m_word_entries + h->num_words + 1);
+                m_transitions = (const boost::uint32_t *)(m_entries + h->num_entries);
+                m_pool = (const char *)(m_transitions + (std::size_t)h->num_tags * h->num_tags);
+            }
+
+            // a lexicon from a file, after attach(): everything in it has to
+            // point inside it.  every string starts in the pool (which ends
+            // with a NUL, so it ends there too), every word's entries are in
+            // the entry table and every entry's tag is a tag
+            void check( const std::string& name ) const {
+                const header *h = m_header;
+                if( h->pool_size == 0 || m_pool[h->pool_size - 1] != '\0' )
+                    throw LexiconException( "Lexicon " + name + " is corrupt" );
+                for( boost::uint32_t t = 0; t < h->num_tags; t++ ){
+                    if( m_tag_names[t] >= h->pool_size )
+                        throw LexiconException( "Lexicon " + name + " is corrupt" );
+                }
+                for( boost::uint32_t w = 0; w < h->num_words; w++ ){
+                    if( m_words[w] >= h->pool_size || m_word_entries[w] > m_word_entries[w+1] )
+                        throw LexiconException( "Lexicon " + name + " is corrupt" );
+                }
+                if( m_word_entries[h->num_words] > h->num_entries )
+                    throw LexiconException( "Lexicon " + name + " is corrupt" );
+                for( boost::uint32_t e = 0; e < h->num_entries; e++ ){
+                    if( m_entries[e].tag >= h->num_tags )
+                        throw LexiconException( "Lexicon " + name + " is corrupt" );
+                }
+            }
+
+            // strcmp() of a pooled word against a word that isn't NUL terminated
+            static int compare( const char *pooled, const char *word, std::size_t length ){
+                const unsigned char *a = (const unsigned char *)pooled;
+                const unsigned char *b = (const unsigned char *)word;
+                std::size_t i = 0;
+                while( i < length && a[i] && a[i] == b[i] ) i++;
+                if( i == length ) return a[i] ? 1 : 0;
+                return a[i] < b[i] ? -1 : 1;
+            }
+
+
+/* *********************************************************************
+ *        compile the text lexicon into the flat block
+ *********************************************************************** */
+            void compile( std::istream& lex_stream ){
+                typedef std::map<std::string, unsigned long> Counts;
+                std::map<std::string, Counts> lexicon, hmm;
+                read_text( lex_stream, lexicon, hmm );
+
+                // intern the tags; the tagger always needs these three
+                std::set<std::string> tag_set;
+                tag_set.insert("PP");
+                tag_set.insert("NN");
+                tag_set.insert("SYM");
+                std::map<std::string, Counts>::const_iterator pos;
+                Counts::const_iterator cpos;
+                for( pos = lexicon.begin(); pos != lexicon.end(); ++pos ){
+                    for( cpos = pos->second.begin(); cpos != pos->second.end(); ++cpos )
+                        tag_set.insert( cpos->first );
+                }
+                for( pos = hmm.begin(); pos != hmm.end(); ++pos ){
+                    tag_set.insert( pos->first );
+                    for( cpos = pos->second.begin(); cpos != pos->second.end(); ++cpos )
+                        tag_set.insert( cpos->first );
+                }
+                std::map<std::string, boost::uint32_t> tag_ids;
+                std::vector<std::string> tags( tag_set.begin(), tag_set.end() );
+                for( boost::uint32_t i = 0; i < tags.size(); i++ )
+                    tag_ids[tags[i]] = i;
+
+                std::size_t num_entries = 0;
+                for( pos = lexicon.begin(); pos != lexicon.end(); ++pos )
+                    num_entries += pos->second.size();
+
+                // the string pool
+                std::string pool;
+                std::vector<boost::uint32_t> tag_names, words;
+                for( std::size_t i = 0; i < tags.size(); i++ ){
+                    tag_names.push_back( pool.size() );
+                    pool.append( tags[i] );
+                    pool.push_back( '\0' );
+                }
+                for( pos = lexicon.begin(); pos != lexicon.end(); ++pos ){
+                    words.push_back( pool.size() );
+                    pool.append( pos->first );
+                    pool.push_back( '\0' );
+                }
+
+                header h;
+                memset( &h, 0, sizeof(h) );
+                memcpy( h.magic, file_magic(), sizeof(h.magic) );
+                h.byte_order = byte_order;
+                h.num_tags = tags.size();
+                h.num_words = lexicon.size();
+                h.num_entries = num_entries;
+                h.pool_size = pool.size();
+
+                std::size_t size = sizeof(header)
+                    + sizeof(boost::uint32_t) * ( tags.size() + 2 * lexicon.size() + 1 )
+                    + sizeof(tag_count) * num_entries
+                    + sizeof(boost::uint32_t) * tags.size() * tags.size()
+                    + pool.size();
+                m_data.assign( size, 0 );
+                char *base = &m_data[0];
+                memcpy( base, &h, sizeof(h) );
+                attach( base, size, "" );
+
+                boost::uint32_t *tag_out = const_cast<boost::uint32_t *>(m_tag_names);
+                boost::uint32_t *word_out = const_cast<boost::uint32_t *>(m_words);
+                boost::uint32_t *word_entries_out = const_cast<boost::uint32_t *>(m_word_entries);
+                tag_count *entries_out = const_cast<tag_count *>(m_entries);
+                boost::uint32_t *transitions_out = const_cast<boost::uint32_t *>(m_transitions);
+
+                std::copy( tag_names.begin(), tag_names.end(), tag_out );
+                std::copy( words.begin(), words.end(), word_out );
+
+                // std::map keeps both the words and each word's tags in
+                // alphabetical order, which is the order the tags were
+                // numbered in
+                boost::uint32_t w = 0, e = 0;
+                for( pos = lexicon.begin(); pos != lexicon.end(); ++pos, ++w ){
+                    word_entries_out[w] = e;
+                    for( cpos = pos->second.begin(); cpos != pos->second.end(); ++cpos, ++e ){
+                        entries_out[e].tag = tag_ids[cpos->first];
+                        entries_out[e].count = cpos->second;
+                    }
+                }
+                word_entries_out[w] = e;
+
+                for( pos = hmm.begin(); pos != hmm.end(); ++pos ){
+                    boost::uint32_t from = tag_ids[pos->first];
+                    for( cpos = pos->second.begin(); cpos != pos->second.end(); ++cpos )
+                        transitions_out[from * tags.size() + tag_ids[cpos->first]] = cpos->second;
+                }
+
+                memcpy( const_cast<char *>(m_pool), pool.data(), pool.size() );
+            }
+
+            // the text format: a "## Hidden Markov Model" section of
+            // "TAG: { TAG: count, ... }" lines, then a "## Lexicon"
+            // section of "word: { TAG: count, ... }" lines
+            static void read_text( std::istream& lex_stream,
+                                   std::map<std::string, std::map<std::string, unsigned long> >& lexicon,
+                                   std::map<std::string, std::map<std::string, unsigned long> >& hmm ){
+                std::string lex = "hmm";
+                std::string line;
+
+                while (std::getline(lex_stream,line)) {
+
+                    if( line.compare(0,10,"## Lexicon") == 0 ){
+                        lex = "lex";
+                    } else if ( line.compare(0,22,"## Hidden Markov Model") == 0){
+                        lex = "hmm";
+                    }
+
+                    if ( line.compare(0,1,"#") != 0 ) {
+                        std::string::size_type pos = line.find_first_of(" ", 0);
+                        std::string word = line.substr(0,pos-1);
+                        std::string delim = " {},:";
+                        std::string::size_type lastPos = line.find_first_not_of(delim,pos);
+                        pos = line.find_first_of(delim,lastPos);
+
+
+                        while( pos != std::string::npos || lastPos != std::string::npos ){
+
+                            // POS TAG
+                            std::string tag = line.substr(lastPos,pos-lastPos);
+                            lastPos = line.find_first_not_of(delim,pos);
+                            pos = line.find_first_of(delim,lastPos);
+
+                            // Frequency
+                            unsigned long value;
+                            std::string num = line.substr(lastPos,pos-lastPos);
+                            value = strtoul( num.c_str(), NULL, 10 );
+                            lastPos = line.find_first_not_of(delim,pos);
+                            pos = line.find_first_of(delim,lastPos);
+
+                            // Record
+                            if( lex == "lex" ){
+                                lexicon[word][tag] = value;
+                            } else if ( lex == "hmm" ) {
+                                hmm[word][tag] = value;
+                            }
+                        }
+
+                    }
+                }
+            }
+    };
+
+} // namespace semantic
+
+#endif
@@ -0,0 +1,244 @@
+/*
+a process-wide cache of vertex neighbor lists, shared by every graph using
+the same storage policy.
+
+the storage policies look here in fetch_vertex_neighbors() before going to
+the database, so all the subgraph policies get the benefit of the lists other
+searches have already fetched -- the hot term vertices in particular.  lists
+are filed under a collection key (which database, which collection) and the
+least recently used ones are thrown out once the cache grows past its byte
+budget.
+
+a collection's lists go when changes to it are committed from this process,
+and also when the storage policy sees a new collection version (see
+get_collection_version()), which it checks once per search so commits from
+other processes are noticed too.
+
+the cache is locked with a mutex when the Boost thread library was found
+at configure time, and is for single threaded use otherwise.
+*/
+
+#ifndef __SEMANTIC_NEIGHBOR_CACHE_HPP__
+#define __SEMANTIC_NEIGHBOR_CACHE_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/properties.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/utility.hpp>
+
+#include <string>
+#include <map>
+#include <list>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+namespace semantic {
+
+	template <class StoragePolicySelector>
+	class neighbor_cache : boost::noncopyable {
+		typedef se_graph_traits<StoragePolicySelector> traits;
+		typedef typename traits::vertex_id_type id_type;
+		typedef typename traits::neighbor_list neighbor_list;
+
+		public:
+			struct statistics {
+				unsigned long hits, misses;		// neighbor lists found / not found
+				unsigned long evictions;		// lists thrown out to stay in budget
+				unsigned long invalidations;	// collections dropped after a change
+				std::size_t entries, bytes, budget;
+			};
+
+			explicit neighbor_cache(std::size_t budget = 32 * 1024 * 1024) : m_budget(budget), m_bytes(0) {
+				reset_statistics();
+			}
+
+			// the one every graph of this storage policy uses
+			static neighbor_cache &shared() {
+				static neighbor_cache cache;
+				return cache;
+			}
+
+			// a budget of 0 turns the cache off
+			void set_budget(std::size_t bytes) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_budget = bytes;
+				trim();
+			}
+
+			std::size_t get_budget() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_budget;
+			}
+
+			bool enabled() {
+				return get_budget() > 0;
+			}
+
+			// copies the cached lists for i -> i_end into m the way the storage
+			// policies' fetch_vertex_neighbors() does (no entry for a vertex
+			// without neighbors); the ids that aren't cached go to missing
+			template <class IdIterator, class Map, class OutIterator>
+			void find(const std::string &collection, IdIterator i, IdIterator i_end, Map &m, OutIterator missing) {
+				typedef typename Map::value_type::second_type container_type;
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				for(; i != i_end; ++i) {
+					typename index_type::iterator e = m_index.find(std::make_pair(collection, *i));
+					if (e == m_index.end()) {
+						m_stats.misses++;
+						*missing = *i;
+						continue;
+					}
+
+					m_entries.splice(m_entries.begin(), m_entries, e->second);
+					const neighbor_list &list = e->second->neighbors;
+					if (!list.empty()) {
+						container_type &c = m[*i];
+						std::copy(list.begin(), list.end(), inserter(c, c.end()));
+					}
+					m_stats.hits++;
+				}
+			}
+
+			// stores the lists just fetched for i -> i_end; ids that aren't in
+			// fetched had no neighbors, which is worth remembering too
+			template <class IdIterator>
+			void insert(const std::string &collection, IdIterator i, IdIterator i_end,
+						const typename traits::mapped_neighbor_list &fetched) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				if (m_budget == 0) return;
+
+				for(; i != i_end; ++i) {
+					key_type key(collection, *i);
+					typename index_type::iterator old = m_index.find(key);
+					if (old != m_index.end()) remove(old);
+
+					m_entries.push_front(entry());
+					entry &e = m_entries.front();
+					e.key = key;
+					typename traits::mapped_neighbor_list::const_iterator f = fetched.find(*i);
+					if (f != fetched.end()) e.neighbors = f->second;
+					e.bytes = size_of(e);
+
+					m_bytes += e.bytes;
+					m_index.insert(std::make_pair(key, m_entries.begin()));
+				}
+				trim();
+			}
+
+			// drops the collection's lists if they were cached against some
+			// other version of it
+			void validate(const std::string &collection, const std::string &version) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				std::map<std::string, std::string>::iterator v = m_versions.find(collection);
+				if (v != m_versions.end() && v->second == version) return;
+				if (v != m_versions.end()) drop(collection);
+				m_versions[collection] = version;
+			}
+
+			void invalidate(const std::string &collection) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				drop(collection);
+				m_versions.erase(collection);
+			}
+
+			void clear() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_entries.clear();
+				m_index.clear();
+				m_versions.clear();
+				m_bytes = 0;
+			}
+
+			statistics get_statistics() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				statistics s = m_stats;
+				s.entries = m_index.size();
+				s.bytes = m_bytes;
+				s.budget = m_budget;
+				return s;
+			}
+
+			void reset_statistics() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_stats.hits = m_stats.misses = m_stats.evictions = m_stats.invalidations = 0;
+				m_stats.entries = m_stats.bytes = m_stats.budget = 0;
+			}
+
+		private:
+			typedef std::pair<std::string, id_type> key_type;
+			struct entry {
+				key_type key;
+				neighbor_list neighbors;
+				std::size_t bytes;
+			};
+			typedef std::list<entry> list_type;
+			typedef std::map<key_type, typename list_type::iterator> index_type;
+
+			list_type m_entries;	// most recently used first
+			index_type m_index;
+			std::map<std::string, std::string> m_versions;
+			std::size_t m_budget, m_bytes;
+			statistics m_stats;
+#if SEMANTIC_HAVE_BOOST_THREAD
+			boost::mutex m_mutex;
+#endif
+
+			// roughly what an entry costs us, bookkeeping included
+			static std::size_t size_of(const entry &e) {
+				std::size_t bytes = sizeof(entry) + 4 * sizeof(void *) + e.key.first.capacity();
+				bytes += e.neighbors.capacity() * sizeof(typename neighbor_list::value_type);
+				for(typename neighbor_list::const_iterator n = e.neighbors.begin(); n != e.neighbors.end(); ++n) {
+					bytes += n->second.content.capacity();
+				}
+				return bytes;
+			}
+
+			// (the lock is held for all of these)
+			void remove(typename index_type::iterator i) {
+				m_bytes -= i->second->bytes;
+				m_entries.erase(i->second);
+				m_index.erase(i);
+			}
+
+			void drop(const std::string &collection) {
+				typename index_type::iterator i = m_index.lower_bound(key_type(collection, id_type()));
+				if (i == m_index.end() || i->first.first != collection) return;
+				while (i != m_index.end() && i->first.first == collection) remove(i++);
+				m_stats.invalidations++;
+			}
+
+			void trim() {
+				while (m_bytes > m_budget && !m_entries.empty()) {
+					m_index.erase(m_entries.back().key);
+					m_bytes -= m_entries.back().bytes;
+					m_entries.pop_back();
+					m_stats.evictions++;
+				}
+			}
+	};
+
+} // namespace semantic
+
+#endif
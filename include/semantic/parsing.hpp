@@ -3,13 +3,16 @@
 #define __SEMANTIC_PARSING_HPP__
 
 #include <semantic/tagger.hpp>
-#include <semantic/stem/english_stem.h>
+#include <semantic/language.hpp>
 #include <semantic/filter.hpp>
+#include <semantic/term_dictionary.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <map>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <utility>
 #include <cctype>
 #include <iostream>
 
@@ -23,13 +26,20 @@ namespace semantic {
         public:
             typedef std::map<std::string,int> UnstemmedCount;
 
+            // (term id, count) pairs in order of term id
+            typedef std::vector<std::pair<term_id,int> > term_vector;
+
             
             text_parser( const std::string &lexicon_location="" )
-                : parser(lexicon_location) {
+                : parser(lexicon_location), analyzer(text_analyzer::for_language("en")) {
                 enable_stemming = true;
             }
             text_parser( std::istream& lexicon_stream )
-                : parser( lexicon_stream ){
+                : parser( lexicon_stream ), analyzer(text_analyzer::for_language("en")) {
+                enable_stemming = true;
+            }
+            text_parser( compiled_lexicon::pointer lexicon )
+                : parser( lexicon ), analyzer(text_analyzer::for_language("en")) {
                 enable_stemming = true;
             }
             
@@ -45,6 +55,23 @@ namespace semantic {
             }
             
 
+/* ************************************************************************
+    set_language( std::string ) -- the language texts are in, by ISO 639-1
+            code or English name (see language.hpp); 'en' (the default) is
+            the only one we can POS tag, the others take every word that
+            isn't a stopword, whatever the parsing method
+   ************************************************************************ */
+
+            void set_language( const std::string& language ){
+                if( language == analyzer->language() ) return;
+                analyzer = text_analyzer::for_language( language );
+            }
+
+            const std::string& get_language() const {
+                return analyzer->language();
+            }
+
+
 
 /* ************************************************************************
     parse ( stream ) -- parse a text stream, returning stemmed terms
@@ -89,25 +116,94 @@ namespace semantic {
             std::map<std::string,int> parse(
                           const std::string& intext,
                           std::map<std::string,UnstemmedCount>& unstemmed ) {
+                return stem( tagged_terms( intext ), unstemmed );
+            }
+
+
+/* ************************************************************************
+    parse ( string, dictionary, terms, unstemmed ) -- the same, with the
+                                          terms and words interned in the
+                                          dictionary: `terms` gets the
+                                          stemmed terms' ids and counts,
+                                          and `unstemmed` counts the words
+                                          each term came from
+   ************************************************************************ */
+            void parse( const std::string& intext,
+                        term_dictionary& dictionary,
+                        term_vector& terms,
+                        variant_counts& unstemmed ){
+                stem( tagged_terms( intext ), dictionary, terms, unstemmed );
+            }
+
+
+
+
+/* ************************************************************************
+    add_word_filter ( class word_filter ) -- add a word-based filter
+                                             to the parser
+   ************************************************************************ */
+            
+            template <class Filter>
+            void add_word_filter(Filter f) {
+                word_filters.push_back( WordPtr( new Filter(f) ) );
+            }
+            
+
+            
+            void set_stemming(bool val){
+                enable_stemming = val;
+            }
+
+/* ************************************************************************
+    reset () -- forget the tagger's state (the previous POS tag) so the
+                next text is tagged as if it were the first one
+   ************************************************************************ */
+            void reset(){
+                parser.reset();
+            }
+            
 
-                // POS tag
+        private:
+            typedef boost::shared_ptr<word_filter> WordPtr;
+
+            tagger parser;
+            text_analyzer::pointer analyzer;
+            bool enable_stemming;
+            std::string POS_pattern;
+            std::vector<WordPtr> word_filters;
+            std::map<std::string,int> unstemmed;
+
+
+/* ************************************************************************
+    tagged_terms ( string ) -- the words we want from a text, POS tagged
+                               (or just split into words, for a language
+                               we can't tag) and passed through the word
+                               filters
+   ************************************************************************ */
+            std::map<std::string,int> tagged_terms( const std::string& intext ){
+
+                // POS tag (or just split into words)
                 std::map<std::string,int> terms;
 				
 				try {
-                    if( POS_pattern == "noun_phrases"){
-                        terms = parser.get_noun_phrases( intext );
-                    } else if ( POS_pattern == "adjectives"){
-                        terms = parser.get_adjectives( intext );
-                    } else if ( POS_pattern == "maximal_noun_phrases"){
-                        terms = parser.get_maximal_noun_phrases( intext );
-                    } else if ( POS_pattern == "proper_nouns") {
-                        terms = parser.get_proper_nouns( intext );
-                    } else if ( POS_pattern == "verbs") {
-                        terms = parser.get_verbs( intext );
+                    if( !analyzer->tagged() ){
+                        analyzer->tokenize( intext, terms );
                     } else {
-                        terms = parser.get_nouns( intext );
+                        if( POS_pattern == "noun_phrases"){
+                            terms = parser.get_noun_phrases( intext );
+                        } else if ( POS_pattern == "adjectives"){
+                            terms = parser.get_adjectives( intext );
+                        } else if ( POS_pattern == "maximal_noun_phrases"){
+                            terms = parser.get_maximal_noun_phrases( intext );
+                        } else if ( POS_pattern == "proper_nouns") {
+                            terms = parser.get_proper_nouns( intext );
+                        } else if ( POS_pattern == "verbs") {
+                            terms = parser.get_verbs( intext );
+                        } else {
+                            terms = parser.get_nouns( intext );
+                        }
+                        terms = parser.remove_tags( terms );
                     }
-					terms = parser.remove_tags( terms );
 
                 } catch ( std::exception& e ){
                     std::string POS = POS_pattern;
@@ -140,39 +236,10 @@ namespace semantic {
                     }
                 }
 				
-                return stem( terms, unstemmed );
+                return terms;
             }
 
 
-
-
-/* ************************************************************************
-    add_word_filter ( class word_filter ) -- add a word-based filter
-                                             to the parser
-   ************************************************************************ */
-            
-            template <class Filter>
-            void add_word_filter(Filter f) {
-                word_filters.push_back( WordPtr( new Filter(f) ) );
-            }
-            
-
-            
-            void set_stemming(bool val){
-                enable_stemming = val;
-            }
-            
-
-        private:
-            typedef boost::shared_ptr<word_filter> WordPtr;
-
-            tagger parser;
-            bool enable_stemming;
-            std::string POS_pattern;
-            std::vector<WordPtr> word_filters;
-            std::map<std::string,int> unstemmed;
-
-
 /* ************************************************************************
     stem ( terms, unstemmed_lookup ) -- stem the words in `terms` map
                                         and keep the original word forms
@@ -181,25 +248,14 @@ namespace semantic {
             std::map<std::string,int> stem(
                         const std::map<std::string,int>& terms,
                         std::map<std::string,UnstemmedCount>& unstemmed ){
-				stemming::english_stem Stemmer;
-                std::string letters("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
 				std::map<std::string,int> stemmed;
                 std::map<std::string,int>::const_iterator pos;
 				
 				for( pos = terms.begin(); pos != terms.end(); ++pos ){
-                    std::string word( pos->first );
-				    std::string original(word);
-					if( enable_stemming && word.find_first_of(letters) != std::string::npos){
-                        Stemmer(word);
-                    }
-                    if( word.length() > 0 ){
-
-                        // Make lower case
-                        std::string lower(word);
-                        std::transform(word.begin(),word.end(),lower.begin(),tolower);
-
+                    std::string lower = stem_word( pos->first );
+                    if( lower.length() > 0 ){
                         stemmed[lower] += pos->second;
-                        unstemmed[lower][original]++;
+                        unstemmed[lower][pos->first]++;
                         unstemmed[lower]["__count"]++;
                     }
                 }
@@ -207,6 +263,56 @@ namespace semantic {
 
             }
 
+            void stem( const std::map<std::string,int>& terms,
+                       term_dictionary& dictionary,
+                       term_vector& stemmed,
+                       variant_counts& unstemmed ){
+                std::vector<std::string> words;     // stem, word, stem, word...
+                std::vector<int> counts;
+                std::map<std::string,int>::const_iterator pos;
+
+				for( pos = terms.begin(); pos != terms.end(); ++pos ){
+                    std::string lower = stem_word( pos->first );
+                    if( lower.length() > 0 ){
+                        words.push_back( lower );
+                        words.push_back( pos->first );
+                        counts.push_back( pos->second );
+                    }
+                }
+
+                std::vector<term_id> ids( words.size() );
+                dictionary.intern( words.begin(), words.end(), ids.begin() );
+
+                stemmed.clear();
+                for( std::vector<int>::size_type i = 0; i < counts.size(); i++ ){
+                    stemmed.push_back( std::make_pair( ids[2*i], counts[i] ) );
+                    unstemmed.add( ids[2*i], ids[2*i+1] );
+                }
+
+                // different words can have the same stem
+                std::sort( stemmed.begin(), stemmed.end() );
+                term_vector::size_type n = 0;
+                for( term_vector::size_type i = 0; i < stemmed.size(); i++ ){
+                    if( n > 0 && stemmed[n-1].first == stemmed[i].first )
+                        stemmed[n-1].second += stemmed[i].second;
+                    else
+                        stemmed[n++] = stemmed[i];
+                }
+                stemmed.resize( n );
+            }
+
+            // the lower case stem of a word ("" to leave it out)
+            std::string stem_word( const std::string& original ){
+                std::string word( original );
+                if( enable_stemming && ( !analyzer->tagged() ||
+                        word.find_first_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ") != std::string::npos ) ){
+                    analyzer->stem(word);
+                }
+
+                // Make lower case
+                return analyzer->lowercase(word);
+            }
+
 
 
 
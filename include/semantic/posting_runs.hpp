@@ -0,0 +1,203 @@
+/*
+postings on disk, for indexing more than fits in memory (see
+text_indexer::set_memory_budget).
+
+postings -- a document, a term in it and how strong -- pile up in memory
+until they reach the budget, then go out to a temporary file, sorted, as a
+"run".  once everything is in, the runs are read back all at once, merged
+into a single sorted stream:
+
+	posting_runs runs(64 << 20);
+	runs.add(doc, term, strength);		// ... lots of times
+	runs.start_merge(16 << 20);
+	posting p;
+	while (runs.next(p)) ...
+
+temporary files come from tmpfile(), so they're gone once they're closed,
+even if we never get that far.
+*/
+
+#ifndef __SEMANTIC_POSTING_RUNS_HPP__
+#define __SEMANTIC_POSTING_RUNS_HPP__
+
+#include <semantic/term_dictionary.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace semantic {
+
+    // - when a temporary file can't be made or written to (usually a full disk)
+    struct TemporaryFileException : std::exception {
+        const char* what() const throw() { return "Couldn't write to a temporary file"; }
+    };
+
+
+/* *******************************************************
+        TEMPORARY FILE
+
+        a binary scratch file that deletes itself when it's
+        closed.  write everything, rewind(), read it back.
+   ******************************************************* */
+    class temporary_file : boost::noncopyable {
+        public:
+            temporary_file() : m_file(std::tmpfile()) {
+                if (!m_file) throw TemporaryFileException();
+            }
+            ~temporary_file() { std::fclose(m_file); }
+
+            void write(const void *data, std::size_t bytes) {
+                if (bytes > 0 && std::fwrite(data, 1, bytes, m_file) != bytes) throw TemporaryFileException();
+            }
+
+            // how many bytes it got, which is fewer than asked at the end
+            std::size_t read(void *data, std::size_t bytes) {
+                return bytes > 0 ? std::fread(data, 1, bytes, m_file) : 0;
+            }
+
+            void write_string(const std::string &s) {
+                boost::uint32_t size = static_cast<boost::uint32_t>(s.size());
+                write(&size, sizeof(size));
+                write(s.data(), s.size());
+            }
+
+            bool read_string(std::string &s) {
+                boost::uint32_t size;
+                if (read(&size, sizeof(size)) != sizeof(size)) return false;
+                s.resize(size);
+                return size == 0 || read(&s[0], size) == size;
+            }
+
+            void rewind() {
+                if (std::fflush(m_file) != 0) throw TemporaryFileException();
+                std::rewind(m_file);
+            }
+
+        private:
+            std::FILE *m_file;
+    };
+
+
+    // a term in a document.  they sort by document, then term
+    struct posting {
+        boost::uint32_t doc;
+        term_id term;
+        boost::uint32_t strength;
+
+        bool operator<(const posting &p) const {
+            return doc < p.doc || (doc == p.doc && term < p.term);
+        }
+    };
+
+
+/* *******************************************************
+        POSTING RUNS
+   ******************************************************* */
+    class posting_runs : boost::noncopyable {
+        typedef boost::shared_ptr<temporary_file> file_ptr;
+
+        public:
+            // holds on to about `budget` bytes of postings at a time
+            explicit posting_runs(std::size_t budget)
+                : m_capacity(std::max<std::size_t>(budget / sizeof(posting), 1)), m_count(0) {}
+
+            void add(boost::uint32_t doc, term_id term, boost::uint32_t strength) {
+                if (m_buffer.empty()) m_buffer.reserve(m_capacity);
+                posting p;
+                p.doc = doc;
+                p.term = term;
+                p.strength = strength;
+                m_buffer.push_back(p);
+                m_count++;
+                if (m_buffer.size() >= m_capacity) spill();
+            }
+
+            // postings added, and runs written so far
+            std::size_t size() const { return m_count; }
+            std::size_t runs() const { return m_runs.size(); }
+
+            // sorts what's in memory and writes it out as a run
+            void spill() {
+                if (m_buffer.empty()) return;
+                std::sort(m_buffer.begin(), m_buffer.end());
+                file_ptr run(new temporary_file);
+                run->write(&m_buffer[0], m_buffer.size() * sizeof(posting));
+                run->rewind();
+                m_runs.push_back(run);
+                std::vector<posting>().swap(m_buffer);
+            }
+
+            // gets ready for next() to read the runs back, merged, with
+            // about `budget` bytes of read buffers between all of them.
+            // (whatever's still in memory is spilled first)
+            void start_merge(std::size_t budget) {
+                spill();
+                m_readers.clear();
+                m_heap = heap_type();
+
+                std::size_t each = std::max<std::size_t>(budget / sizeof(posting) / std::max<std::size_t>(m_runs.size(), 1), 1024);
+                for (std::size_t r = 0; r < m_runs.size(); ++r) {
+                    m_readers.push_back(reader(m_runs[r], each));
+                    posting p;
+                    if (m_readers.back().next(p)) m_heap.push(std::make_pair(p, r));
+                }
+            }
+
+            // the next posting in order; false when they're all done
+            bool next(posting &p) {
+                if (m_heap.empty()) return false;
+                p = m_heap.top().first;
+                std::size_t r = m_heap.top().second;
+                m_heap.pop();
+
+                posting following;
+                if (m_readers[r].next(following)) m_heap.push(std::make_pair(following, r));
+                return true;
+            }
+
+        private:
+            // a run being read back, a buffer at a time
+            class reader {
+                public:
+                    reader(file_ptr file, std::size_t buffer)
+                        : m_file(file), m_buffer(buffer), m_at(0), m_size(0) {}
+
+                    bool next(posting &p) {
+                        if (m_at == m_size) {
+                            m_size = m_file->read(&m_buffer[0], m_buffer.size() * sizeof(posting)) / sizeof(posting);
+                            m_at = 0;
+                            if (m_size == 0) return false;
+                        }
+                        p = m_buffer[m_at++];
+                        return true;
+                    }
+
+                private:
+                    file_ptr m_file;
+                    std::vector<posting> m_buffer;
+                    std::size_t m_at, m_size;
+            };
+
+            typedef std::pair<posting, std::size_t> heap_item;     // a run's next posting, and the run
+            typedef std::priority_queue<heap_item, std::vector<heap_item>, std::greater<heap_item> > heap_type;
+
+            std::size_t m_capacity, m_count;
+            std::vector<posting> m_buffer;
+            std::vector<file_ptr> m_runs;
+            std::vector<reader> m_readers;
+            heap_type m_heap;
+    };
+
+} // namespace semantic
+
+#endif
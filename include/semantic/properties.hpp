@@ -154,8 +154,9 @@ namespace semantic {
 		unsigned long from_degree;
 		unsigned long to_degree;
 		int energy_hits;
+		double weight;		// precomputed at indexing time; negative if storage has none
 		
-		edge_properties() : strength(0), from_degree(0), to_degree(0), energy_hits(0) {}
+		edge_properties() : strength(0), from_degree(0), to_degree(0), energy_hits(0), weight(-1) {}
 	};
 	
 } // namespace semantic
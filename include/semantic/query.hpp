@@ -10,7 +10,7 @@
 //#include <iostream>
 
 #include <semantic/semantic.hpp>
-#include <semantic/stem/english_stem.h>
+#include <semantic/language.hpp>
 
 
 namespace semantic {
@@ -23,6 +23,10 @@ namespace semantic {
 
 				std::string phrase_length_str = g.get_meta_value("max_phrase_length", "1");
 				phrase_length = atoi(phrase_length_str.c_str());
+
+				// and the language, to stem the terms the way they were indexed
+				analyzer = text_analyzer::for_language(g.get_meta_value("language", "en"));
+
 				// parse!
 				parse();
 				
@@ -52,17 +56,12 @@ namespace semantic {
 				std::vector<typename se_graph_traits<Graph>::vertex_id_type> node_ids;
 				
 				std::vector<std::string> terms = tokenize();
-				std::vector<std::string>::iterator pos;
-				for( pos = terms.begin(); pos != terms.end(); ++pos ){
-					
-					try {
-						node_ids.push_back( g.fetch_vertex_id_by_content_and_type(*pos, node_type_major_term) );
-					//	std::cout << "Vertex found: " << *pos << std::endl;
-					} catch ( std::exception & ){
-						// vertex not found.
-						//std::cerr << "Vertex not found: " << e.what() << std::endl;
-						continue;
-					}
+
+				// all at once; terms without a vertex are left out
+				std::vector<std::pair<std::string, typename se_graph_traits<Graph>::vertex_id_type> > found;
+				g.fetch_vertex_ids_by_content_and_type(terms.begin(), terms.end(), node_type_major_term, back_inserter(found));
+				for( unsigned int i = 0; i < found.size(); ++i ){
+					node_ids.push_back( found[i].second );
 				}
 				
 				return node_ids;
@@ -76,18 +75,14 @@ namespace semantic {
 			const std::string query_string;
 			bool stemming;
 			int phrase_length;
+			text_analyzer::pointer analyzer;
 			std::vector<std::string> stemmed_terms;
 			std::vector<std::string> raw_terms;
 				
 			void parse(){
 			
-				stemming::english_stem Stemmer;
-				
 				std::vector<std::string> non_quotes;
-				std::string my_query(query_string);
-				std::string lower(my_query);
-				std::transform(my_query.begin(),my_query.end(),lower.begin(),tolower);
-				my_query = lower;
+				std::string my_query = analyzer->lowercase(query_string);
 				
 				// replace any delimiters with spaces
 				std::string::size_type dpos1 = my_query.find_first_of("+\t,", 0);
@@ -132,7 +127,7 @@ namespace semantic {
 						raw_terms.push_back( phrase );
 						
 						// stem 
-						Stemmer(phrase);
+						analyzer->stem(phrase);
 						stemmed_terms.push_back(phrase);
 						
 						// go to the next quote
@@ -164,7 +159,7 @@ namespace semantic {
 						if( pos2 == std::string::npos ){
 							std::string term = raw_string.substr(pos1,raw_string.size()-pos1);
 							terms.push_back( term );
-							Stemmer(term);
+							analyzer->stem(term);
 							stems.push_back(term);
 
 							pos1 = std::string::npos;
@@ -173,7 +168,7 @@ namespace semantic {
 							std::string term = raw_string.substr(pos1,pos2-pos1);
 
 							terms.push_back( term );
-							Stemmer(term);
+							analyzer->stem(term);
 							stems.push_back(term);
 							
 							pos1 = raw_string.find_first_not_of(" ", pos2);
@@ -0,0 +1,393 @@
+
+#ifndef _MATRIX_ACTIVATION_HPP_
+#define _MATRIX_ACTIVATION_HPP_
+
+
+#include <semantic/config.hpp>
+#include <semantic/semantic.hpp>
+#include <semantic/utility.hpp>
+#include <semantic/compact_subgraph.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#endif
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace semantic {
+
+/* *******************************************************
+        TRANSITION MATRIX
+
+        a whole collection's graph as a sparse matrix: entry
+        (u, v) is the share of u's energy that goes to v, the
+        weight of the edge u -> v over the weight total of u's
+        out-edges -- the same split spreading_activation() makes.
+
+        the vertices are numbered 0..size()-1 and the matrix is
+        kept both ways round as compressed sparse rows: by source
+        (out_first/out_target/out_share), for pushing the energy
+        of a few vertices out along their edges, and by target
+        (in_first/in_source/in_share), for pulling it into every
+        vertex at once when much of the graph is lit up.
+
+        it's built from the graph's storage with
+        populate_full_graph() and weighed with the graph's own
+        weighting policy, then never changes, so any number of
+        searches can read one at the same time.
+   ******************************************************* */
+    template <class Graph>
+    class transition_matrix : boost::noncopyable {
+        public:
+            typedef boost::shared_ptr<const transition_matrix> pointer;
+            typedef typename se_graph_traits<Graph>::vertex_id_type id_type;
+            typedef boost::uint32_t index_type;
+            typedef double value_type;
+
+            // loads the collection g is opened on; g is cleared before and after
+            explicit transition_matrix(Graph &g) {
+                typedef typename se_graph_traits<Graph>::vertex_descriptor vertex_descriptor;
+
+                // the version from before we load, so a commit that lands in
+                // the middle makes us stale straight away
+                m_version = g.get_collection_version();
+
+                g.clear();
+                g.populate_full_graph(true);
+                compact_subgraph<Graph, value_type> c(g);
+
+                ids.reserve(c.size());
+                for (std::size_t i = 0; i < c.size(); ++i) {
+                    vertex_descriptor v = c.descriptors[i];
+                    m_index[g.get_vertex_id(v)] = (index_type)i;
+                    ids.push_back(g.get_vertex_id(v));
+                    types.push_back(g[v].type_major);
+                    contents.push_back(g[v].content);
+                }
+
+                out_first.assign(c.first_edge.begin(), c.first_edge.end());
+                out_target.assign(c.targets.begin(), c.targets.end());
+                out_share.resize(c.num_edges());
+                for (std::size_t u = 0; u < c.size(); ++u) {
+                    value_type total = 0;
+                    for (std::size_t e = c.first_edge[u]; e < c.first_edge[u + 1]; ++e) total += c.weights[e];
+                    for (std::size_t e = c.first_edge[u]; e < c.first_edge[u + 1]; ++e) {
+                        out_share[e] = total > 0 ? c.weights[e] / total : 0;
+                    }
+                }
+
+                // and turned round, bucketing the edges by target
+                in_first.assign(ids.size() + 1, 0);
+                for (std::size_t e = 0; e < out_target.size(); ++e) in_first[out_target[e] + 1]++;
+                for (std::size_t v = 0; v < ids.size(); ++v) in_first[v + 1] += in_first[v];
+
+                std::vector<std::size_t> next(in_first.begin(), in_first.end() - 1);
+                in_source.resize(out_target.size());
+                in_share.resize(out_share.size());
+                for (index_type u = 0; u < ids.size(); ++u) {
+                    for (std::size_t e = out_first[u]; e < out_first[u + 1]; ++e) {
+                        std::size_t f = next[out_target[e]]++;
+                        in_source[f] = u;
+                        in_share[f] = out_share[e];
+                    }
+                }
+
+                g.clear();
+            }
+
+            std::size_t size() const { return ids.size(); }
+            std::size_t num_edges() const { return out_target.size(); }
+
+            // the collection version the matrix was built from
+            const std::string &version() const { return m_version; }
+
+            // the matrix number of a vertex; size() if it isn't here
+            std::size_t index_of(id_type id) const {
+                typename maps::unordered<id_type, index_type>::const_iterator i = m_index.find(id);
+                return i == m_index.end() ? size() : i->second;
+            }
+
+            std::vector<id_type> ids;
+            std::vector<int> types;             // type_major
+            std::vector<std::string> contents;
+
+            std::vector<std::size_t> out_first, in_first;
+            std::vector<index_type> out_target, in_source;
+            std::vector<value_type> out_share, in_share;
+
+        private:
+            std::string m_version;
+            maps::unordered<id_type, index_type> m_index;
+    };
+
+
+/* *******************************************************
+        ACTIVATION MATRIX
+
+        hands out the transition matrix for a collection,
+        building it the first time it's asked for and again
+        whenever the collection version has moved on.  searches
+        in any number of threads can share one: each gets hold
+        of the matrix that was current when it started, and a
+        rebuild replaces it for the searches that come after
+        without pulling it out from under the ones that are
+        running.
+   ******************************************************* */
+    template <class Graph>
+    class activation_matrix : boost::noncopyable {
+        public:
+            typedef transition_matrix<Graph> matrix_type;
+            typedef typename matrix_type::pointer pointer;
+
+            // the matrix for the collection g is opened on (which gets
+            // cleared if it has to be loaded)
+            pointer current(Graph &g) {
+                std::string version = g.get_collection_version();
+#if SEMANTIC_HAVE_BOOST_THREAD
+                boost::mutex::scoped_lock lock(m_mutex);
+#endif
+                if (!m_matrix || m_matrix->version() != version || m_collection != g.collection()) {
+                    m_matrix.reset(new matrix_type(g));
+                    m_collection = g.collection();
+                }
+                return m_matrix;
+            }
+
+            void clear() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+                boost::mutex::scoped_lock lock(m_mutex);
+#endif
+                m_matrix.reset();
+            }
+
+        private:
+            pointer m_matrix;
+            std::string m_collection;
+#if SEMANTIC_HAVE_BOOST_THREAD
+            boost::mutex m_mutex;
+#endif
+    };
+
+
+    namespace detail {
+
+        // edges of work it takes before pulling is split between threads
+        const std::size_t matrix_parallel_edges = 1024 * 1024;
+
+        // y[v] for the vertices first..last-1: the energy pulled in
+        // along each one's in-edges.  the sum is kept four ways so
+        // the adds don't each wait on the one before, which lets
+        // the compiler pipeline (and vectorize) the loop.
+        template <class Matrix>
+        void pull_activation_rows(const Matrix &m, const std::vector<double> &x, std::vector<double> &y,
+                                  std::size_t first, std::size_t last, double decay, double threshold)
+        {
+            const typename Matrix::index_type *source = m.in_source.empty() ? 0 : &m.in_source[0];
+            const double *share = m.in_share.empty() ? 0 : &m.in_share[0];
+            const double *energy = &x[0];
+
+            for (std::size_t v = first; v < last; ++v) {
+                std::size_t e = m.in_first[v], e_end = m.in_first[v + 1];
+                double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+                for (; e + 4 <= e_end; e += 4) {
+                    s0 += energy[source[e]] * share[e];
+                    s1 += energy[source[e + 1]] * share[e + 1];
+                    s2 += energy[source[e + 2]] * share[e + 2];
+                    s3 += energy[source[e + 3]] * share[e + 3];
+                }
+                for (; e < e_end; ++e) s0 += energy[source[e]] * share[e];
+
+                double next = ((s0 + s1) + (s2 + s3)) * decay;
+                y[v] = next < threshold ? 0 : next;
+            }
+        }
+
+        // the same for every vertex, split between `threads` threads
+        // by in-edges rather than by vertices, so a few heavily
+        // linked terms don't leave one thread doing all the work
+        template <class Matrix>
+        void pull_activation(const Matrix &m, const std::vector<double> &x, std::vector<double> &y,
+                             double decay, double threshold, unsigned int threads)
+        {
+#if SEMANTIC_HAVE_BOOST_THREAD
+            if (threads > 1 && m.num_edges() >= matrix_parallel_edges) {
+                boost::thread_group group;
+                std::size_t first = 0;
+                for (unsigned int t = 1; t <= threads; ++t) {
+                    std::size_t last = m.size();
+                    if (t < threads) {
+                        std::size_t edges = m.num_edges() / threads * t;
+                        last = std::lower_bound(m.in_first.begin() + first, m.in_first.end() - 1, edges) - m.in_first.begin();
+                    }
+                    if (last > first) {
+                        group.create_thread(boost::bind(&pull_activation_rows<Matrix>, boost::cref(m), boost::cref(x), boost::ref(y),
+                                                        first, last, decay, threshold));
+                    }
+                    first = last;
+                }
+                group.join_all();
+                return;
+            }
+#endif
+            pull_activation_rows(m, x, y, 0, m.size(), decay, threshold);
+        }
+
+        template <class Matrix>
+        bool reaches_documents(const Matrix &m, const std::vector<typename Matrix::index_type> &active) {
+            for (std::size_t i = 0; i < active.size(); ++i) {
+                if (m.types[active[i]] == node_type_major_doc) return true;
+            }
+            return false;
+        }
+
+        // the best k documents, best first
+        template <class Matrix>
+        void top_documents(const Matrix &m, const std::vector<double> &rank,
+                           const std::vector<typename Matrix::index_type> &reached, std::size_t k,
+                           std::vector<typename Matrix::index_type> &top)
+        {
+            typedef typename Matrix::index_type index_type;
+            std::vector<std::pair<double, index_type> > docs;
+            for (std::size_t i = 0; i < reached.size(); ++i) {
+                // negated, so sorting puts the best first and ties go to
+                // the lower number
+                if (m.types[reached[i]] == node_type_major_doc) docs.push_back(std::make_pair(-rank[reached[i]], reached[i]));
+            }
+            std::size_t n = std::min(k, docs.size());
+            std::partial_sort(docs.begin(), docs.begin() + n, docs.end());
+
+            top.clear();
+            for (std::size_t i = 0; i < n; ++i) top.push_back(docs[i].second);
+        }
+    } // namespace detail
+
+
+/* *******************************************************
+        MATRIX ACTIVATION
+
+        spreading activation over a whole transition matrix,
+        as `steps` sparse matrix-vector products: the energy
+        starts at the nodes in `n` (id => starting energy),
+        and on each step every vertex passes what it got on the
+        step before to its neighbors, split by edge weight.
+        rank gets everything each vertex received along the way
+        and reached the vertices that received anything, in the
+        order they first did.
+
+        each step multiplies the energy by `decay`, and a vertex
+        that would get less than `threshold` in a step gets
+        nothing (and passes nothing on).  unlike
+        spreading_activation() an edge can carry energy on more
+        than one step, which is what makes it a matrix product.
+
+        a step only pushes energy along the out-edges of the
+        vertices that have some while there are few of them, and
+        pulls it into all of them (in `threads` threads) once
+        there are enough to make that cheaper.  either way the
+        result doesn't depend on the number of threads.
+
+        with stable_top > 0 it stops early once the best
+        stable_top documents have come out the same, in the same
+        order, on two steps running that reached documents.
+        returns the steps it took.
+   ******************************************************* */
+    template <class Matrix, class NodeMap>
+    unsigned int matrix_activation(const Matrix &m, const NodeMap &n,
+                                   std::vector<double> &rank,
+                                   std::vector<typename Matrix::index_type> &reached,
+                                   unsigned int steps = 4, double decay = 1, double threshold = 0,
+                                   std::size_t stable_top = 0, unsigned int threads = 1)
+    {
+        typedef typename Matrix::index_type index_type;
+
+        rank.assign(m.size(), 0);
+        reached.clear();
+        if (m.size() == 0) return 0;
+
+        // x is what each vertex has to pass on this step (and is all
+        // zeroes apart from the vertices in `active`); y gets what they
+        // pass, and is all zeroes at the start of each step
+        std::vector<double> x(m.size(), 0), y(m.size(), 0);
+        std::vector<index_type> active, next, top, last_top;
+
+        for (typename NodeMap::const_iterator i = n.begin(); i != n.end(); ++i) {
+            std::size_t v = m.index_of((*i).first);
+            if (v == m.size() || (*i).second <= 0) continue;
+            if (x[v] == 0) active.push_back((index_type)v);
+            x[v] += (*i).second;
+        }
+        for (std::size_t i = 0; i < active.size(); ++i) {
+            rank[active[i]] = x[active[i]];
+            reached.push_back(active[i]);
+        }
+
+        unsigned int step = 0;
+        while (step < steps && !active.empty()) {
+            std::size_t active_edges = 0;
+            for (std::size_t i = 0; i < active.size(); ++i) {
+                active_edges += m.out_first[active[i] + 1] - m.out_first[active[i]];
+            }
+
+            next.clear();
+            if (active_edges * 8 < m.num_edges()) {
+                for (std::size_t i = 0; i < active.size(); ++i) {
+                    index_type u = active[i];
+                    for (std::size_t e = m.out_first[u]; e < m.out_first[u + 1]; ++e) {
+                        double passed = x[u] * m.out_share[e];
+                        if (passed == 0) continue;
+                        index_type v = m.out_target[e];
+                        if (y[v] == 0) next.push_back(v);
+                        y[v] += passed;
+                    }
+                }
+
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < next.size(); ++i) {
+                    double &energy = y[next[i]];
+                    energy *= decay;
+                    if (energy < threshold) energy = 0;
+                    else next[kept++] = next[i];
+                }
+                next.resize(kept);
+            } else {
+                detail::pull_activation(m, x, y, decay, threshold, threads);
+                for (std::size_t v = 0; v < m.size(); ++v) {
+                    if (y[v] != 0) next.push_back((index_type)v);
+                }
+            }
+
+            for (std::size_t i = 0; i < active.size(); ++i) x[active[i]] = 0;
+            x.swap(y);
+            active.swap(next);
+
+            for (std::size_t i = 0; i < active.size(); ++i) {
+                index_type v = active[i];
+                if (rank[v] == 0) reached.push_back(v);
+                rank[v] += x[v];
+            }
+            ++step;
+
+            // (on a document/term graph every other step only reaches
+            // terms, and can't have changed the documents)
+            if (stable_top > 0 && detail::reaches_documents(m, active)) {
+                detail::top_documents(m, rank, reached, stable_top, top);
+                if (!top.empty() && top == last_top) break;
+                top.swap(last_top);
+            }
+        }
+
+        return step;
+    }
+} // namespace semantic
+
+#endif /* _MATRIX_ACTIVATION_HPP_ */
@@ -5,72 +5,135 @@
 
 #include <semantic/semantic.hpp>
 #include <semantic/utility.hpp>
+#include <semantic/compact_subgraph.hpp>
 
 #include <map>
-#include <set>
+#include <vector>
 #include <iterator>
 
 
 namespace semantic {
+
     namespace detail {
-        
-        template <class Graph, class WeightMap, class RankMap>
-        void activation_spider(
-                Graph &g,
-                typename se_graph_traits<Graph>::vertex_descriptor u,
-                WeightMap w, RankMap r,
-                int energy_hits,
-                typename property_traits<RankMap>::value_type energy,
-                std::set<typename se_graph_traits<Graph>::edge_descriptor> &seen)
+
+        template <class Value>
+        struct activation_frame {
+            activation_frame(std::size_t v, std::size_t e, Value x) : vertex(v), edge(e), energy(x) {}
+            std::size_t vertex;
+            std::size_t edge;   // the next out-edge to try
+            Value energy;
+        };
+
+        // a depth-first walk from `start`, done with an explicit stack
+        // so deep subgraphs can't run us out of call stack
+        template <class Compact, class Value>
+        void activation_spider(const Compact &s, const std::vector<Value> &totals,
+                               std::size_t start, int energy_hits, Value energy,
+                               Value decay, Value threshold,
+                               std::vector<Value> &rank, std::vector<bool> &seen,
+                               std::vector<activation_frame<Value> > &stack)
         {
             if (energy_hits == 0) return;
-            // don't even go there! *snap* -- only if we won't be modifying anything
-            
-            typename property_traits<RankMap>::value_type total = 0;
-            BGL_FORALL_OUTEDGES_T(u, e, g, Graph) total += get(w, e);
-            put(r, u, get(r, u) + energy * energy_hits);
-            
-            typename se_graph_traits<Graph>::out_edge_iterator ei, ei_end;
-            for(boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
-                if (!seen.count(*ei)) {
-                    seen.insert(*ei);
-                    // we haven't seen this vertex yet, spider it!
-                    activation_spider(g, target(*ei, g), w, r,
-                                      g[*ei].energy_hits, energy * (get(w, *ei) / total), seen);
+            rank[start] += energy * energy_hits;
+
+            stack.push_back(activation_frame<Value>(start, s.first_edge[start], energy));
+            while (!stack.empty()) {
+                activation_frame<Value> &f = stack.back();
+                if (f.edge == s.first_edge[f.vertex + 1]) {
+                    stack.pop_back();
+                    continue;
                 }
+
+                std::size_t e = f.edge++;
+                if (seen[e]) continue;
+
+                Value next = f.energy * (s.weights[e] / totals[f.vertex]);
+                if (decay != 1) next *= decay;
+
+                int hits = s.hits[e];
+                // too little to bother with; leave the edge for a
+                // stronger path to use
+                if (hits != 0 && next * hits < threshold) continue;
+
+                seen[e] = true;
+                if (hits == 0) continue;
+
+                // we haven't seen this edge yet, spider it!
+                std::size_t v = s.targets[e];
+                rank[v] += next * hits;
+                stack.push_back(activation_frame<Value>(v, s.first_edge[v], next));
             }
         }
     } // namespace detail
 
-    
-    template <class Graph, class NodeMap, class WeightMap, class RankMap>
-    void spreading_activation(Graph &g, NodeMap &n, WeightMap w, RankMap r)
+
+/* *******************************************************
+        SPREADING ACTIVATION
+
+        energy starts at the nodes in `n` (id => starting energy)
+        and spreads out along the out-edges depth first, each
+        vertex splitting what it gets between its out-edges by
+        weight.  every edge carries energy once, for whichever
+        path gets to it first.
+
+        each hop multiplies the energy by `decay`, and energy that
+        would arrive below `threshold` goes no further.  the
+        defaults (1 and 0) spread it for as long as there are
+        unused edges, as it always has.
+   ******************************************************* */
+    // over a compact_subgraph of g, leaving vertex i's rank in rank[i]
+    template <class Graph, class Value, class NodeMap>
+    void compact_spreading_activation(const compact_subgraph<Graph, Value> &c, Graph &g, NodeMap &n,
+                                      std::vector<Value> &rank, Value decay = 1, Value threshold = 0)
     {
-        typedef typename se_graph_traits<Graph>::vertex_iterator viterator;
-        typedef typename se_graph_traits<Graph>::out_edge_iterator eiterator;
         typedef typename se_graph_traits<Graph>::vertex_id_type id_type;
-        typedef typename se_graph_traits<Graph>::edge_descriptor edge_desc;
-    
-        BGL_FORALL_VERTICES_T(v, g, Graph) put(r, v, 0);
-    
-        // create the seen set
-        std::set<edge_desc> seen;
+        typedef typename se_graph_traits<Graph>::vertex_descriptor vertex_descriptor;
+
+        // the weight total of each vertex's out-edges
+        std::vector<Value> totals(c.size(), 0);
+        for (std::size_t u = 0; u < c.size(); ++u) {
+            for (std::size_t e = c.first_edge[u]; e < c.first_edge[u + 1]; ++e) totals[u] += c.weights[e];
+        }
+
+        rank.assign(c.size(), 0);
+        std::vector<bool> seen(c.num_edges(), false);
+        std::vector<detail::activation_frame<Value> > stack;
+
         // and our map of vertices
-        std::map<id_type, typename se_graph_traits<Graph>::vertex_descriptor> vertex_map;
-    
+        std::map<id_type, vertex_descriptor> vertex_map;
+
         // get those vertex descriptors from the graph
         g.vertices_by_id(extract_first_iterator(n.begin()),
                          extract_first_iterator(n.end()),
                          inserter(vertex_map, vertex_map.end()));
-    
-        
+
+
         for(typename NodeMap::iterator i = n.begin(); i != n.end(); ++i) {
             // id is i->first, starting energy is i->second
-            id_type id = (*i).first;
-            detail::activation_spider(g, vertex_map[id], w, r,
-                                      get_property(g, graph_energy_hits), (*i).second, seen);
+            typename std::map<id_type, vertex_descriptor>::iterator v = vertex_map.find((*i).first);
+            if (v == vertex_map.end()) continue;
+            std::size_t start = c.index_of(v->second);
+            if (start == c.size()) continue;
+
+            detail::activation_spider(c, totals, start, get_property(g, graph_energy_hits), (Value)(*i).second,
+                                      decay, threshold, rank, seen, stack);
         }
     }
+
+    // ranks into a map keyed on vertex descriptors, weighed by one keyed on edges
+    template <class Graph, class NodeMap, class WeightMap, class RankMap>
+    void spreading_activation(Graph &g, NodeMap &n, WeightMap w, RankMap r,
+                              typename property_traits<RankMap>::value_type decay = 1,
+                              typename property_traits<RankMap>::value_type threshold = 0)
+    {
+        typedef typename property_traits<RankMap>::value_type value_type;
+
+        compact_subgraph<Graph, value_type> c(g, w);
+        std::vector<value_type> rank;
+        compact_spreading_activation(c, g, n, rank, decay, threshold);
+
+        for (std::size_t i = 0; i < c.size(); ++i) put(r, c.descriptors[i], rank[i]);
+    }
 } // namespace semantic
 
 #endif /* _SPREADING_ACTIVATION_HPP_ */
@@ -2,15 +2,19 @@
 #define __SEMANTIC_SEARCH_HPP__
 
 #include <semantic/subgraph.hpp>
+#include <semantic/compact_subgraph.hpp>
 #include <semantic/utility.hpp>
 #include <semantic/query.hpp>
 #include <semantic/weighting/idf.hpp>
 #include <semantic/weighting/tf.hpp>
 #include <semantic/weighting/lg.hpp>
+#include <semantic/weighting/precomputed.hpp>
 #include <semantic/pruning.hpp>
 #include <semantic/subgraph/pruning_random_walk.hpp>
 #include <semantic/ranking/spreading_activation.hpp>
+#include <semantic/ranking/matrix_activation.hpp>
 #include <semantic/summarization.hpp>
+#include <semantic/search_cache.hpp>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/iteration_macros.hpp>
@@ -18,11 +22,41 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <sstream>
+#include <typeinfo>
 #include <iostream>
 
 
 namespace semantic {
 	
+	namespace detail {
+		template <class Vertex>
+		struct ranked_vertex {
+			ranked_vertex(double rank, std::size_t order, Vertex u) : rank(rank), order(order), u(u) {}
+			double rank;
+			std::size_t order;	// ties go to whichever came first
+			Vertex u;
+		};
+
+		template <class Vertex>
+		bool ranks_before(const ranked_vertex<Vertex> &a, const ranked_vertex<Vertex> &b) {
+			return a.rank > b.rank || (a.rank == b.rank && a.order < b.order);
+		}
+
+		// keeps the best k in a heap with the worst of them at the front
+		template <class Vertex>
+		void keep_top(std::vector<ranked_vertex<Vertex> > &heap, std::size_t k, const ranked_vertex<Vertex> &r) {
+			if (heap.size() < k) {
+				heap.push_back(r);
+				std::push_heap(heap.begin(), heap.end(), ranks_before<Vertex>);
+			} else if (k > 0 && ranks_before(r, heap.front())) {
+				std::pop_heap(heap.begin(), heap.end(), ranks_before<Vertex>);
+				heap.back() = r;
+				std::push_heap(heap.begin(), heap.end(), ranks_before<Vertex>);
+			}
+		}
+	} // namespace detail
 	
 	template<class Graph>
 	class search {
@@ -30,7 +64,8 @@ namespace semantic {
 		typedef std::vector<std::pair<std::string,double> > sorted_results;
 		typedef std::pair<sorted_results,sorted_results> search_results;
 		
-		search(Graph &g, const int unstem=1) : g(g) {
+		search(Graph &g, const int unstem=1) : g(g), activation_decay(1), activation_threshold(0), m_cache(NULL),
+				m_matrix(NULL), activation_steps(4), activation_stable_top(0), activation_threads(1) {
 			if( unstem == 1){
 				stemming = true;
 			} else {
@@ -62,16 +97,28 @@ namespace semantic {
  * 		Spreading activation search 
  * ************************************* */
 		search_results semantic(const std::string &q_string){
+			return semantic(q_string, all_results, all_results);
+		}
+
+		// the same, but only the best k_docs documents and k_terms terms are
+		// ranked in order and returned; the rest of the subgraph is skipped
+		search_results semantic(const std::string &q_string, std::size_t k_docs, std::size_t k_terms){
 			typedef se_graph_traits<Graph> traits;
 			
-			g.clear();
-			
 			// parse the query
 			search_query query(q_string, g);
-			std::vector<std::string> q_vector = query.tokenize();
+			std::string key = cache_key("semantic " + to_string(k_docs) + " " + to_string(k_terms), query.tokenize());
+			search_results results;
+			if( cached(key, results) ){
+				return results;
+			}
+			
+			g.clear();
 			typename std::vector<typename traits::vertex_id_type> ids = query.get_vertex_ids(g);
 			
-			return do_search(ids);
+			results = do_search(ids, k_docs, k_terms);
+			remember(key, results);
+			return results;
 		}
 		
 /* ************************************* *
@@ -81,10 +128,15 @@ namespace semantic {
 			typedef se_graph_traits<Graph> traits;
 						
 			// parse the query
-			g.clear();
 			search_query query(q_string, g);
 			query.set_stemming(stemming);
-			std::vector<std::string> q_vector = query.tokenize();
+			std::string key = cache_key(stemming ? "keyword stemmed" : "keyword", query.tokenize());
+			search_results results;
+			if( cached(key, results) ){
+				return results;
+			}
+			
+			g.clear();
 			typename std::vector<typename traits::vertex_id_type> ids = query.get_vertex_ids(g);
 			g.expand_vertices(ids.begin(), ids.end());
 			
@@ -98,7 +150,9 @@ namespace semantic {
 				nodes[*pos] = (double)pow((double)10,10); // starting energy on search
 			}
 			
-			return do_ranking(nodes);
+			results = do_ranking(nodes);
+			remember(key, results);
+			return results;
 		}
 		
 		search_results do_better_search(const std::string &q_string){
@@ -106,11 +160,16 @@ namespace semantic {
 			typedef typename traits::vertex_descriptor Vertex;
 			typedef std::vector<typename traits::vertex_id_type> vertices;
 			typedef typename traits::vertex_properties_type vertex_properties;
-			g.clear();
 			
 			// process the query
 			search_query query(q_string, g);
-			std::vector<std::string> q_vector = query.tokenize();
+			std::string key = cache_key("better", query.tokenize());
+			search_results results;
+			if( cached(key, results) ){
+				return results;
+			}
+			
+			g.clear();
 			vertices ids = query.get_vertex_ids(g);
 				
 			// expand vertices for each term node and populate the 'intersection' map
@@ -141,7 +200,9 @@ namespace semantic {
 				}
 			}
 
-			return do_search(search_nodes);
+			results = do_search(search_nodes);
+			remember(key, results);
+			return results;
 		}
 		
 /* ************************************* *
@@ -170,11 +231,58 @@ namespace semantic {
 		}
 		
 
+		// spreading activation cutoff: energy is multiplied by `decay` on each
+		// hop and isn't spread once it falls below `threshold`.  the defaults
+		// (1 and 0) spread it through the whole subgraph.
+		void set_activation_decay(double decay){ activation_decay = decay; }
+		double get_activation_decay() const { return activation_decay; }
+		void set_activation_threshold(double threshold){ activation_threshold = threshold; }
+		double get_activation_threshold() const { return activation_threshold; }
+
+		// share a result cache with other searches (NULL for none, the default).
+		// a search answered from the cache doesn't touch the graph, and
+		// get_weight_map() comes back empty after one.
+		void set_cache(search_cache *cache){ m_cache = cache; }
+		search_cache *get_cache() const { return m_cache; }
+
+		// rank semantic(), do_better_search() and similar() over the whole
+		// collection with a (shareable) activation_matrix instead of over a
+		// sampled subgraph; NULL, the default, goes back to the subgraph.  the
+		// matrix is built the first time it's used and again after the
+		// collection changes.  get_weight_map() comes back empty after one.
+		void set_activation_matrix(activation_matrix<Graph> *matrix){ m_matrix = matrix; }
+		activation_matrix<Graph> *get_activation_matrix() const { return m_matrix; }
+
+		// for the matrix: how many hops the energy spreads (4, like the
+		// subgraph's depth), stopping sooner once the best `k` documents
+		// come out the same two steps running (0, the default, never does),
+		// with the work split between `threads` threads
+		void set_activation_steps(unsigned int steps){ activation_steps = steps; }
+		unsigned int get_activation_steps() const { return activation_steps; }
+		void set_activation_stable_top(std::size_t k){ activation_stable_top = k; }
+		std::size_t get_activation_stable_top() const { return activation_stable_top; }
+		void set_activation_threads(unsigned int threads){ activation_threads = threads > 0 ? threads : 1; }
+		unsigned int get_activation_threads() const { return activation_threads; }
+
+		// the weights and ranks of the last subgraph search, copied into maps
 		std::pair<typename weighting_traits<Graph>::edge_weight_map,
 					typename weighting_traits<Graph>::vertex_weight_map> get_weight_map(){
-			return std::make_pair(m_edge_weights, m_rank_map);
+			typename wtraits::edge_weight_map weights;
+			typename wtraits::vertex_weight_map ranks;
+			for( std::size_t e = 0; e < m_compact.num_edges(); ++e ){
+				weights[m_compact.edges[e]] = m_compact.weights[e];
+			}
+			for( std::size_t i = 0; i < m_compact.size() && i < m_ranks.size(); ++i ){
+				ranks[m_compact.descriptors[i]] = m_ranks[i];
+			}
+			return std::make_pair(weights, ranks);
 		}
 
+		// the same, as they were left: the subgraph with its weights in
+		// compact form, and the rank of its vertex i in get_ranks()[i]
+		const compact_subgraph<Graph> &get_compact_subgraph() const { return m_compact; }
+		const std::vector<typename weighting_traits<Graph>::weight_type> &get_ranks() const { return m_ranks; }
+
 /* ************************************ *
  * 		Get summary terms
  * ************************************ */
@@ -241,18 +349,85 @@ namespace semantic {
 		private:
 			Graph &g;
 			bool stemming;
+			double activation_decay, activation_threshold;
+			search_cache *m_cache;
+			std::string m_cache_version;
+			activation_matrix<Graph> *m_matrix;
+			unsigned int activation_steps;
+			std::size_t activation_stable_top;
+			unsigned int activation_threads;
 			std::map<std::string,double> stemmed_terms;
-			typedef std::multimap<double,std::string,std::greater<double> > m_sorted_results;
+			static const std::size_t all_results = (std::size_t)-1;
 			typedef weighting_traits<Graph> wtraits;
 			
-			typename weighting_traits<Graph>::edge_weight_map m_edge_weights;
-			typename weighting_traits<Graph>::vertex_weight_map m_rank_map;
+			compact_subgraph<Graph> m_compact;
+			std::vector<typename wtraits::weight_type> m_ranks;
 				
 
+/* ******************************** *
+ * 		Result cache
+ * ******************************** */
+			// everything that goes into a result: the kind of search, the
+			// collection, the graph type (which names the weighting policy),
+			// the subgraph or matrix settings, the activation cutoff, and the
+			// query terms in sorted order
+			std::string cache_key(const std::string &kind, std::vector<std::string> terms){
+				std::sort(terms.begin(), terms.end());
+				std::stringstream key;
+				key << kind << "\n" << g.collection() << "\n" << typeid(Graph).name() << "\n";
+				if( m_matrix ){
+					key << "matrix steps=" << activation_steps << " stable=" << activation_stable_top;
+				} else {
+					key << g.subgraph_parameters();
+				}
+				key << "\n" << activation_decay << " " << activation_threshold;
+				for( std::vector<std::string>::iterator t = terms.begin(); t != terms.end(); ++t ){
+					key << "\n" << *t;
+				}
+				return key.str();
+			}
+			
+			void forget_ranking(){
+				compact_subgraph<Graph>().swap(m_compact);
+				m_ranks.clear();
+			}
+			
+			bool cached(const std::string &key, search_results &results){
+				if( !m_cache ){
+					return false;
+				}
+				m_cache_version = g.get_collection_version();
+				search_cache::entry e;
+				if( !m_cache->find(key, m_cache_version, e) ){
+					return false;
+				}
+				results = e.results;
+				stemmed_terms = e.stemmed_terms;
+				forget_ranking();
+				return true;
+			}
+			
+			// filed under the collection version from before we searched, so a
+			// commit that lands in the middle makes the entry stale straight away
+			void remember(const std::string &key, const search_results &results){
+				if( !m_cache ){
+					return;
+				}
+				search_cache::entry e;
+				e.results = results;
+				e.stemmed_terms = stemmed_terms;
+				m_cache->insert(key, m_cache_version, e);
+			}
+
 /* ******************************** *
  * 		Do the actual searching 
  * ******************************** */
 			search_results do_search(const std::vector<typename se_graph_traits<Graph>::vertex_id_type> &ids){
+				return do_search(ids, all_results, all_results);
+			}
+
+			search_results do_search(const std::vector<typename se_graph_traits<Graph>::vertex_id_type> &ids,
+									 std::size_t k_docs, std::size_t k_terms){
 				typedef se_graph_traits<Graph> traits;
 				
 				// set the node list
@@ -262,60 +437,145 @@ namespace semantic {
 				for( pos = ids.begin(); pos != ids.end(); ++pos){
 					nodes[*pos] = pow((double)10,10); // starting energy on search
 				}
+				if( m_matrix ){
+					return do_matrix_ranking(nodes, k_docs, k_terms);
+				}
 				try {
 					g.fetch_subgraph_starting_from( ids.begin(), ids.end() );
 				} catch ( std::exception &e ){
 					std::cout << "Vertex not found: " << e.what() << std::endl;
 				}
-				return do_ranking(nodes);
+				return do_ranking(nodes, k_docs, k_terms);
 			}
 			
 			
 			search_results do_ranking(std::map<unsigned long, double> &nodes) {
+				return do_ranking(nodes, all_results, all_results);
+			}
+
+			search_results do_ranking(std::map<unsigned long, double> &nodes, std::size_t k_docs, std::size_t k_terms) {
 				typedef se_graph_traits<Graph> traits;
-				typename wtraits::vertex_weight_map rank_map;
-				typename wtraits::edge_weight_map weights;
+				typedef typename traits::vertex_descriptor Vertex;
+				typedef detail::ranked_vertex<Vertex> ranked;
+				typedef typename wtraits::weight_type weight_type;
 
-				g.populate_weight_map(boost::make_assoc_property_map(weights));
-				spreading_activation(g, nodes, boost::make_assoc_property_map(weights), boost::make_assoc_property_map(rank_map));
+				// weighed and ranked over arrays
+				compact_subgraph<Graph> c(g);
+				std::vector<weight_type> rank;
+				compact_spreading_activation(c, g, nodes, rank, (weight_type)activation_decay, (weight_type)activation_threshold);
 
-				// output le rankmap
-			
-				m_sorted_results ranked_docs, ranked_terms;
-			
-				BGL_FORALL_VERTICES_T(u, g, Graph) {
+				// keep the k best of each kind as we go: the heaps have the
+				// worst of the ones we're keeping on top
+				std::vector<ranked> top_docs, top_terms;
+				for( std::size_t n = 0; n < c.size(); ++n ){
+					Vertex u = c.descriptors[n];
+					ranked r(rank[n], n, u);
 					if (g[u].type_major == node_type_major_doc){
-						ranked_docs.insert(std::make_pair(rank_map[u],g[u].content));
+						detail::keep_top(top_docs, k_docs, r);
 					} else {
-						ranked_terms.insert(std::make_pair(rank_map[u],g[u].content));
+						detail::keep_top(top_terms, k_terms, r);
 					}
 				}
-			    m_edge_weights = weights;
-				m_rank_map = rank_map;
+				std::sort_heap(top_docs.begin(), top_docs.end(), detail::ranks_before<Vertex>);
+				std::sort_heap(top_terms.begin(), top_terms.end(), detail::ranks_before<Vertex>);
+
+				m_compact.swap(c);
+				m_ranks.swap(rank);
 				
-				m_sorted_results::iterator mpos;
 				sorted_results docs_list, terms_list;
 				stemmed_terms.clear();
 								
-				for( mpos = ranked_docs.begin(); mpos != ranked_docs.end(); ++mpos){
-					double relevance = 1 + 10 * log10(1+mpos->first);
-					if(relevance>100)
-						relevance--;
-					docs_list.push_back(std::make_pair(mpos->second,relevance));
+				for( typename std::vector<ranked>::iterator r = top_docs.begin(); r != top_docs.end(); ++r){
+					docs_list.push_back(std::make_pair(g[r->u].content,relevance(r->rank)));
 				}
-				for( mpos = ranked_terms.begin(); mpos != ranked_terms.end(); ++mpos){
-					double relevance = 1 + 10 * log10(1+mpos->first);
-					if(relevance>100)
-						relevance--;
-					
-					stemmed_terms.insert(std::make_pair(mpos->second,relevance));
-					std::string unstemmed = g.unstem_term(mpos->second);
-					terms_list.push_back(std::make_pair(unstemmed,relevance));
+
+				// only the terms we're returning get unstemmed, all in one go
+				std::vector<Vertex> term_vertices;
+				for( typename std::vector<ranked>::iterator r = top_terms.begin(); r != top_terms.end(); ++r){
+					term_vertices.push_back(r->u);
+				}
+				std::map<Vertex, std::string> unstemmed;
+				g.unstem_terms(term_vertices.begin(), term_vertices.end(), inserter(unstemmed, unstemmed.end()));
+
+				for( typename std::vector<ranked>::iterator r = top_terms.begin(); r != top_terms.end(); ++r){
+					double rel = relevance(r->rank);
+					stemmed_terms.insert(std::make_pair(g[r->u].content,rel));
+					typename std::map<Vertex, std::string>::iterator t = unstemmed.find(r->u);
+					terms_list.push_back(std::make_pair(t != unstemmed.end() ? t->second : g[r->u].content,rel));
 				}
 			
 				return std::make_pair(docs_list, terms_list);
 			}
 
+			// the same over the whole collection, from the activation matrix
+			search_results do_matrix_ranking(std::map<unsigned long, double> &nodes, std::size_t k_docs, std::size_t k_terms) {
+				typedef se_graph_traits<Graph> traits;
+				typedef typename traits::vertex_descriptor Vertex;
+				typedef typename traits::vertex_id_type id_type;
+				typedef typename activation_matrix<Graph>::matrix_type matrix_type;
+				typedef typename matrix_type::index_type index_type;
+				typedef detail::ranked_vertex<index_type> ranked;
+
+				typename activation_matrix<Graph>::pointer m = m_matrix->current(g);
+				std::vector<double> rank;
+				std::vector<index_type> reached;
+				matrix_activation(*m, nodes, rank, reached, activation_steps, activation_decay, activation_threshold,
+								  activation_stable_top, activation_threads);
+
+				std::vector<ranked> top_docs, top_terms;
+				for( std::size_t n = 0; n < reached.size(); ++n ){
+					index_type i = reached[n];
+					ranked r(rank[i], n, i);
+					if (m->types[i] == node_type_major_doc){
+						detail::keep_top(top_docs, k_docs, r);
+					} else {
+						detail::keep_top(top_terms, k_terms, r);
+					}
+				}
+				std::sort_heap(top_docs.begin(), top_docs.end(), detail::ranks_before<index_type>);
+				std::sort_heap(top_terms.begin(), top_terms.end(), detail::ranks_before<index_type>);
+
+				forget_ranking();
+
+				sorted_results docs_list, terms_list;
+				stemmed_terms.clear();
+
+				for( typename std::vector<ranked>::iterator r = top_docs.begin(); r != top_docs.end(); ++r){
+					docs_list.push_back(std::make_pair(m->contents[r->u],relevance(r->rank)));
+				}
+
+				// the terms we're returning go into the graph to be unstemmed
+				std::vector<id_type> term_ids;
+				for( typename std::vector<ranked>::iterator r = top_terms.begin(); r != top_terms.end(); ++r){
+					term_ids.push_back(m->ids[r->u]);
+				}
+				std::map<id_type, Vertex> vertex_map;
+				g.vertices_by_id(term_ids.begin(), term_ids.end(), inserter(vertex_map, vertex_map.end()));
+				std::vector<Vertex> term_vertices;
+				for( typename std::vector<id_type>::iterator t = term_ids.begin(); t != term_ids.end(); ++t){
+					term_vertices.push_back(vertex_map[*t]);
+				}
+				std::map<Vertex, std::string> unstemmed;
+				g.unstem_terms(term_vertices.begin(), term_vertices.end(), inserter(unstemmed, unstemmed.end()));
+
+				for( std::size_t t = 0; t < top_terms.size(); ++t){
+					const std::string &content = m->contents[top_terms[t].u];
+					double rel = relevance(top_terms[t].rank);
+					stemmed_terms.insert(std::make_pair(content,rel));
+					typename std::map<Vertex, std::string>::iterator u = unstemmed.find(term_vertices[t]);
+					terms_list.push_back(std::make_pair(u != unstemmed.end() ? u->second : content,rel));
+				}
+
+				return std::make_pair(docs_list, terms_list);
+			}
+
+			static double relevance(double rank){
+				double relevance = 1 + 10 * log10(1+rank);
+				if(relevance>100)
+					relevance--;
+				return relevance;
+			}
+
 
 			
 	}; // class search
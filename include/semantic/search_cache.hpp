@@ -0,0 +1,178 @@
+/*
+a least-recently-used cache of search results that any number of search
+objects (and threads) can share.
+
+results are filed under a key that search builds from everything that goes
+into them: the collection, the kind of search, the stemmed query terms and
+the graph's subgraph and weighting policies.  each entry also remembers the
+version of the collection it was computed against (see the storage
+policies' get_collection_version()); once changes are committed to the
+collection the version moves on and the old entries are thrown away the
+next time they're looked up.
+
+the cache is locked with a mutex when the Boost thread library was found
+at configure time, and is for single threaded use otherwise.
+*/
+
+#ifndef __SEMANTIC_SEARCH_CACHE_HPP__
+#define __SEMANTIC_SEARCH_CACHE_HPP__
+
+#include <semantic/config.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/utility.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <utility>
+#include <cstddef>
+
+namespace semantic {
+
+	class search_cache : boost::noncopyable {
+		public:
+			typedef std::vector<std::pair<std::string,double> > sorted_results;
+			typedef std::pair<sorted_results,sorted_results> search_results;
+
+			// what a search leaves behind: the ranked documents and terms, and
+			// the stemmed terms that summarizing uses
+			struct entry {
+				search_results results;
+				std::map<std::string,double> stemmed_terms;
+			};
+
+			explicit search_cache(std::size_t capacity = 1000)
+				: m_capacity(capacity), m_hits(0), m_misses(0) {}
+
+			// copies the entry for key into e, if there is one computed against
+			// this version of the collection
+			bool find(const std::string &key, const std::string &version, entry &e) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				index_type::iterator i = m_index.find(key);
+				if (i == m_index.end()) {
+					m_misses++;
+					return false;
+				}
+				if (i->second->version != version) {
+					// the collection has changed since
+					m_entries.erase(i->second);
+					m_index.erase(i);
+					m_misses++;
+					return false;
+				}
+
+				// most recently used goes to the front
+				m_entries.splice(m_entries.begin(), m_entries, i->second);
+				e = i->second->value;
+				m_hits++;
+				return true;
+			}
+
+			void insert(const std::string &key, const std::string &version, const entry &e) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				if (m_capacity == 0) return;
+
+				index_type::iterator i = m_index.find(key);
+				if (i != m_index.end()) {
+					m_entries.erase(i->second);
+					m_index.erase(i);
+				}
+
+				m_entries.push_front(item());
+				m_entries.front().key = key;
+				m_entries.front().version = version;
+				m_entries.front().value = e;
+				m_index.insert(std::make_pair(key, m_entries.begin()));
+
+				trim();
+			}
+
+			void clear() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_entries.clear();
+				m_index.clear();
+			}
+
+			void set_capacity(std::size_t capacity) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_capacity = capacity;
+				trim();
+			}
+
+			std::size_t get_capacity() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_capacity;
+			}
+
+			std::size_t size() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_index.size();
+			}
+
+			// lookups that found a current entry, and ones that didn't
+			unsigned long hits() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_hits;
+			}
+
+			unsigned long misses() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_misses;
+			}
+
+			void reset_counters() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				m_hits = m_misses = 0;
+			}
+
+		private:
+			struct item {
+				std::string key;
+				std::string version;
+				entry value;
+			};
+			typedef std::list<item> list_type;
+			typedef std::map<std::string, list_type::iterator> index_type;
+
+			list_type m_entries;	// most recently used first
+			index_type m_index;
+			std::size_t m_capacity;
+			unsigned long m_hits, m_misses;
+#if SEMANTIC_HAVE_BOOST_THREAD
+			boost::mutex m_mutex;
+#endif
+
+			// drop the least recently used entries until we fit (lock held)
+			void trim() {
+				while (m_index.size() > m_capacity) {
+					m_index.erase(m_entries.back().key);
+					m_entries.pop_back();
+				}
+			}
+	};
+
+} // namespace semantic
+
+#endif
@@ -46,10 +46,10 @@ namespace stemming
 			trim_western_punctuation(text);
 
 			//Hash initial y, y after a vowel, and i between vowels
-			hash_dutch_yi(text, DUTCH_VOWELS);
+			hash_dutch_yi(text, dutch_vowels());
 
-			find_r1(text, DUTCH_VOWELS);
-			find_r2(text, DUTCH_VOWELS);
+			find_r1(text, dutch_vowels());
+			find_r2(text, dutch_vowels());
 			//R1 must have at least 3 characters in front of it
 			if (m_r1 < 3)
 				{
@@ -66,6 +66,10 @@ namespace stemming
 			unhash_dutch_yi(text);
 			}
 	private:
+		static const xchar* dutch_vowels()
+			{ return _XTEXT("aeiouy\xE8" "AEIOUY\xC8"); }
+		static const xchar* dutch_kdt()
+			{ return _XTEXT("kdtKDT"); }
 		/**Step 1:
 		Search for the longest among the following suffixes, and perform the action indicated: 
 
@@ -94,7 +98,7 @@ namespace stemming
 			else if (is_suffix(text,/*ene*/LOWER_E, UPPER_E, LOWER_N, UPPER_N, LOWER_E, UPPER_E)	)
 				{
 				if (m_r1 <= text.length()-3 &&
-					!string_util::is_one_of(text[text.length()-4], DUTCH_VOWELS) &&
+					!string_util::is_one_of(text[text.length()-4], dutch_vowels()) &&
 					(text.length() < 6 ||
 					//"gem" in front of "en" ending
 					!(is_either(text[text.length()-6], LOWER_G, UPPER_G) &&
@@ -103,7 +107,7 @@ namespace stemming
 					{
 					text.erase(text.end()-3, text.end() );
 					//undouble dd, kk, tt
-					if (string_util::is_one_of(text[text.length()-1], DUTCH_KDT) &&
+					if (string_util::is_one_of(text[text.length()-1], dutch_kdt()) &&
 						string_util::tolower_western(text[text.length()-2]) == string_util::tolower_western(text[text.length()-1]))
 						{
 						text.erase(text.end()-1, text.end() );
@@ -115,7 +119,7 @@ namespace stemming
 			else if (is_suffix(text,/*en*/LOWER_E, UPPER_E, LOWER_N, UPPER_N) )
 				{
 				if (m_r1 <= text.length()-2 &&
-					!string_util::is_one_of(text[text.length()-3], DUTCH_VOWELS) &&
+					!string_util::is_one_of(text[text.length()-3], dutch_vowels()) &&
 					(text.length() < 5 ||
 					!(is_either(text[text.length()-5], LOWER_G, UPPER_G) &&
 					is_either(text[text.length()-4], LOWER_E, UPPER_E) &&
@@ -123,7 +127,7 @@ namespace stemming
 					{
 					text.erase(text.end()-2, text.end() );
 					//undouble dd, kk, tt
-					if (string_util::is_one_of(text[text.length()-1], DUTCH_KDT) &&
+					if (string_util::is_one_of(text[text.length()-1], dutch_kdt()) &&
 						string_util::tolower_western(text[text.length()-2]) == string_util::tolower_western(text[text.length()-1]) )
 						{
 						text.erase(text.end()-1, text.end() );
@@ -163,11 +167,11 @@ namespace stemming
 			if (is_suffix(text, LOWER_E, UPPER_E) )
 				{
 				if (m_r1 <= text.length()-1 &&
-					!string_util::is_one_of(text[text.length()-2], DUTCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-2], dutch_vowels()) )
 					{
 					//watch out for vowel I/Y vowel
 					if (string_util::is_one_of(text[text.length()-2], _XTEXT("iyIY")) &&
-						string_util::is_one_of(text[text.length()-3], DUTCH_VOWELS) )
+						string_util::is_one_of(text[text.length()-3], dutch_vowels()) )
 						{
 						return;
 						}
@@ -175,7 +179,7 @@ namespace stemming
 						{
 						text.erase(text.end()-1, text.end() );
 						//undouble dd, kk, tt
-						if (string_util::is_one_of(text[text.length()-1], DUTCH_KDT) &&
+						if (string_util::is_one_of(text[text.length()-1], dutch_kdt()) &&
 							string_util::tolower_western(text[text.length()-2]) == string_util::tolower_western(text[text.length()-1]))
 							{
 							text.erase(text.end()-1, text.end() );
@@ -202,9 +206,9 @@ namespace stemming
 					if (m_r1 <= text.length()-2 &&
 						is_suffix(text, LOWER_E, UPPER_E, LOWER_N, UPPER_N) )
 						{
-						if ((!string_util::is_one_of(text[text.length()-3], DUTCH_VOWELS) ||
+						if ((!string_util::is_one_of(text[text.length()-3], dutch_vowels()) ||
 							(string_util::is_one_of(text[text.length()-3], _XTEXT("iyYI")) &&
-							string_util::is_one_of(text[text.length()-4], DUTCH_VOWELS))) &&
+							string_util::is_one_of(text[text.length()-4], dutch_vowels()))) &&
 							(text.length() < 5 ||
 							!(is_either(text[text.length()-5], LOWER_G, UPPER_G) &&
 							is_either(text[text.length()-4], LOWER_E, UPPER_E) &&
@@ -212,7 +216,7 @@ namespace stemming
 							{
 							text.erase(text.end()-2, text.end() );
 							//undouble dd, kk, tt
-							if (string_util::is_one_of(text[text.length()-1], DUTCH_KDT) &&
+							if (string_util::is_one_of(text[text.length()-1], dutch_kdt()) &&
 								string_util::tolower_western(text[text.length()-2]) == string_util::tolower_western(text[text.length()-1]))
 								{
 								text.erase(text.end()-1, text.end() );
@@ -259,7 +263,7 @@ namespace stemming
 						}
 					else
 						{
-						if (string_util::is_one_of(text[text.length()-1], DUTCH_KDT) &&
+						if (string_util::is_one_of(text[text.length()-1], dutch_kdt()) &&
 							string_util::tolower_western(text[text.length()-2]) == string_util::tolower_western(text[text.length()-1]))
 							{
 							text.erase(text.end()-1, text.end() );
@@ -300,8 +304,8 @@ namespace stemming
 			{
 			//undouble consecutive (same) consonants
 			if (text.length() >= 4 &&
-				!string_util::is_one_of(text[text.length()-4], DUTCH_VOWELS) &&
-				!string_util::is_one_of(text[text.length()-1], DUTCH_VOWELS) &&
+				!string_util::is_one_of(text[text.length()-4], dutch_vowels()) &&
+				!string_util::is_one_of(text[text.length()-1], dutch_vowels()) &&
 				text[text.length()-1] != LOWER_I_HASH &&
 				text[text.length()-1] != UPPER_I_HASH &&
 				string_util::is_one_of(text[text.length()-2], _XTEXT("aeouAEOU")) &&
@@ -1056,7 +1056,7 @@ namespace stemming
                     //following letter
                     (!is_vowel(text[start+1]) &&
 					!string_util::is_one_of(text[start+1], _XTEXT("wxWX")) &&
-					is_neither((unsigned char)text[start+1], LOWER_Y_HASH, UPPER_Y_HASH)) &&
+					is_neither(text[start+1], LOWER_Y_HASH, UPPER_Y_HASH)) &&
                     //proceeding letter
                     !is_vowel(text[start-1]) )
 					{
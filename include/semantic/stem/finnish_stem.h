@@ -60,8 +60,8 @@ namespace stemming
 
 			trim_western_punctuation(text);
 
-			find_r1(text, FINNISH_VOWELS);
-			find_r2(text, FINNISH_VOWELS);
+			find_r1(text, finnish_vowels());
+			find_r2(text, finnish_vowels());
 
 			step_1(text);
 			step_2(text);
@@ -71,6 +71,8 @@ namespace stemming
 			step_6(text);
 			}
 	private:
+		static const xchar* finnish_vowels()
+			{ return _XTEXT("aeiouy\xE4\xF6" "AEIOUY\xC4\xD6"); }
 		/**Step 1: particles etc 
 		Search for the longest among the following suffixes in R1, and perform the action indicated 
 
@@ -320,8 +322,8 @@ namespace stemming
 				}
 			//suffix followed by cv
 			else if ((is_suffix_in_r1(text, LOWER_A, UPPER_A) || is_suffix_in_r1(text, LOWER_A_UMLAUTS, UPPER_A_UMLAUTS) )&&
-					!string_util::is_one_of(text[text.length()-3], FINNISH_VOWELS) &&
-					string_util::is_one_of(text[text.length()-2], FINNISH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-3], finnish_vowels()) &&
+					string_util::is_one_of(text[text.length()-2], finnish_vowels()) )
 				{
 				text.erase(text.end()-1, text.end() );
 				update_r_sections(text);
@@ -401,7 +403,7 @@ namespace stemming
 				}
 			else
 				{
-				if (string_util::is_one_of(text[text.length()-2], FINNISH_VOWELS) )
+				if (string_util::is_one_of(text[text.length()-2], finnish_vowels()) )
 					{
 					if (delete_if_is_in_r1(text, LOWER_T, UPPER_T) )
 						{
@@ -448,7 +450,7 @@ namespace stemming
 		void step_6b(std::basic_string<xchar>& text)
 			{
 			if (m_r1 <= text.length()-2 &&
-				!string_util::is_one_of(text[text.length()-2], FINNISH_VOWELS) &&
+				!string_util::is_one_of(text[text.length()-2], finnish_vowels()) &&
 				string_util::is_one_of(text[text.length()-1], _XTEXT("aeiAEI")) )
 				{
 				text.erase(text.end()-1);
@@ -483,7 +485,7 @@ namespace stemming
 		void step_6e(std::basic_string<xchar>& text)
 			{
 			//find the last consonant
-			size_t index = text.find_last_not_of(FINNISH_VOWELS);
+			size_t index = text.find_last_not_of(finnish_vowels());
 			if (index == std::basic_string<xchar>::npos ||
 				index < 1)
 				{
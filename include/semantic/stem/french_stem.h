@@ -45,11 +45,11 @@ namespace stemming
 			m_r1 = m_r2 = m_rv =0;
 
 			trim_western_punctuation(text);
-			hash_french_yui(text, FRENCH_VOWELS);
+			hash_french_yui(text, french_vowels());
 
-			find_r1(text, FRENCH_VOWELS);
-			find_r2(text, FRENCH_VOWELS);
-			find_french_rv(text, FRENCH_VOWELS);
+			find_r1(text, french_vowels());
+			find_r2(text, french_vowels());
+			find_french_rv(text, french_vowels());
 
 			size_t length = text.length();
 			step_1(text);
@@ -71,6 +71,8 @@ namespace stemming
 			unhash_french_yui(text);
 			}
 	private:
+		static const xchar* french_vowels()
+			{ return _XTEXT("aeiouy\xE2\xE0\xEB\xE9\xEA\xE8\xEF\xEE\xF4\xFB\xF9" "AEIOUY\xC2\xC0\xCB\xC9\xCA\xC8\xCF\xCE\xD4\xDB\xD9"); }
 		bool ic_to_iqu(std::basic_string<xchar>& text)
 			{
 			if (is_suffix(text,/*ic*/LOWER_I, UPPER_I, LOWER_C, UPPER_C) )
@@ -87,8 +89,8 @@ namespace stemming
 					text += _XTEXT("iq");
 					text += LOWER_U_HASH;
 					//need to search for r2 again because the 'iq' added here may change that
-					find_r2(text, FRENCH_VOWELS);
-			        find_french_rv(text, FRENCH_VOWELS);
+					find_r2(text, french_vowels());
+			        find_french_rv(text, french_vowels());
 					return true;
 					}
 				}
@@ -156,7 +158,7 @@ namespace stemming
 			if (is_suffix(text,/*issements*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E, LOWER_M, UPPER_M, LOWER_E, UPPER_E, LOWER_N, UPPER_N, LOWER_T, UPPER_T, LOWER_S, UPPER_S) )
 				{
 				if (m_r1 <= static_cast<unsigned int>(text.length()-9) &&
-					!string_util::is_one_of(text[text.length()-10], FRENCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-10], french_vowels()) )
 					{
 					text.erase(text.end()-9, text.end() );
 					m_step_1_successful = true;
@@ -166,7 +168,7 @@ namespace stemming
 			else if (is_suffix(text,/*issement*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E, LOWER_M, UPPER_M, LOWER_E, UPPER_E, LOWER_N, UPPER_N, LOWER_T, UPPER_T) )
 				{
 				if (m_r1 <= static_cast<unsigned int>(text.length()-8) &&
-					!string_util::is_one_of(text[text.length()-9], FRENCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-9], french_vowels()) )
 					{
 					text.erase(text.end()-8, text.end() );
 					m_step_1_successful = true;
@@ -272,7 +274,7 @@ namespace stemming
 					text.erase(text.end()-2, text.end() );
 					update_r_sections(text);
 					}
-				else if (m_r2 <= static_cast<int>(text.length()-3) &&
+				else if (m_r2 <= text.length()-3 &&
 					(text[text.length()-2] == '' || text[text.length()-2] == '') &&
 					(text[text.length()-1] == LOWER_R || text[text.length()-1] == UPPER_R) &&
 					is_either(text[text.length()-3], LOWER_I_HASH, UPPER_I_HASH) )
@@ -395,7 +397,7 @@ namespace stemming
 					text.erase(text.end()-2, text.end() );
 					update_r_sections(text);
 					}
-				else if (m_rv <= static_cast<int>(text.length()-3) &&
+				else if (m_rv <= text.length()-3 &&
 					(text[text.length()-2] == '' || text[text.length()-2] == '') &&
 					(text[text.length()-1] == LOWER_R || text[text.length()-1] == UPPER_R) &&
 					is_either(text[text.length()-3], LOWER_I_HASH, UPPER_I_HASH) )
@@ -412,7 +414,7 @@ namespace stemming
 				{
 				//the proceeding vowel must also be n RV
 				if (m_rv <= text.length()-6 &&
-					string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+					string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					update_r_sections(text);	
@@ -452,7 +454,7 @@ namespace stemming
 				{
 				//the proceeding vowel must also be n RV
 				if (m_rv <= text.length()-5 &&
-					string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+					string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					update_r_sections(text);	
@@ -531,8 +533,8 @@ namespace stemming
 						text += _XTEXT("iq");
 						text += LOWER_U_HASH;
 						//need to search for r2 again because the 'iq' added here may change that
-					    find_r2(text, FRENCH_VOWELS);
-			            find_french_rv(text, FRENCH_VOWELS);
+					    find_r2(text, french_vowels());
+			            find_french_rv(text, french_vowels());
 						}
 					}
 				else
@@ -585,8 +587,8 @@ namespace stemming
 						text += _XTEXT("iq");
 						text += LOWER_U_HASH;
 						//need to search for r2 again because the 'iq' added here may change that
-					    find_r2(text, FRENCH_VOWELS);
-			            find_french_rv(text, FRENCH_VOWELS);
+					    find_r2(text, french_vowels());
+			            find_french_rv(text, french_vowels());
 						}
 					}
 				else
@@ -657,7 +659,7 @@ namespace stemming
 		//---------------------------------------------
 		void step_2a(std::basic_string<xchar>& text)
 			{
-			if (m_rv <= static_cast<int>(text.length()-8) &&
+			if (m_rv <= text.length()-8 &&
 				(text[text.length()-8] == LOWER_I || text[text.length()-8] == UPPER_I) &&
 				(text[text.length()-7] == LOWER_S || text[text.length()-7] == UPPER_S) &&
 				(text[text.length()-6] == LOWER_S || text[text.length()-6] == UPPER_S) &&
@@ -667,8 +669,8 @@ namespace stemming
 				(text[text.length()-1] == LOWER_T || text[text.length()-1] == UPPER_T) &&
 				is_either(text[text.length()-4], LOWER_I_HASH, UPPER_I_HASH) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-9], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-9], french_vowels()) )
 					{
 					text.erase(text.end()-8, text.end() );
 					return;
@@ -676,14 +678,14 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issantes*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_N, UPPER_N, LOWER_T, UPPER_T, LOWER_E, UPPER_E, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-9) &&
-					!string_util::is_one_of(text[text.length()-9], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-9 &&
+					!string_util::is_one_of(text[text.length()-9], french_vowels()) )
 					{
 					text.erase(text.end()-8, text.end() );
 					return;
 					}
 				}
-			else if (m_rv <= static_cast<int>(text.length()-7) &&
+			else if (m_rv <= text.length()-7 &&
 				(text[text.length()-7] == LOWER_I || text[text.length()-7] == UPPER_I) &&
 				(text[text.length()-6] == LOWER_R || text[text.length()-6] == UPPER_R) &&
 				(text[text.length()-5] == LOWER_A || text[text.length()-5] == UPPER_A) &&
@@ -692,8 +694,8 @@ namespace stemming
 				(text[text.length()-1] == LOWER_T || text[text.length()-1] == UPPER_T) &&
 				is_either(text[text.length()-4], LOWER_I_HASH, UPPER_I_HASH) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-8) &&
-					!string_util::is_one_of(text[text.length()-8], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-8 &&
+					!string_util::is_one_of(text[text.length()-8], french_vowels()) )
 					{
 					text.erase(text.end()-7, text.end() );
 					return;
@@ -701,8 +703,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issante*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_N, UPPER_N, LOWER_T, UPPER_T, LOWER_E, UPPER_E) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-8) &&
-					!string_util::is_one_of(text[text.length()-8], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-8 &&
+					!string_util::is_one_of(text[text.length()-8], french_vowels()) )
 					{
 					text.erase(text.end()-7, text.end() );
 					return;
@@ -710,8 +712,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issants*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_N, UPPER_N, LOWER_T, UPPER_T, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-8) &&
-					!string_util::is_one_of(text[text.length()-8], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-8 &&
+					!string_util::is_one_of(text[text.length()-8], french_vowels()) )
 					{
 					text.erase(text.end()-7, text.end() );
 					return;
@@ -719,8 +721,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issions*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_I, UPPER_I, LOWER_O, UPPER_O, LOWER_N, UPPER_N, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-8) &&
-					!string_util::is_one_of(text[text.length()-8], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-8 &&
+					!string_util::is_one_of(text[text.length()-8], french_vowels()) )
 					{
 					text.erase(text.end()-7, text.end() );
 					return;
@@ -728,8 +730,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irions*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_I, UPPER_I, LOWER_O, UPPER_O, LOWER_N, UPPER_N, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -737,8 +739,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issais*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_I, UPPER_I, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -746,8 +748,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issait*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_I, UPPER_I, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -755,8 +757,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issant*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_A, UPPER_A, LOWER_N, UPPER_N, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -764,8 +766,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issent*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E, LOWER_N, UPPER_N, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -773,8 +775,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issiez*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_I, UPPER_I, LOWER_E, UPPER_E, LOWER_Z, UPPER_Z) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -782,8 +784,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issons*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_O, UPPER_O, LOWER_N, UPPER_N, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-7) &&
-					!string_util::is_one_of(text[text.length()-7], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-7 &&
+					!string_util::is_one_of(text[text.length()-7], french_vowels()) )
 					{
 					text.erase(text.end()-6, text.end() );
 					return;
@@ -791,8 +793,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irais*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A, LOWER_I, UPPER_I, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -800,8 +802,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irait*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A, LOWER_I, UPPER_I, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -809,8 +811,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irent*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_E, UPPER_E, LOWER_N, UPPER_N, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -818,8 +820,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*iriez*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_I, UPPER_I, LOWER_E, UPPER_E, LOWER_Z, UPPER_Z) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -827,8 +829,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irons*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_O, UPPER_O, LOWER_N, UPPER_N, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -836,8 +838,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*iront*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_O, UPPER_O, LOWER_N, UPPER_N, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -845,8 +847,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*isses*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6) &&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6 &&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -854,8 +856,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*issez*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E, LOWER_Z, UPPER_Z) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-6)&&
-					!string_util::is_one_of(text[text.length()-6], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-6&&
+					!string_util::is_one_of(text[text.length()-6], french_vowels()) )
 					{
 					text.erase(text.end()-5, text.end() );
 					return;
@@ -863,8 +865,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*mes*/'', '', LOWER_M, UPPER_M, LOWER_E, UPPER_E, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -872,8 +874,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*tes*/'', '', LOWER_T, UPPER_T, LOWER_E, UPPER_E, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -881,8 +883,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irai*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A, LOWER_I, UPPER_I) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -890,8 +892,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*iras*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -899,8 +901,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*irez*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_E, UPPER_E, LOWER_Z, UPPER_Z) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -908,8 +910,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*isse*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_S, UPPER_S, LOWER_E, UPPER_E) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-5) &&
-					!string_util::is_one_of(text[text.length()-5], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-5 &&
+					!string_util::is_one_of(text[text.length()-5], french_vowels()) )
 					{
 					text.erase(text.end()-4, text.end() );
 					return;
@@ -917,8 +919,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*ies*/LOWER_I, UPPER_I, LOWER_E, UPPER_E, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-4) &&
-					!string_util::is_one_of(text[text.length()-4], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-4 &&
+					!string_util::is_one_of(text[text.length()-4], french_vowels()) )
 					{
 					text.erase(text.end()-3, text.end() );
 					return;
@@ -926,8 +928,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*ira*/LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-4) &&
-					!string_util::is_one_of(text[text.length()-4], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-4 &&
+					!string_util::is_one_of(text[text.length()-4], french_vowels()) )
 					{
 					text.erase(text.end()-3, text.end() );
 					return;
@@ -936,7 +938,7 @@ namespace stemming
 			else if (is_suffix_in_rv(text,/*t*/'', '', LOWER_T, UPPER_T) )
 				{
 				if (m_rv <= text.length()-3 &&
-					!string_util::is_one_of(text[text.length()-3], FRENCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-3], french_vowels()) )
 					{
 					text.erase(text.end()-2, text.end() );
 					return;
@@ -945,7 +947,7 @@ namespace stemming
 			else if (is_suffix_in_rv(text,/*ie*/LOWER_I, UPPER_I, LOWER_E, UPPER_E) )
 				{
 				if (m_rv <= text.length()-3 &&
-					!string_util::is_one_of(text[text.length()-3], FRENCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-3], french_vowels()) )
 					{
 					text.erase(text.end()-2, text.end() );
 					return;
@@ -954,7 +956,7 @@ namespace stemming
 			else if (is_suffix_in_rv(text,/*ir*/LOWER_I, UPPER_I, LOWER_R, UPPER_R) )
 				{
 				if (m_rv <= text.length()-3 &&
-					!string_util::is_one_of(text[text.length()-3], FRENCH_VOWELS) )
+					!string_util::is_one_of(text[text.length()-3], french_vowels()) )
 					{
 					text.erase(text.end()-2, text.end() );
 					return;
@@ -962,8 +964,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*is*/LOWER_I, UPPER_I, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-3) &&
-					!string_util::is_one_of(text[text.length()-3], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-3 &&
+					!string_util::is_one_of(text[text.length()-3], french_vowels()) )
 					{
 					text.erase(text.end()-2, text.end() );
 					return;
@@ -971,8 +973,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text,/*it*/LOWER_I, UPPER_I, LOWER_T, UPPER_T) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-3) &&
-					!string_util::is_one_of(text[text.length()-3], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-3 &&
+					!string_util::is_one_of(text[text.length()-3], french_vowels()) )
 					{
 					text.erase(text.end()-2, text.end() );
 					return;
@@ -980,8 +982,8 @@ namespace stemming
 				}
 			else if (is_suffix_in_rv(text, LOWER_I, UPPER_I) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-2) &&
-					!string_util::is_one_of(text[text.length()-2], FRENCH_VOWELS) )
+				if (m_rv <= text.length()-2 &&
+					!string_util::is_one_of(text[text.length()-2], french_vowels()) )
 					{
 					text.erase(text.end()-1, text.end() );
 					return;
@@ -1022,7 +1024,7 @@ namespace stemming
 				delete_if_is_in_rv(text, LOWER_E, UPPER_E);
 				return;
 				}
-			else if (m_rv <= static_cast<int>(text.length()-7) &&
+			else if (m_rv <= text.length()-7 &&
 				(text[text.length()-7] == LOWER_E || text[text.length()-7] == UPPER_E) &&
 				(text[text.length()-6] == LOWER_R || text[text.length()-6] == UPPER_R) &&
 				(text[text.length()-5] == LOWER_A || text[text.length()-5] == UPPER_A) &&
@@ -1038,7 +1040,7 @@ namespace stemming
 				{
 				return;
 				}
-			else if (m_rv <= static_cast<int>(text.length()-5) &&
+			else if (m_rv <= text.length()-5 &&
 				(text[text.length()-5] == LOWER_A || text[text.length()-5] == UPPER_A) &&
 				(text[text.length()-3] == LOWER_E || text[text.length()-3] == UPPER_E) &&
 				(text[text.length()-2] == LOWER_N || text[text.length()-2] == UPPER_N) &&
@@ -1254,7 +1256,7 @@ namespace stemming
 				update_r_sections(text);
 				return;
 				}
-			else if (m_rv <= static_cast<int>(text.length()-4) &&
+			else if (m_rv <= text.length()-4 &&
 				(text[text.length()-3] == '' || text[text.length()-3] == '') &&
 				(text[text.length()-2] == LOWER_R || text[text.length()-2] == UPPER_R) &&
 				(text[text.length()-1] == LOWER_E || text[text.length()-1] == UPPER_E) &&
@@ -1272,7 +1274,7 @@ namespace stemming
 				update_r_sections(text);
 				return;
 				}
-			else if (m_rv <= static_cast<int>(text.length()-3) &&
+			else if (m_rv <= text.length()-3 &&
 				(text[text.length()-2] == LOWER_E || text[text.length()-2] == UPPER_E) &&
 				(text[text.length()-1] == LOWER_R || text[text.length()-1] == UPPER_R) &&
 				is_either(text[text.length()-3], LOWER_I_HASH, UPPER_I_HASH) )
@@ -1326,8 +1328,8 @@ namespace stemming
 		void step_6(std::basic_string<xchar>& text)
 			{
 			size_t last_e = text.find_last_of(_XTEXT(""));
-			size_t last_vowel = text.find_last_of(FRENCH_VOWELS);
-			size_t last_consonant = text.find_last_not_of(FRENCH_VOWELS);
+			size_t last_vowel = text.find_last_of(french_vowels());
+			size_t last_consonant = text.find_last_not_of(french_vowels());
 			if (last_e == std::basic_string<xchar>::npos ||
 				last_consonant == std::basic_string<xchar>::npos)
 				{
@@ -47,7 +47,7 @@ namespace stemming
 
 			trim_western_punctuation(text);
 
-			hash_german_yu(text, GERMAN_VOWELS);
+			hash_german_yu(text, german_vowels());
 			//change '' to "ss"
 			string_util::replace_all(text, _XTEXT(""), _XTEXT("ss"));
 			//German variant addition
@@ -69,14 +69,14 @@ namespace stemming
 					}
 				}
 
-			find_r1(text, GERMAN_VOWELS);
+			find_r1(text, german_vowels());
 			if (m_r1 == text.length() )
 				{
 				remove_german_umlauts(text);
 				unhash_german_yu(text);
 				return;
 				}
-			find_r2(text, GERMAN_VOWELS);
+			find_r2(text, german_vowels());
 			//R1 must have at least 3 characters in front of it
 			if (m_r1 < 3)
 				{
@@ -92,6 +92,8 @@ namespace stemming
 			unhash_german_yu(text);
 			}
 	private:
+		static const xchar* german_vowels()
+			{ return _XTEXT("aeiou\xFCy\xE4\xF6" "A\xC4" "EIO\xD6U\xDCY"); }
 		/**Search for the longest among the following suffixes, 
 			-#e em en ern er es
 			-#s (preceded by a valid s-ending) 
@@ -210,7 +212,7 @@ namespace stemming
 				}
 			else if (is_suffix(text,/*isch*/LOWER_I, UPPER_I, LOWER_S, UPPER_S, LOWER_C, UPPER_C, LOWER_H, UPPER_H) )
 				{
-				if (m_r2 <= static_cast<int>(text.length()-4) &&
+				if (m_r2 <= text.length()-4 &&
 					is_neither(text[text.length()-5], LOWER_E, UPPER_E) )
 					{
 					text.erase(text.end()-4, text.end() );
@@ -45,8 +45,8 @@ namespace stemming
 			//reset internal data
 			m_r1 = m_r2 = m_rv =0;
 
-			find_r1(text, NORWEGIAN_VOWELS);
-			if (m_r1 == static_cast<int>(text.length() ) )
+			find_r1(text, norwegian_vowels());
+			if (m_r1 == text.length() )
 				{
 				return;
 				}
@@ -62,6 +62,8 @@ namespace stemming
 			step_3(text);
 			}
 	private:
+		static const xchar* norwegian_vowels()
+			{ return _XTEXT("aeio\xF8uy\xE5\xE6\xC5" "A\xC6" "EIO\xD8UY"); }
 		/**Search for the longest among the following suffixes in R1, and perform the action indicated. 
 			-#a e ede ande ende ane ene hetene en heten ar er heter as es edes
 			  endes enes hetenes ens hetens ers ets et het ast 
@@ -206,7 +208,7 @@ namespace stemming
 						}
                     else if (text.length() > 2 &&
                         is_either(text[text.length()-2], LOWER_K, UPPER_K) &&
-                        !string_util::is_one_of(text[text.length()-3], NORWEGIAN_VOWELS))
+                        !string_util::is_one_of(text[text.length()-3], norwegian_vowels()))
 						{
 						text.erase(text.end()-1, text.end() );
 						update_r_sections(text);
@@ -60,9 +60,9 @@ namespace stemming
 			string_util::replace_all(text, _XTEXT(""), _XTEXT("o~"));
 			string_util::replace_all(text, _XTEXT(""), _XTEXT("O~"));
 
-			find_r1(text, PORTUGUESE_VOWELS);
-			find_r2(text, PORTUGUESE_VOWELS);
-			find_spanish_rv(text, PORTUGUESE_VOWELS);
+			find_r1(text, portuguese_vowels());
+			find_r2(text, portuguese_vowels());
+			find_spanish_rv(text, portuguese_vowels());
 
 			step_1(text);
 			//intermediate steps handled by step 1
@@ -79,6 +79,8 @@ namespace stemming
 			string_util::replace_all(text, _XTEXT("O~"), _XTEXT(""));
 			}
 	private:
+		static const xchar* portuguese_vowels()
+			{ return _XTEXT("aeiou\xE1\xE9\xED\xF3\xFA\xE2\xEA\xF4" "AEIOU\xC1\xC9\xCD\xD3\xDA\xC2\xCA\xD4"); }
 		/**Search for the longest among the following suffixes, and perform the action indicated. 
 
 			-eza   ezas   ico   ica   icos   icas   ismo   ismos   vel   vel   ista   istas
@@ -238,7 +240,7 @@ namespace stemming
 				}
 			else if (is_suffix(text,/*eiras*/LOWER_E, UPPER_E, LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A, LOWER_S, UPPER_S) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-4) )
+				if (m_rv <= text.length()-4 )
 					{
 					text.erase(text.end()-2, text.end() );
 					m_altered_suffix_index = text.length()-3;
@@ -332,7 +334,7 @@ namespace stemming
 				}
 			else if (is_suffix(text,/*eira*/LOWER_E, UPPER_E, LOWER_I, UPPER_I, LOWER_R, UPPER_R, LOWER_A, UPPER_A) )
 				{
-				if (m_rv <= static_cast<int>(text.length()-3) )
+				if (m_rv <= text.length()-3 )
 					{
 					text.erase(text.end()-1, text.end() );
 					m_altered_suffix_index = text.length()-3;
@@ -183,7 +183,7 @@ namespace stemming
 		void step_0a(std::basic_string<xchar>& text, size_t suffix_length)
 			{
 			if ((text.length() >= suffix_length + 5) &&
-				m_rv <= static_cast<int>(text.length()-5-suffix_length) &&
+				m_rv <= text.length()-5-suffix_length &&
 				/*indo*/
 				(is_either(text[text.length()-5-suffix_length], LOWER_I, UPPER_I) &&
 					is_either(text[text.length()-4-suffix_length], LOWER_E_ACUTE, UPPER_E_ACUTE) &&
@@ -196,7 +196,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 4) &&
-				m_rv <= static_cast<int>(text.length()-4-suffix_length) &&
+				m_rv <= text.length()-4-suffix_length &&
 				/*ndo*/
 				(is_either(text[text.length()-4-suffix_length], LOWER_A_ACUTE, UPPER_A_ACUTE) &&
 					is_either(text[text.length()-3-suffix_length], LOWER_N, UPPER_N) &&
@@ -208,7 +208,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*r*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_A_ACUTE, UPPER_A_ACUTE) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
@@ -218,7 +218,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*r*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_E_ACUTE, UPPER_E_ACUTE) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
@@ -228,7 +228,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*r*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_I_ACUTE, UPPER_I_ACUTE) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
@@ -243,7 +243,7 @@ namespace stemming
 		void step_0b(std::basic_string<xchar>& text, size_t suffix_length)
 			{
 			if ((text.length() >= suffix_length + 5) &&
-				m_rv <= static_cast<int>(text.length()-5-suffix_length) &&
+				m_rv <= text.length()-5-suffix_length &&
 				/*iendo*/
 				(is_either(text[text.length()-5-suffix_length], LOWER_I, UPPER_I) &&
 					is_either(text[text.length()-4-suffix_length], LOWER_E, UPPER_E) &&
@@ -255,7 +255,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 4) &&
-				m_rv <= static_cast<int>(text.length()-4-suffix_length) &&
+				m_rv <= text.length()-4-suffix_length &&
 				/*ando*/
 				(is_either(text[text.length()-4-suffix_length], LOWER_A, UPPER_A) &&
 					is_either(text[text.length()-3-suffix_length], LOWER_N, UPPER_N) &&
@@ -266,7 +266,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*ar*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_A, UPPER_A) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
@@ -275,7 +275,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*er*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_E, UPPER_E) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
@@ -284,7 +284,7 @@ namespace stemming
 				update_r_sections(text);
 				}
 			else if ((text.length() >= suffix_length + 2) &&
-				m_rv <= static_cast<int>(text.length()-2-suffix_length) &&
+				m_rv <= text.length()-2-suffix_length &&
 				/*ir*/
 				(is_either(text[text.length()-2-suffix_length], LOWER_I, UPPER_I) &&
 					is_either(text[text.length()-1-suffix_length], LOWER_R, UPPER_R) ) )
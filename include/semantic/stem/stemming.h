@@ -75,51 +75,42 @@ namespace stemming
     const xchar UPPER_Z = 0x5A;
     const xchar LOWER_Z = 0x7A;
 
-    const unsigned xchar UPPER_A_ACUTE = 0xC1;
-    const unsigned xchar LOWER_A_ACUTE = 0xE1;
-    const unsigned xchar UPPER_E_ACUTE = 0xC9;
-    const unsigned xchar LOWER_E_ACUTE = 0xE9;
-    const unsigned xchar UPPER_I_ACUTE = 0xCD;
-    const unsigned xchar LOWER_I_ACUTE = 0xED;
-    const unsigned xchar UPPER_O_ACUTE = 0xD3;
-    const unsigned xchar LOWER_O_ACUTE = 0xF3;
-    const unsigned xchar UPPER_A_CIRCUMFLEX = 0xC2;
-    const unsigned xchar LOWER_A_CIRCUMFLEX = 0xE2;
-    const unsigned xchar UPPER_E_CIRCUMFLEX = 0xCA;
-    const unsigned xchar LOWER_E_CIRCUMFLEX = 0xEA;
-    const unsigned xchar UPPER_O_STROKE = 0xD8;
-    const unsigned xchar LOWER_O_STROKE = 0xF8;
-    const unsigned xchar UPPER_C_CEDILLA = 0xC7;
-    const unsigned xchar LOWER_C_CEDILLA = 0xE7;
-    const unsigned xchar LOWER_A_UMLAUTS = 0xC4;
-    const unsigned xchar UPPER_A_UMLAUTS = 0xE4;
-    const unsigned xchar UPPER_O_UMLAUTS = 0xD6;
-    const unsigned xchar LOWER_O_UMLAUTS = 0xF6;
-    const unsigned xchar TILDE = 0x7E;
-    const unsigned xchar UPPER_A_GRAVE = 0xC0;
-    const unsigned xchar LOWER_A_GRAVE = 0xE0;
-    const unsigned xchar UPPER_E_GRAVE = 0xC8;
-    const unsigned xchar LOWER_E_GRAVE = 0xE8;
-    const unsigned xchar UPPER_I_GRAVE = 0xCC;
-    const unsigned xchar LOWER_I_GRAVE = 0xEC;
-    const unsigned xchar UPPER_O_GRAVE = 0xD2;
-    const unsigned xchar LOWER_O_GRAVE = 0xF2;
+    const xchar UPPER_A_ACUTE = static_cast<xchar>(0xC1);
+    const xchar LOWER_A_ACUTE = static_cast<xchar>(0xE1);
+    const xchar UPPER_E_ACUTE = static_cast<xchar>(0xC9);
+    const xchar LOWER_E_ACUTE = static_cast<xchar>(0xE9);
+    const xchar UPPER_I_ACUTE = static_cast<xchar>(0xCD);
+    const xchar LOWER_I_ACUTE = static_cast<xchar>(0xED);
+    const xchar UPPER_O_ACUTE = static_cast<xchar>(0xD3);
+    const xchar LOWER_O_ACUTE = static_cast<xchar>(0xF3);
+    const xchar UPPER_A_CIRCUMFLEX = static_cast<xchar>(0xC2);
+    const xchar LOWER_A_CIRCUMFLEX = static_cast<xchar>(0xE2);
+    const xchar UPPER_E_CIRCUMFLEX = static_cast<xchar>(0xCA);
+    const xchar LOWER_E_CIRCUMFLEX = static_cast<xchar>(0xEA);
+    const xchar UPPER_O_STROKE = static_cast<xchar>(0xD8);
+    const xchar LOWER_O_STROKE = static_cast<xchar>(0xF8);
+    const xchar UPPER_C_CEDILLA = static_cast<xchar>(0xC7);
+    const xchar LOWER_C_CEDILLA = static_cast<xchar>(0xE7);
+    const xchar LOWER_A_UMLAUTS = static_cast<xchar>(0xC4);
+    const xchar UPPER_A_UMLAUTS = static_cast<xchar>(0xE4);
+    const xchar UPPER_O_UMLAUTS = static_cast<xchar>(0xD6);
+    const xchar LOWER_O_UMLAUTS = static_cast<xchar>(0xF6);
+    const xchar TILDE = static_cast<xchar>(0x7E);
+    const xchar UPPER_A_GRAVE = static_cast<xchar>(0xC0);
+    const xchar LOWER_A_GRAVE = static_cast<xchar>(0xE0);
+    const xchar UPPER_E_GRAVE = static_cast<xchar>(0xC8);
+    const xchar LOWER_E_GRAVE = static_cast<xchar>(0xE8);
+    const xchar UPPER_I_GRAVE = static_cast<xchar>(0xCC);
+    const xchar LOWER_I_GRAVE = static_cast<xchar>(0xEC);
+    const xchar UPPER_O_GRAVE = static_cast<xchar>(0xD2);
+    const xchar LOWER_O_GRAVE = static_cast<xchar>(0xF2);
 	//these characters should not appear in an indexed word
-	const unsigned xchar UPPER_Y_HASH = 7;//bell
-	const unsigned xchar LOWER_Y_HASH = 9;//tab
-	const unsigned xchar UPPER_I_HASH = 10;//line feed
-	const unsigned xchar LOWER_I_HASH = 11;//vertical tab
-	const unsigned xchar UPPER_U_HASH = 12;//form feed (new page)
-	const unsigned xchar LOWER_U_HASH = 13;//carriage return
-
-    //language constants
-//    static const xchar* FRENCH_VOWELS = _XTEXT("aeiouyAEIOUY");
-//   static const xchar* GERMAN_VOWELS = _XTEXT("aeiouyAEIOUY");
-//    static const xchar* FINNISH_VOWELS = _XTEXT("aeiouyAEIOUY");
-//    static const xchar* DUTCH_VOWELS = _XTEXT("aeiouyAEIOUY");
-//    static const xchar* DUTCH_KDT = _XTEXT("kdtKDT");
-//    static const xchar* NORWEGIAN_VOWELS = _XTEXT("aeiouyAEIOUY");
-//    static const xchar* PORTUGUESE_VOWELS = _XTEXT("aeiouAEIOU");
+	const xchar UPPER_Y_HASH = static_cast<xchar>(7);//bell
+	const xchar LOWER_Y_HASH = static_cast<xchar>(9);//tab
+	const xchar UPPER_I_HASH = static_cast<xchar>(10);//line feed
+	const xchar LOWER_I_HASH = static_cast<xchar>(11);//vertical tab
+	const xchar UPPER_U_HASH = static_cast<xchar>(12);//form feed (new page)
+	const xchar LOWER_U_HASH = static_cast<xchar>(13);//carriage return
 
 
 	template<typename Tchar_type = xchar>
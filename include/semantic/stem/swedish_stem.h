@@ -45,7 +45,7 @@ namespace stemming
 			//see where the R1 section begins
 			//R1 is the first consonant after the first vowel
 			find_r1(text, _XTEXT("aeiouyAEIOUY"));
-			if (m_r1 == static_cast<int>(text.length() ) )
+			if (m_r1 == text.length() )
 				{
 				return;
 				}
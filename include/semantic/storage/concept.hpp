@@ -16,6 +16,9 @@ namespace semantic {
 				p.set_mirror_changes_to_storage(b);
 				b = p.get_mirror_changes_to_storage();
 				
+				p.set_defer_indexing_cleanup(b);
+				b = p.get_defer_indexing_cleanup();
+				
 				p.commit_changes_to_storage();
 				
 				boost::tie(b, u) = p.will_add_vertex(vp);
@@ -43,6 +46,7 @@ namespace semantic {
 				id = p.get_vertex_id(vp);
 				
 				id = p.fetch_vertex_id_by_content_and_type(s, i);
+				p.fetch_vertex_ids_by_content_and_type(s, s, i, id);	// 1, 2 & 4 = iterators
 				
 				vs = p.get_vertex_count_of_type(i);
 				
@@ -0,0 +1,1017 @@
+/*
+a read-only storage policy that serves searches from a collection exported
+to one compact file (see export_csr() at the bottom, or the
+semantic_csr_export tool).
+
+the file holds a single collection:
+
+	- its vertices, sorted by id
+	- their out-edges from edge_query as compressed sparse rows, with the
+	  strength, degree and weight columns alongside
+	- the vertex and collection meta data, and the vertex counts per type
+	- a hash index from (content, type) to vertex
+
+the file is mapped into memory instead of read, so opening it costs next to
+nothing, a neighbor list is a couple of array reads away, and every search
+process on the machine shares the one copy in the page cache.  graphs in the
+same process that open the same file share the mapping too.
+
+nothing can be changed through this policy.  export the collection again to
+pick up changes to the database; the exporter writes a new file and renames
+it into place, so searches that are running never see half of one.
+
+this follows the storage policy description found in docs/storage/policy.txt
+*/
+
+#ifndef __SEMANTIC_STORAGE_CSR_HPP__
+#define __SEMANTIC_STORAGE_CSR_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/properties.hpp>
+#include <semantic/exception.hpp>
+#include <semantic/utility.hpp>
+#include <semantic/storage/base.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+
+#ifndef WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <semantic/semantic.hpp>
+
+namespace semantic {
+
+	struct CSRStoragePolicy;
+
+	// our exception
+	struct CSRException : public std::exception {
+		CSRException(const std::string &m) : msg(m) {}
+		~CSRException() throw() {}
+		const char * what() const throw() { return msg.c_str(); }
+
+		std::string msg;
+	};
+
+	// the vertex properties carry the id of the vertex in the database it was
+	// exported from, the same as sqlite_vertex_properties
+	struct csr_vertex_properties : vertex_properties {
+		csr_vertex_properties() : vertex_properties(), id(0), in_db(false) {}
+		unsigned long id;
+		bool in_db;
+	};
+
+	template <> struct se_storage_traits<CSRStoragePolicy> {
+		typedef unsigned long vertex_id_type;
+		typedef csr_vertex_properties vertex_properties_type;
+		typedef edge_properties edge_properties_type;
+	};
+
+
+/* *******************************************************
+		CSR FILE
+
+		one mapped collection.  the block is laid out as
+
+			header | nodes | first_edge | edges | first_meta |
+			vertex meta | meta keys | buckets | chain |
+			type counts | collection meta | pool
+
+		where the out-edges of node i are edges first_edge[i] up
+		to first_edge[i+1] (and likewise for its meta data), and
+		every string is an offset and length into the pool.  the
+		counts are all in the header; records are multiples of 8
+		bytes so everything up to the pool stays aligned.  the
+		format is in the native byte order and open() refuses
+		files written on a machine with a different one.
+   ******************************************************* */
+	class csr_file : boost::noncopyable {
+		public:
+			typedef boost::shared_ptr<const csr_file> pointer;
+			typedef boost::uint64_t index_type;
+
+			struct string_ref {
+				boost::uint64_t offset, length;
+			};
+
+			struct node_record {
+				boost::uint64_t id;
+				string_ref content;
+				boost::int32_t type_major, type_minor;
+			};
+
+			struct edge_record {
+				boost::uint32_t target;		// node index, not id
+				boost::int32_t strength;
+				boost::uint32_t degree_from, degree_to;
+				double weight;				// negative if edge_query had none
+			};
+
+			struct vertex_meta_record {
+				boost::uint64_t key;		// index into the meta keys
+				string_ref value;
+			};
+
+			struct meta_record {
+				string_ref key, value;
+			};
+
+			struct type_count_record {
+				boost::int64_t type;
+				boost::uint64_t count;
+			};
+
+			~csr_file() {
+#ifndef WIN32
+				if (m_map) munmap(m_map, m_map_size);
+#endif
+			}
+
+			// maps the file, or hands back the mapping we already have for it
+			// if the file hasn't been replaced since
+			static pointer open(const std::string &filename) {
+				static std::map<std::string, boost::weak_ptr<const csr_file> > files;
+#if SEMANTIC_HAVE_BOOST_THREAD
+				static boost::mutex files_mutex;
+				boost::mutex::scoped_lock lock(files_mutex);
+#endif
+				std::map<std::string, boost::weak_ptr<const csr_file> >::iterator f = files.find(filename);
+				if (f != files.end()) {
+					pointer p = f->second.lock();
+					if (p && !p->replaced()) return p;
+				}
+
+				pointer p(new csr_file(filename));
+				files[filename] = p;
+				return p;
+			}
+
+			std::string collection() const { return str(m_header->collection); }
+			std::string version() const { return str(m_header->version); }
+
+			index_type num_nodes() const { return m_header->num_nodes; }
+			index_type num_edges() const { return m_header->num_edges; }
+
+			const node_record &node(index_type i) const { return m_nodes[i]; }
+
+			// the node with this database id; num_nodes() if there isn't one
+			index_type find(boost::uint64_t id) const {
+				index_type lo = 0, hi = m_header->num_nodes;
+				while (lo < hi) {
+					index_type mid = lo + (hi - lo) / 2;
+					if (m_nodes[mid].id == id) return mid;
+					if (m_nodes[mid].id < id) lo = mid + 1;
+					else hi = mid;
+				}
+				return m_header->num_nodes;
+			}
+
+			// the node with this content and major type; num_nodes() if there
+			// isn't one
+			index_type find(const std::string &content, int type) const {
+				if (m_header->num_buckets == 0) return m_header->num_nodes;
+				index_type i = m_buckets[hash(content.data(), content.size(), type) & (m_header->num_buckets - 1)];
+				for (; i != m_header->num_nodes; i = m_chain[i]) {
+					const node_record &n = m_nodes[i];
+					if (n.type_major == type && n.content.length == content.size()
+						&& memcmp(m_pool + n.content.offset, content.data(), content.size()) == 0) return i;
+				}
+				return m_header->num_nodes;
+			}
+
+			const edge_record *edges_begin(index_type i) const { return m_edges + m_first_edge[i]; }
+			const edge_record *edges_end(index_type i) const { return m_edges + m_first_edge[i+1]; }
+
+			std::string content(index_type i) const { return str(m_nodes[i].content); }
+
+			// a vertex meta data value; false if the node doesn't have one
+			bool vertex_meta(index_type i, const std::string &key, std::string &value) const {
+				index_type k = find_meta_key(key);
+				if (k == m_header->num_meta_keys) return false;
+				for (index_type m = m_first_meta[i]; m != m_first_meta[i+1]; ++m) {
+					if (m_vertex_meta[m].key == k) {
+						value = str(m_vertex_meta[m].value);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			index_type num_meta_keys() const { return m_header->num_meta_keys; }
+			std::string meta_key(index_type k) const { return str(m_meta_keys[k]); }
+
+			// a collection meta data value; false if there isn't one
+			bool meta(const std::string &key, std::string &value) const {
+				for (index_type m = 0; m < m_header->num_meta; ++m) {
+					if (equals(m_meta[m].key, key)) {
+						value = str(m_meta[m].value);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			index_type num_meta() const { return m_header->num_meta; }
+			std::pair<std::string, std::string> meta(index_type m) const {
+				return std::make_pair(str(m_meta[m].key), str(m_meta[m].value));
+			}
+
+			// the node_count of a vertex type, as it was when the file was written
+			boost::uint64_t count_of_type(int type) const {
+				for (index_type t = 0; t < m_header->num_types; ++t) {
+					if (m_type_counts[t].type == type) return m_type_counts[t].count;
+				}
+				return 0;
+			}
+
+			static std::string file_magic() { return std::string("SECSR02", 8); } // 8 bytes with the NUL
+
+			// FNV-1a of the content, with the type folded in
+			static boost::uint32_t hash(const char *s, std::size_t n, int type) {
+				boost::uint32_t h = 2166136261u;
+				for (std::size_t i = 0; i < n; ++i) {
+					h ^= (unsigned char)s[i];
+					h *= 16777619u;
+				}
+				h ^= (boost::uint32_t)type;
+				h *= 16777619u;
+				return h;
+			}
+
+			struct header {
+				char magic[8];
+				boost::uint32_t byte_order;
+				boost::uint32_t reserved;
+				boost::uint64_t num_nodes, num_edges, num_vertex_meta, num_meta_keys;
+				boost::uint64_t num_buckets, num_types, num_meta, pool_size;
+				string_ref collection, version;
+			};
+
+			static const boost::uint32_t byte_order = 0x01020304;
+
+		private:
+			std::vector<char> m_data;	// WIN32 reads the file instead
+			void *m_map;
+			std::size_t m_map_size;
+
+			// to tell when the file's been exported over
+			std::string m_file;
+#ifndef WIN32
+			dev_t m_device;
+			ino_t m_inode;
+			time_t m_modified;
+#endif
+
+			const header *m_header;
+			const node_record *m_nodes;
+			const boost::uint64_t *m_first_edge;
+			const edge_record *m_edges;
+			const boost::uint64_t *m_first_meta;
+			const vertex_meta_record *m_vertex_meta;
+			const string_ref *m_meta_keys;
+			const boost::uint64_t *m_buckets;
+			const boost::uint64_t *m_chain;
+			const type_count_record *m_type_counts;
+			const meta_record *m_meta;
+			const char *m_pool;
+
+			csr_file(const std::string &filename) : m_map(0), m_map_size(0), m_file(filename) {
+#ifndef WIN32
+				int fd = ::open(filename.c_str(), O_RDONLY);
+				if (fd < 0) throw CSRException("Couldn't open CSR index " + filename);
+				struct stat st;
+				if (fstat(fd, &st) != 0 || st.st_size == 0) {
+					::close(fd);
+					throw CSRException("Couldn't open CSR index " + filename);
+				}
+				void *map = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+				::close(fd);
+				if (map == MAP_FAILED) throw CSRException("Couldn't map CSR index " + filename);
+				m_map = map;
+				m_map_size = st.st_size;
+				m_device = st.st_dev;
+				m_inode = st.st_ino;
+				m_modified = st.st_mtime;
+				try {
+					attach((const char *)map, st.st_size);
+					check();
+				} catch (CSRException &) {
+					// (the destructor won't be run)
+					munmap(m_map, m_map_size);
+					throw;
+				}
+#else
+				std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+				if (!file) throw CSRException("Couldn't open CSR index " + filename);
+				m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+				if (m_data.empty()) throw CSRException("CSR index " + filename + " is truncated");
+				attach(&m_data[0], m_data.size());
+				check();
+#endif
+			}
+
+			// has a new file been put where ours was?
+			bool replaced() const {
+#ifndef WIN32
+				struct stat st;
+				if (stat(m_file.c_str(), &st) != 0) return false; // keep serving what we have
+				return st.st_dev != m_device || st.st_ino != m_inode || st.st_mtime != m_modified;
+#else
+				return false;
+#endif
+			}
+
+			// point the accessors into the block, checking that it holds
+			// everything the header says it does
+			void attach(const char *base, std::size_t size) {
+				if (size < sizeof(header)) throw CSRException("CSR index " + m_file + " is truncated");
+				const header *h = (const header *)base;
+				if (memcmp(h->magic, file_magic().data(), sizeof(h->magic)) != 0)
+					throw CSRException(m_file + " isn't a CSR index");
+				if (h->byte_order != byte_order)
+					throw CSRException("CSR index " + m_file + " was written with a different byte order");
+
+				// (no count can be more than the file's bytes, which also keeps
+				// the sum below from wrapping around)
+				boost::uint64_t counts[] = { h->num_nodes, h->num_edges, h->num_vertex_meta, h->num_meta_keys,
+					h->num_buckets, h->num_types, h->num_meta, h->pool_size };
+				for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+					if (counts[c] > size) throw CSRException("CSR index " + m_file + " is truncated");
+				}
+
+				boost::uint64_t needed = sizeof(header)
+					+ sizeof(node_record) * h->num_nodes
+					+ sizeof(boost::uint64_t) * (h->num_nodes + 1)
+					+ sizeof(edge_record) * h->num_edges
+					+ sizeof(boost::uint64_t) * (h->num_nodes + 1)
+					+ sizeof(vertex_meta_record) * h->num_vertex_meta
+					+ sizeof(string_ref) * h->num_meta_keys
+					+ sizeof(boost::uint64_t) * (h->num_buckets + h->num_nodes)
+					+ sizeof(type_count_record) * h->num_types
+					+ sizeof(meta_record) * h->num_meta
+					+ h->pool_size;
+				if (size < needed) throw CSRException("CSR index " + m_file + " is truncated");
+
+				m_header = h;
+				m_nodes = (const node_record *)(base + sizeof(header));
+				m_first_edge = (const boost::uint64_t *)(m_nodes + h->num_nodes);
+				m_edges = (const edge_record *)(m_first_edge + h->num_nodes + 1);
+				m_first_meta = (const boost::uint64_t *)(m_edges + h->num_edges);
+				m_vertex_meta = (const vertex_meta_record *)(m_first_meta + h->num_nodes + 1);
+				m_meta_keys = (const string_ref *)(m_vertex_meta + h->num_vertex_meta);
+				m_buckets = (const boost::uint64_t *)(m_meta_keys + h->num_meta_keys);
+				m_chain = m_buckets + h->num_buckets;
+				m_type_counts = (const type_count_record *)(m_chain + h->num_nodes);
+				m_meta = (const meta_record *)(m_type_counts + h->num_types);
+				m_pool = (const char *)(m_meta + h->num_meta);
+			}
+
+			// after attach(): everything in the block has to point inside it -
+			// strings into the pool, edge and meta runs into their tables, and
+			// edges, hash buckets and chains at nodes
+			void check() const {
+				const header *h = m_header;
+				bool ok = in_pool(h->collection) && in_pool(h->version)
+					&& (h->num_buckets & (h->num_buckets - 1)) == 0
+					&& m_first_edge[0] == 0 && m_first_edge[h->num_nodes] <= h->num_edges
+					&& m_first_meta[0] == 0 && m_first_meta[h->num_nodes] <= h->num_vertex_meta;
+				for (index_type i = 0; ok && i < h->num_nodes; i++) {
+					ok = in_pool(m_nodes[i].content)
+						&& m_first_edge[i] <= m_first_edge[i+1] && m_first_meta[i] <= m_first_meta[i+1]
+						&& m_chain[i] <= h->num_nodes;
+				}
+				for (index_type e = 0; ok && e < h->num_edges; e++) ok = m_edges[e].target < h->num_nodes;
+				for (index_type m = 0; ok && m < h->num_vertex_meta; m++) {
+					ok = in_pool(m_vertex_meta[m].value) && m_vertex_meta[m].key < h->num_meta_keys;
+				}
+				for (index_type k = 0; ok && k < h->num_meta_keys; k++) ok = in_pool(m_meta_keys[k]);
+				for (index_type b = 0; ok && b < h->num_buckets; b++) ok = m_buckets[b] <= h->num_nodes;
+				for (index_type m = 0; ok && m < h->num_meta; m++) ok = in_pool(m_meta[m].key) && in_pool(m_meta[m].value);
+				if (!ok) throw CSRException("CSR index " + m_file + " is corrupt");
+			}
+
+			bool in_pool(const string_ref &s) const {
+				return s.offset <= m_header->pool_size && s.length <= m_header->pool_size - s.offset;
+			}
+
+			std::string str(const string_ref &s) const {
+				return std::string(m_pool + s.offset, (std::size_t)s.length);
+			}
+
+			bool equals(const string_ref &s, const std::string &str) const {
+				return s.length == str.size() && memcmp(m_pool + s.offset, str.data(), str.size()) == 0;
+			}
+
+			index_type find_meta_key(const std::string &key) const {
+				for (index_type k = 0; k < m_header->num_meta_keys; ++k) {
+					if (equals(m_meta_keys[k], key)) return k;
+				}
+				return m_header->num_meta_keys;
+			}
+	};
+
+
+/* *******************************************************
+		CSR BUILDER
+
+		collects a collection in any order and writes it out in
+		the layout above.  save() writes to a temporary file and
+		renames it over the old one.
+   ******************************************************* */
+	class csr_builder {
+		typedef csr_file::string_ref string_ref;
+
+		public:
+			csr_builder() {}
+
+			void add_vertex(boost::uint64_t id, int type_major, int type_minor, const std::string &content) {
+				csr_file::node_record n;
+				n.id = id;
+				n.type_major = type_major;
+				n.type_minor = type_minor;
+				n.content = pooled(content);
+				m_nodes.push_back(n);
+			}
+
+			void add_edge(boost::uint64_t from, boost::uint64_t to, int strength,
+							unsigned long degree_from, unsigned long degree_to, double weight = -1) {
+				pending_edge e;
+				e.from = from;
+				e.to = to;
+				e.strength = strength;
+				e.degree_from = (boost::uint32_t)degree_from;
+				e.degree_to = (boost::uint32_t)degree_to;
+				e.weight = weight;
+				m_edges.push_back(e);
+			}
+
+			void add_vertex_meta(boost::uint64_t id, const std::string &key, const std::string &value) {
+				std::map<std::string, boost::uint64_t>::iterator k = m_key_index.find(key);
+				if (k == m_key_index.end()) {
+					k = m_key_index.insert(std::make_pair(key, (boost::uint64_t)m_keys.size())).first;
+					m_keys.push_back(pooled(key));
+				}
+				pending_meta m;
+				m.id = id;
+				m.record.key = k->second;
+				m.record.value = pooled(value);
+				m_vertex_meta.push_back(m);
+			}
+
+			void add_meta(const std::string &key, const std::string &value) {
+				csr_file::meta_record m;
+				m.key = pooled(key);
+				m.value = pooled(value);
+				m_meta.push_back(m);
+			}
+
+			void set_count_of_type(int type, boost::uint64_t count) {
+				csr_file::type_count_record t;
+				t.type = type;
+				t.count = count;
+				m_type_counts.push_back(t);
+			}
+
+			void save(const std::string &filename, const std::string &collection, const std::string &version) {
+				typedef csr_file::index_type index_type;
+
+				std::sort(m_nodes.begin(), m_nodes.end(), by_id());
+				index_type n = m_nodes.size();
+				std::map<boost::uint64_t, index_type> index;
+				for (index_type i = 0; i < n; ++i) index[m_nodes[i].id] = i;
+
+				// edges, by source then target; ones to or from vertices we
+				// don't have are dropped, like populate_full_graph() does
+				std::sort(m_edges.begin(), m_edges.end(), by_source());
+				std::vector<boost::uint64_t> first_edge(n + 1, 0);
+				std::vector<csr_file::edge_record> edges;
+				edges.reserve(m_edges.size());
+				for (std::size_t e = 0; e < m_edges.size(); ++e) {
+					std::map<boost::uint64_t, index_type>::iterator from = index.find(m_edges[e].from);
+					std::map<boost::uint64_t, index_type>::iterator to = index.find(m_edges[e].to);
+					if (from == index.end() || to == index.end()) continue;
+					csr_file::edge_record r;
+					r.target = (boost::uint32_t)to->second;
+					r.strength = m_edges[e].strength;
+					r.degree_from = m_edges[e].degree_from;
+					r.degree_to = m_edges[e].degree_to;
+					r.weight = m_edges[e].weight;
+					edges.push_back(r);
+					first_edge[from->second + 1]++;
+				}
+				for (index_type i = 0; i < n; ++i) first_edge[i+1] += first_edge[i];
+
+				std::sort(m_vertex_meta.begin(), m_vertex_meta.end(), by_vertex());
+				std::vector<boost::uint64_t> first_meta(n + 1, 0);
+				std::vector<csr_file::vertex_meta_record> vertex_meta;
+				vertex_meta.reserve(m_vertex_meta.size());
+				for (std::size_t m = 0; m < m_vertex_meta.size(); ++m) {
+					std::map<boost::uint64_t, index_type>::iterator v = index.find(m_vertex_meta[m].id);
+					if (v == index.end()) continue;
+					vertex_meta.push_back(m_vertex_meta[m].record);
+					first_meta[v->second + 1]++;
+				}
+				for (index_type i = 0; i < n; ++i) first_meta[i+1] += first_meta[i];
+
+				// the hash index: a power of two buckets, at most half full
+				index_type num_buckets = 1;
+				while (num_buckets < 2 * n) num_buckets <<= 1;
+				std::vector<boost::uint64_t> buckets(num_buckets, n), chain(n, n);
+				for (index_type i = n; i-- > 0; ) {
+					const csr_file::node_record &r = m_nodes[i];
+					boost::uint64_t b = csr_file::hash(m_pool.data() + r.content.offset, (std::size_t)r.content.length, r.type_major) & (num_buckets - 1);
+					chain[i] = buckets[b];
+					buckets[b] = i;
+				}
+
+				csr_file::header h;
+				memset(&h, 0, sizeof(h));
+				memcpy(h.magic, csr_file::file_magic().data(), sizeof(h.magic));
+				h.byte_order = csr_file::byte_order;
+				h.num_nodes = n;
+				h.num_edges = edges.size();
+				h.num_vertex_meta = vertex_meta.size();
+				h.num_meta_keys = m_keys.size();
+				h.num_buckets = num_buckets;
+				h.num_types = m_type_counts.size();
+				h.num_meta = m_meta.size();
+				h.collection = pooled(collection);
+				h.version = pooled(version);
+				h.pool_size = m_pool.size();
+
+				std::string temp = filename + ".tmp";
+				std::ofstream file(temp.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+				if (!file) throw CSRException("Couldn't write CSR index " + temp);
+				file.write((const char *)&h, sizeof(h));
+				write(file, m_nodes);
+				write(file, first_edge);
+				write(file, edges);
+				write(file, first_meta);
+				write(file, vertex_meta);
+				write(file, m_keys);
+				write(file, buckets);
+				write(file, chain);
+				write(file, m_type_counts);
+				write(file, m_meta);
+				file.write(m_pool.data(), m_pool.size());
+				file.close();
+				if (!file) {
+					std::remove(temp.c_str());
+					throw CSRException("Couldn't write CSR index " + temp);
+				}
+#ifdef WIN32
+				std::remove(filename.c_str()); // rename() won't replace it there
+#endif
+				if (std::rename(temp.c_str(), filename.c_str()) != 0) {
+					std::remove(temp.c_str());
+					throw CSRException("Couldn't replace CSR index " + filename);
+				}
+			}
+
+		private:
+			struct pending_edge {
+				boost::uint64_t from, to;
+				boost::int32_t strength;
+				boost::uint32_t degree_from, degree_to;
+				double weight;
+			};
+
+			struct pending_meta {
+				boost::uint64_t id;
+				csr_file::vertex_meta_record record;
+			};
+
+			struct by_id {
+				bool operator()(const csr_file::node_record &a, const csr_file::node_record &b) const { return a.id < b.id; }
+			};
+			struct by_source {
+				bool operator()(const pending_edge &a, const pending_edge &b) const {
+					return a.from < b.from || (a.from == b.from && a.to < b.to);
+				}
+			};
+			struct by_vertex {
+				bool operator()(const pending_meta &a, const pending_meta &b) const { return a.id < b.id; }
+			};
+
+			std::vector<csr_file::node_record> m_nodes;
+			std::vector<pending_edge> m_edges;
+			std::vector<pending_meta> m_vertex_meta;
+			std::vector<string_ref> m_keys;
+			std::map<std::string, boost::uint64_t> m_key_index;
+			std::vector<csr_file::meta_record> m_meta;
+			std::vector<csr_file::type_count_record> m_type_counts;
+			std::string m_pool;
+
+			string_ref pooled(const std::string &s) {
+				string_ref r;
+				r.offset = m_pool.size();
+				r.length = s.size();
+				m_pool += s;
+				return r;
+			}
+
+			template <class T>
+			static void write(std::ofstream &file, const std::vector<T> &v) {
+				if (!v.empty()) file.write((const char *)&v[0], sizeof(T) * v.size());
+			}
+	};
+
+
+/* *******************************************************
+		THE STORAGE POLICY
+   ******************************************************* */
+	template <class SEBase>
+	class StoragePolicy<CSRStoragePolicy, SEBase> : public SEBase, public StoragePolicyBase<CSRStoragePolicy> {
+		typedef se_graph_traits<CSRStoragePolicy> traits;
+		typedef typename traits::base_graph_type base_graph_type;
+		typedef typename traits::vertex_descriptor Vertex;
+		typedef typename traits::edge_descriptor Edge;
+
+		typedef se_storage_traits<CSRStoragePolicy> storage_traits;
+		typedef typename storage_traits::vertex_properties_type vertex_properties;
+		typedef typename storage_traits::edge_properties_type edge_properties;
+		typedef typename storage_traits::vertex_id_type id_type;
+		typedef csr_file::index_type index_type;
+
+		public:
+			typedef SEBase base_type;
+
+			StoragePolicy() : mirror_flag(false) {}
+
+			// methods having to do directly with this storage policy implementation
+			void set_mirror_changes_to_storage(bool b) { mirror_flag = b; }
+			bool get_mirror_changes_to_storage() { return mirror_flag; }
+			void set_defer_indexing_cleanup(bool) {} // (it's read only)
+			bool get_defer_indexing_cleanup() { return false; }
+
+#ifdef WIN32
+			void commit_changes_to_storage() throw (...) {
+#else
+			void commit_changes_to_storage() throw (CSRException) {
+#endif
+				read_only();
+			}
+
+			// methods having to do with structure alteration to the graph
+			std::pair<bool, Vertex>
+			will_add_vertex(const vertex_properties &vp) {
+				if (vp.in_db) {
+					typename std::map<id_type, Vertex>::iterator v = m_id_vertex_cache.find(vp.id);
+					if (v != m_id_vertex_cache.end()) return std::make_pair(false, v->second);
+				}
+				return std::make_pair(true, Vertex());
+			}
+
+			void did_add_vertex(Vertex v, const vertex_properties &vp) {
+				if (vp.in_db) m_id_vertex_cache.insert(std::make_pair(vp.id, v));
+			}
+
+			void did_remove_vertex(const vertex_properties &vp) {
+				if (vp.in_db) m_id_vertex_cache.erase(vp.id);
+			}
+
+			void did_clear() { m_id_vertex_cache.clear(); }
+
+			void mark_as_dirty(Vertex) {}
+			void mark_as_dirty(Edge) {}
+
+			// methods for fetching graph contents
+#ifdef WIN32
+			Vertex vertex_by_id(id_type id) throw (...) {
+#else
+			Vertex vertex_by_id(id_type id) throw (VertexNotFoundException<id_type>) {
+#endif
+				typename std::map<id_type, Vertex>::iterator v = m_id_vertex_cache.find(id);
+				if (v != m_id_vertex_cache.end()) return v->second;
+
+				vertex_properties vp;
+				if (!fetch_vertex_properties(id, vp)) throw VertexNotFoundException<id_type>(id);
+				Vertex u = boost::add_vertex(vp, *this);
+				did_add_vertex(u, vp);
+				return u;
+			}
+
+			template <class Iterator, class OutIterator>
+#ifdef WIN32
+			void vertices_by_id(Iterator i, Iterator i_end, OutIterator out) throw (...) {
+#else
+			void vertices_by_id(Iterator i, Iterator i_end, OutIterator out) throw (VertexNotFoundException<id_type>) {
+#endif
+				for(; i != i_end; ++i) *out = std::make_pair(*i, vertex_by_id(*i));
+			}
+
+#ifdef WIN32
+			id_type get_vertex_id(const Vertex u) const throw(...) {
+#else
+			id_type get_vertex_id(const Vertex u) const throw(IdNotFoundException) {
+#endif
+				if ((*this)[u].in_db) return (*this)[u].id;
+				throw IdNotFoundException();
+			}
+
+#ifdef WIN32
+			id_type get_vertex_id(const vertex_properties &p) const throw(...) {
+#else
+			id_type get_vertex_id(const vertex_properties &p) const throw(IdNotFoundException) {
+#endif
+				if (p.in_db) return p.id;
+				throw IdNotFoundException();
+			}
+
+#ifdef WIN32
+			id_type fetch_vertex_id_by_content_and_type(std::string content, int type) throw(...) {
+#else
+			id_type fetch_vertex_id_by_content_and_type(std::string content, int type) throw(VertexContentNotFoundException) {
+#endif
+				index_type n = index().find(content, type);
+				if (n == index().num_nodes()) throw VertexContentNotFoundException(content);
+				return (id_type)index().node(n).id;
+			}
+
+			// will populate out with std::pair<std::string, id_type> for each content in
+			// i -> i_end that has a vertex of this type, in the order they're given
+			template <class ContentIterator, class OutIterator>
+			void fetch_vertex_ids_by_content_and_type(ContentIterator i, ContentIterator i_end, int type, OutIterator out) {
+				const csr_file &f = index();
+				for(; i != i_end; ++i) {
+					index_type n = f.find(*i, type);
+					if (n != f.num_nodes()) *out = std::make_pair(std::string(*i), (id_type)f.node(n).id);
+				}
+			}
+
+			typename traits::vertices_size_type get_vertex_count_of_type(int node_type) {
+				return (typename traits::vertices_size_type)index().count_of_type(node_type);
+			}
+
+			// will populate p with the properties of id or return false if
+			// there's no such vertex
+			bool fetch_vertex_properties(id_type id, vertex_properties &p) {
+				index_type n = index().find(id);
+				if (n == index().num_nodes()) return false;
+				p = properties(n);
+				return true;
+			}
+
+			// will populate out with vertex_properties instances for each id represented
+			// in i -> i_end (ids we don't have are skipped)
+			template <class IdIterator, class InputIterator>
+			bool fetch_vertex_properties(IdIterator i, IdIterator i_end, InputIterator out) {
+				if (i == i_end) return false; // nothing to fetch!
+				const csr_file &f = index();
+				for(; i != i_end; ++i) {
+					index_type n = f.find(*i);
+					if (n != f.num_nodes()) *out = properties(n);
+				}
+				return true;
+			}
+
+			// will populate out with std::pair<edge_properties, vertex_properties> for each
+			// edge and adjacent vertex
+			template <class InputIterator>
+			bool fetch_vertex_neighbors(id_type id, InputIterator out) {
+				typename traits::mapped_neighbor_list m;
+				id_type *p = &id;
+				if (!fetch_vertex_neighbors(p, p+1, m) || !m.count(id)) return false;
+				copy(m[id].begin(), m[id].end(), out);
+				return true;
+			}
+
+			// will populate the map passed with id -> neighbor list for each id in
+			// i -> i_end, the same as the other storage policies (vertices without
+			// any neighbors don't get an entry)
+			template <class IdIterator, class Map>
+			bool fetch_vertex_neighbors(IdIterator i, IdIterator i_end, Map &m) {
+				if (i == i_end) return false;
+				typedef typename Map::value_type::second_type container_type;
+				typedef typename container_type::value_type value_type;
+				BOOST_STATIC_ASSERT((boost::is_same<typename Map::key_type, id_type>::value));
+
+				const csr_file &f = index();
+				for(; i != i_end; ++i) {
+					index_type n = f.find(*i);
+					if (n == f.num_nodes() || f.edges_begin(n) == f.edges_end(n)) continue;
+
+					container_type &c = m[*i];
+					for(const csr_file::edge_record *e = f.edges_begin(n); e != f.edges_end(n); ++e) {
+						edge_properties ep;
+						ep.strength = e->strength;
+						ep.from_degree = e->degree_from;
+						ep.to_degree = e->degree_to;
+						ep.weight = e->weight;
+						inserter(c, c.end()) = value_type(ep, properties(e->target));
+					}
+				}
+				return true;
+			}
+
+			// populates the graph with all the vertices and edges in the file
+			bool populate_full_graph(bool include_edges = true) {
+				const csr_file &f = index();
+				std::vector<Vertex> vertices(f.num_nodes());
+				for(index_type n = 0; n < f.num_nodes(); ++n) {
+					vertex_properties vp = properties(n);
+					std::pair<bool, Vertex> add = will_add_vertex(vp);
+					if (add.first) {
+						add.second = boost::add_vertex(vp, *this);
+						did_add_vertex(add.second, vp);
+					}
+					vertices[n] = add.second;
+				}
+
+				if (!include_edges) return true; // we're done
+
+				for(index_type n = 0; n < f.num_nodes(); ++n) {
+					for(const csr_file::edge_record *e = f.edges_begin(n); e != f.edges_end(n); ++e) {
+						edge_properties ep;
+						ep.strength = e->strength;
+						ep.from_degree = e->degree_from;
+						ep.to_degree = e->degree_to;
+						ep.weight = e->weight;
+						add_edge(vertices[n], vertices[e->target], ep, *this);
+					}
+				}
+				return true;
+			}
+
+			// the file holds just the one collection
+			template <class Inserter>
+			void get_collections_list(Inserter i) {
+				*i = index().collection();
+			}
+
+			// collection meta data functions
+			void set_meta_value(const std::string, const std::string) { read_only(); }
+
+			std::string get_meta_value(const std::string key, const std::string def = "") {
+				std::string value;
+				if (index().meta(key, value)) return value;
+				return def;
+			}
+
+			// out gets a std::pair<std::string, std::string> for each of them
+			template <class OutIterator>
+			void get_meta_values(OutIterator out) {
+				for(index_type m = 0; m < index().num_meta(); ++m) *out = index().meta(m);
+			}
+
+			// vertex meta data functions
+			void set_vertex_meta_value(const Vertex, const std::string, const std::string) { read_only(); }
+
+			std::string get_vertex_meta_value(const Vertex u, const std::string key, const std::string def = "") {
+				index_type n = index().find((*this)[u].id);
+				std::string value;
+				if (n != index().num_nodes() && index().vertex_meta(n, key, value)) return value;
+				return def;
+			}
+
+			// will populate out with std::pair<id_type, std::string> for each id in
+			// i -> i_end that has a `key` value
+			template <class IdIterator, class OutIterator>
+			void fetch_vertex_meta_values(IdIterator i, IdIterator i_end, const std::string key, OutIterator out) {
+				const csr_file &f = index();
+				std::string value;
+				for(; i != i_end; ++i) {
+					index_type n = f.find(*i);
+					if (n != f.num_nodes() && f.vertex_meta(n, key, value)) *out = std::make_pair((id_type)*i, value);
+				}
+			}
+
+			// the vertex meta data keys in use
+			template <class OutIterator>
+			void get_vertex_meta_keys(OutIterator out) {
+				for(index_type k = 0; k < index().num_meta_keys(); ++k) *out = index().meta_key(k);
+			}
+
+			// the version of the collection that was exported
+			std::string get_collection_version() {
+				return index().version();
+			}
+
+			void rename_collection(std::string, std::string) { read_only(); }
+			void remove_collection(std::string) { read_only(); }
+			void reset_collection() { read_only(); }
+			void reset_all_collections() { read_only(); }
+
+			// specific functions for this storage policy
+			void set_file(std::string file) {
+				m_file = file;
+				m_index.reset();
+			}
+
+			std::string get_file() { return m_file; }
+
+		private:
+			std::map<id_type, Vertex> m_id_vertex_cache;
+			std::string m_file;
+			csr_file::pointer m_index;
+			bool mirror_flag;
+
+			// the file, mapped the first time we need it
+#ifdef WIN32
+			const csr_file &index() throw (...) {
+#else
+			const csr_file &index() throw (CSRException) {
+#endif
+				if (!m_index) {
+					csr_file::pointer p = csr_file::open(m_file);
+					std::string name = get_property(*this, graph_name);
+					if (!name.empty() && name != p->collection())
+						throw CSRException("CSR index " + m_file + " holds collection '" + p->collection() + "', not '" + name + "'");
+					m_index = p;
+				}
+				return *m_index;
+			}
+
+			vertex_properties properties(index_type n) {
+				const csr_file::node_record &r = index().node(n);
+				vertex_properties p;
+				p.id = (id_type)r.id;
+				p.type_major = r.type_major;
+				p.type_minor = r.type_minor;
+				p.content = index().content(n);
+				p.in_db = true;
+				return p;
+			}
+
+			void read_only() {
+				throw CSRException("CSR index " + m_file + " is read-only");
+			}
+	};
+
+
+/* *******************************************************
+		EXPORTING
+
+		writes the collection `g` is opened on out to a CSR
+		file.  g can be a graph on any storage policy with
+		get_vertex_meta_keys() and get_meta_values() (SQLite and
+		MySQL both have them); it's cleared and the whole
+		collection is loaded into it, so don't hand it one that's
+		in use.
+   ******************************************************* */
+	template <class Graph>
+	void export_csr(Graph &g, const std::string &filename) {
+		typedef typename se_graph_traits<Graph>::vertex_id_type id_type;
+
+		g.clear();
+		g.populate_full_graph(true);
+
+		csr_builder b;
+		std::vector<id_type> ids;
+		std::set<int> types;
+		BGL_FORALL_VERTICES_T(u, g, Graph) {
+			id_type id = g.get_vertex_id(u);
+			ids.push_back(id);
+			types.insert(g[u].type_major);
+			b.add_vertex(id, g[u].type_major, g[u].type_minor, g[u].content);
+			BGL_FORALL_OUTEDGES_T(u, e, g, Graph) {
+				b.add_edge(id, g.get_vertex_id(target(e, g)), g[e].strength, g[e].from_degree, g[e].to_degree, g[e].weight);
+			}
+		}
+
+		for(std::set<int>::iterator t = types.begin(); t != types.end(); ++t) {
+			b.set_count_of_type(*t, g.get_vertex_count_of_type(*t));
+		}
+
+		// the vertex meta data, a few hundred vertices a query
+		std::vector<std::string> keys;
+		g.get_vertex_meta_keys(back_inserter(keys));
+		for(std::size_t k = 0; k < keys.size(); ++k) {
+			for(std::size_t i = 0; i < ids.size(); i += 500) {
+				std::vector<std::pair<id_type, std::string> > values;
+				g.fetch_vertex_meta_values(ids.begin() + i, ids.begin() + std::min(i + 500, ids.size()), keys[k], back_inserter(values));
+				for(std::size_t v = 0; v < values.size(); ++v) b.add_vertex_meta(values[v].first, keys[k], values[v].second);
+			}
+		}
+
+		std::vector<std::pair<std::string, std::string> > meta;
+		g.get_meta_values(back_inserter(meta));
+		for(std::size_t m = 0; m < meta.size(); ++m) b.add_meta(meta[m].first, meta[m].second);
+
+		b.save(filename, g.collection(), g.get_collection_version());
+		g.clear();
+	}
+
+} // namespace semantic
+
+#endif
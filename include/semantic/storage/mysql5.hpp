@@ -17,7 +17,12 @@ this follows the storage policy description found in docs/storage/policy.txt
 #include <mysql.h>
 #include <semantic/exception.hpp>
 #include <semantic/storage/base.hpp>
+#include <semantic/neighbor_cache.hpp>
+#include <semantic/content_id_cache.hpp>
+#include <semantic/weighting/precomputed.hpp>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 //#include <iostream>
 
 #ifndef __SEMANTIC_STORAGE_MYSQL5_HPP__
@@ -72,6 +77,11 @@ namespace semantic {
 		typedef storage_traits::vertex_properties_type vertex_properties;
 		typedef storage_traits::edge_properties_type edge_properties;
 		typedef storage_traits::vertex_id_type id_type;
+
+		typedef std::map<std::string, id_type> content_id_map;
+
+		// contents per query when looking up vertex ids by content
+		static const unsigned int content_batch_size = 500;
 		
 		public:
 			typedef SEBase base_type;
@@ -82,6 +92,10 @@ namespace semantic {
 				m_collection_id = (std::numeric_limits<id_type>::max)();
 				m_clear_all = false;
 				mirror_flag = false;
+				m_defer_cleanup = false;
+				m_cleanup_deferred = false;
+				m_caches_checked = false;
+				m_weight_column = -1;
 			}
 			~StoragePolicy() { disconnect(); }
 /*			template <class S, class B>
@@ -121,6 +135,12 @@ namespace semantic {
 			void set_mirror_changes_to_storage(bool b) { mirror_flag = b; }
 			bool get_mirror_changes_to_storage() { return mirror_flag; }
 			
+			// while this is on, commits don't call indexing_cleanup, and the
+			// first commit after it's turned off runs it in batch mode, over
+			// the whole collection.  for committing a lot of changes in pieces
+			void set_defer_indexing_cleanup(bool b) { m_defer_cleanup = b; }
+			bool get_defer_indexing_cleanup() { return m_defer_cleanup; }
+			
 			void commit_changes_to_storage() {
 				count_cache.clear();
 				synchronize();
@@ -187,6 +207,7 @@ namespace semantic {
 			void did_clear() {
 			    m_id_vertex_cache.clear();
 			    count_cache.clear();
+			    m_caches_checked = false;
 			    if (get_mirror_changes_to_storage()) m_clear_all = true;
 			}
 			
@@ -281,18 +302,69 @@ namespace semantic {
 #else
 			id_type fetch_vertex_id_by_content_and_type(std::string content, int type) throw(VertexContentNotFoundException) {
 #endif
-				id_type id;
-				std::string q = "select node.id from node, content where content.id = node.fk_content and node.type_major = " + to_string(type) + " and content.content = '" + escape(content) + "' and fk_collection=" + to_string(get_collection_id());
+				std::vector<std::pair<std::string, id_type> > found;
+				fetch_vertex_ids_by_content_and_type(&content, &content + 1, type, back_inserter(found));
+				if (found.empty()) throw VertexContentNotFoundException(content);
+				return found[0].second;
+			}
+			
+			// will populate out with std::pair<std::string, id_type> for each content in
+			// i -> i_end that has a vertex of this type, in the order they're given;
+			// contents are taken from the shared content_id_cache when they're there
+			// and the rest are looked up together
+			template <class ContentIterator, class OutIterator>
+			void fetch_vertex_ids_by_content_and_type(ContentIterator i, ContentIterator i_end, int type, OutIterator out) {
+				std::vector<std::string> contents(i, i_end);
+				if (contents.empty()) return;
 				
-				query(q);
+				content_id_map ids;
+				std::vector<std::string> missing;
+				content_id_cache<MySQL5StoragePolicy> &cache = content_id_cache<MySQL5StoragePolicy>::shared();
+				if (cache.enabled()) {
+					check_collection_version();
+					cache.find(cache_key(), type, contents.begin(), contents.end(), inserter(ids, ids.end()), back_inserter(missing));
+				} else {
+					missing = contents;
+				}
 				
-				MYSQL_RES *r = result();
-				MYSQL_ROW row = mysql_fetch_row(r);
-				if (!row) throw VertexContentNotFoundException(content);
-				id = strtoul(row[0], NULL, 10);
-				mysql_free_result(r);
+				if (!missing.empty()) {
+					std::sort(missing.begin(), missing.end());
+					missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+					content_id_map fetched;
+					fetch_vertex_ids_from_storage(missing.begin(), missing.end(), type, fetched);
+					cache.insert(cache_key(), type, missing.begin(), missing.end(), fetched);
+					ids.insert(fetched.begin(), fetched.end());
+				}
 				
-				return id;
+				for(std::vector<std::string>::iterator c = contents.begin(); c != contents.end(); ++c) {
+					typename content_id_map::iterator id = ids.find(*c);
+					if (id != ids.end()) *out = std::make_pair(id->first, id->second);
+				}
+			}
+			
+			// the same, straight from the database: a query for each batch of
+			// contents, filling in ids for the ones with a vertex
+			template <class ContentIterator>
+			void fetch_vertex_ids_from_storage(ContentIterator i, ContentIterator i_end, int type, content_id_map &ids) {
+				while (i != i_end) {
+					std::stringstream q;
+					q << "select c.content, n.id from content c" <<
+							" inner join node n on n.fk_content = c.id" <<
+							" where n.type_major = " << type << " and n.fk_collection = " << get_collection_id() <<
+							" and c.content in (";
+					for(unsigned int n = 0; i != i_end && n < content_batch_size; ++i, ++n) {
+						q << (n > 0 ? ",'" : "'") << escape(*i) << "'";
+					}
+					q << ")";
+					
+					query(q.str());
+					MYSQL_RES *r = result();
+					MYSQL_ROW row;
+					while((row = mysql_fetch_row(r))) {
+						ids[row[0]] = strtoul(row[1], NULL, 10);
+					}
+					mysql_free_result(r);
+				}
 			}
 			
 			traits::vertices_size_type get_vertex_count_of_type(int node_type) {
@@ -376,9 +448,36 @@ namespace semantic {
 			// - the neighbor list is a std::pair<edge_properties, vertex_properties>
 			//		(se_graph_traits::mapped_neighbor_list can be used)
 			// - this method will create an inserter() for each neighbor list (value_type of the Map)
+			// lists are taken from the shared neighbor_cache when they're there
 			template <class IdIterator, class Map>
 			bool fetch_vertex_neighbors(IdIterator i, IdIterator i_end, Map &m) {
 				if (i == i_end) return false;
+				
+				neighbor_cache<MySQL5StoragePolicy> &cache = neighbor_cache<MySQL5StoragePolicy>::shared();
+				if (!cache.enabled()) return fetch_vertex_neighbors_from_storage(i, i_end, m);
+				
+				std::string key = cache_key();
+				check_collection_version();
+				
+				std::vector<id_type> missing;
+				cache.find(key, i, i_end, m, back_inserter(missing));
+				if (missing.empty()) return true;
+				
+				typename traits::mapped_neighbor_list fetched;
+				fetch_vertex_neighbors_from_storage(missing.begin(), missing.end(), fetched);
+				cache.insert(key, missing.begin(), missing.end(), fetched);
+				
+				for(typename traits::mapped_neighbor_list::iterator f = fetched.begin(); f != fetched.end(); ++f) {
+					typename Map::value_type::second_type &c = m[f->first];
+					copy(f->second.begin(), f->second.end(), inserter(c, c.end()));
+				}
+				return true;
+			}
+			
+			// the same, straight from the database
+			template <class IdIterator, class Map>
+			bool fetch_vertex_neighbors_from_storage(IdIterator i, IdIterator i_end, Map &m) {
+				if (i == i_end) return false;
 				typedef typename Map::value_type::second_type container_type;
 				typedef typename container_type::value_type value_type;
 				BOOST_STATIC_ASSERT((boost::is_same<typename Map::key_type, id_type>::value));
@@ -386,7 +485,7 @@ namespace semantic {
 				std::stringstream q;
 				
 				q <<	"select q.fk_node_from, q.fk_node_to, q.strength, q.degree_from, q.degree_to," <<
-						" q.type_major, q.type_minor, c.content" <<
+						" q.type_major, q.type_minor, c.content, " << weight_column() <<
 						" from edge_query q" <<
 						" inner join node n on n.id = q.fk_node_to" <<
 						" left join content c on n.fk_content = c.id" <<
@@ -411,15 +510,58 @@ namespace semantic {
 					vp.type_major = atoi(row[5]);
 					vp.type_minor = atoi(row[6]);
 					vp.content = std::string(row[7]);
+					ep.weight = row[8] ? atof(row[8]) : -1;
 					
 					inserter(m[n_from], m[n_from].end()) = value_type(ep, vp);
 				}
 				
 				mysql_free_result(r);
-				
+
 				return true;
 			}
-			
+
+			// populates the graph with all the vertices and edges in the collection
+			bool populate_full_graph(bool include_edges = true) {
+				query("select n.id, n.type_major, n.type_minor, c.content from node n"
+					" left join content c on n.fk_content = c.id where n.fk_collection = " + to_string(get_collection_id()));
+
+				MYSQL_RES *r = result();
+				MYSQL_ROW row;
+				while((row = mysql_fetch_row(r))) {
+					vertex_properties p;
+					p.id = strtoul(row[0], NULL, 10);
+					p.type_major = atoi(row[1]);
+					p.type_minor = atoi(row[2]);
+					p.content = row[3] ? std::string(row[3]) : std::string();
+					p.in_db = true;
+
+					m_id_vertex_cache[p.id] = add_vertex(p, *this);
+				}
+				mysql_free_result(r);
+
+				if (!include_edges) return true; // we're done
+
+				query("select q.fk_node_from, q.fk_node_to, q.strength, q.degree_from, q.degree_to, " + weight_column() + " from edge_query q"
+					" inner join node n on n.id = q.fk_node_from where n.fk_collection = " + to_string(get_collection_id()));
+
+				r = result();
+				while((row = mysql_fetch_row(r))) {
+					typename std::map<id_type, Vertex>::iterator u = m_id_vertex_cache.find(strtoul(row[0], NULL, 10));
+					typename std::map<id_type, Vertex>::iterator v = m_id_vertex_cache.find(strtoul(row[1], NULL, 10));
+					if (u == m_id_vertex_cache.end() || v == m_id_vertex_cache.end()) continue;
+
+					edge_properties p;
+					p.strength = atoi(row[2]);
+					p.from_degree = atoi(row[3]);
+					p.to_degree = atoi(row[4]);
+					p.weight = row[5] ? atof(row[5]) : -1;
+					add_edge(u->second, v->second, p, *this);
+				}
+				mysql_free_result(r);
+
+				return true;
+			}
+
 			// vertex meta data functions
 			void set_vertex_meta_values(const std::map<Vertex, std::pair<std::string, std::string> > ){
 				// select id from node where fk_collection = collection_id
@@ -446,6 +588,38 @@ namespace semantic {
 				return value;
 			}
 			
+			// changes every time changes to the collection are committed. search_cache
+			// uses it to tell when the results it holds have gone stale.
+			std::string get_collection_version() {
+				query("SELECT concat(c.last_update, '/', coalesce(m.value, 0)) from collection c"
+					" left join collection_meta m on m.fk_collection = c.id and m.`key` = 'generation'"
+					" where c.id = " + to_string(get_collection_id()));
+				std::string version;
+				MYSQL_RES *r = result();
+				MYSQL_ROW row = mysql_fetch_row(r);
+				if (row && row[0]) version = row[0];
+				mysql_free_result(r);
+				return version;
+			}
+			
+			// will populate out with std::pair<id_type, std::string> for each id in
+			// i -> i_end that has a `key` value, in one query
+			template <class IdIterator, class OutIterator>
+			void fetch_vertex_meta_values(IdIterator i, IdIterator i_end, const std::string key, OutIterator out) {
+				if (i == i_end) return; // nothing to fetch!
+				std::stringstream q;
+				q << "SELECT fk_node, value from node_meta where `key`='" << escape(key) << "'" <<
+						" and fk_node in (" << join(i, i_end, ",") << ")";
+				
+				query(q.str());
+				MYSQL_RES *r = result();
+				MYSQL_ROW row;
+				while((row = mysql_fetch_row(r))) {
+					*out = std::make_pair((id_type)strtoul(row[0], NULL, 10), std::string(row[1]));
+				}
+				mysql_free_result(r);
+			}
+			
 			// renames a collection in the index from one thing to another,
 			// doesn't check for errors
 			void rename_collection(std::string oldname, std::string newname) {
@@ -500,6 +674,31 @@ namespace semantic {
 				return value;				
 			}
 			
+			// out gets a std::pair<std::string, std::string> for each of them
+			template <class OutIterator>
+			void get_meta_values(OutIterator out) {
+				query("SELECT `key`, value FROM collection_meta WHERE fk_collection = " + to_string(get_collection_id()));
+				MYSQL_RES *r = result();
+				MYSQL_ROW row;
+				while((row = mysql_fetch_row(r))) {
+					*out = std::make_pair(std::string(row[0]), std::string(row[1] ? row[1] : ""));
+				}
+				mysql_free_result(r);
+			}
+			
+			// the vertex meta data keys in use in this collection
+			template <class OutIterator>
+			void get_vertex_meta_keys(OutIterator out) {
+				query("SELECT distinct m.`key` FROM node_meta m INNER JOIN node n ON n.id = m.fk_node"
+					" WHERE n.fk_collection = " + to_string(get_collection_id()));
+				MYSQL_RES *r = result();
+				MYSQL_ROW row;
+				while((row = mysql_fetch_row(r))) {
+					*out = std::string(row[0]);
+				}
+				mysql_free_result(r);
+			}
+			
 			template <class Inserter>
 			void get_collections_list(Inserter i) {
 				query("select name from collection");
@@ -542,10 +741,12 @@ namespace semantic {
 				if (m_con == NULL) return; // not connected
 				mysql_close(m_con);
 				m_con = NULL;
+				m_weight_column = -1;
 			}
 			
 		protected:
 			bool mirror_flag;
+			bool m_defer_cleanup, m_cleanup_deferred;
 			
 			void synchronize() {
 				// synchronize what we have stored here with the database!
@@ -655,11 +856,114 @@ namespace semantic {
 			
 				
 				// perform cleanup
-				query("call indexing_cleanup (" + to_string(collection) + ")");
+				if (m_defer_cleanup) {
+					m_cleanup_deferred = true;
+				} else {
+					if (m_cleanup_deferred) {
+						// the dirty nodes piled up since are all of them, near enough
+						query("set @batch_mode = 1");
+						query("delete from dirty_node where fk_node in (select id from node where fk_collection = " + to_string(collection) + ")");
+						m_cleanup_deferred = false;
+					}
+					query("call indexing_cleanup (" + to_string(collection) + ")");
+					update_edge_weights(collection);
+				}
+				
+				// new version of the collection, for anyone holding on to search results
+				query("update collection set last_update = now() where id = " + to_string(collection));
+				query("INSERT INTO collection_meta (fk_collection, `key`, value) VALUES (" + to_string(collection) + ", 'generation', '1')"
+					" ON DUPLICATE KEY UPDATE value = value + 1");
 				query("commit");
+				neighbor_cache<MySQL5StoragePolicy>::shared().invalidate(cache_key());
+				content_id_cache<MySQL5StoragePolicy>::shared().invalidate(cache_key());
+				m_caches_checked = false;
 				query("set @batch_mode = NULL");
 			}
 			
+			// fills in edge_query's weight column (see weighting/precomputed.hpp).
+			// indexing_cleanup leaves it null in the rows it writes, and a weight also
+			// depends on the node count of the source's type, so when a count changed
+			// every row leading out of that type is weighed again - as is everything
+			// when the collection's weighting changed
+			void update_edge_weights(id_type collection) {
+				if (!has_weight_column()) return; // tables from before there were weights
+				std::string c = to_string(collection);
+				edge_weight_function f = weighting_registry::shared().find(get_meta_value("weighting", weighting_registry::default_name()));
+				std::string name = f ? get_meta_value("weighting", weighting_registry::default_name()) : "";
+				
+				std::map<int, long> counts;
+				query("select type_major, count from node_count where fk_collection = " + c);
+				MYSQL_RES *r = result();
+				MYSQL_ROW row;
+				while((row = mysql_fetch_row(r))) counts[atoi(row[0])] = atol(row[1]);
+				mysql_free_result(r);
+				
+				std::string old_name = get_meta_value("edge_weights");
+				std::map<int, long> old_counts;
+				std::stringstream in(get_meta_value("edge_weight_counts"));
+				int type; long count; char colon;
+				while (in >> type >> colon >> count) old_counts[type] = count;
+				
+				std::stringstream out;
+				for(std::map<int, long>::iterator i = counts.begin(); i != counts.end(); ++i) {
+					out << i->first << ":" << i->second << " ";
+				}
+				
+				if (name != old_name) {
+					query("update edge_query set weight = NULL where fk_collection = " + c);
+				} else if (out.str() != get_meta_value("edge_weight_counts")) {
+					for(std::map<int, long>::iterator i = counts.begin(); i != counts.end(); ++i) {
+						if (old_counts.count(i->first) && old_counts[i->first] == i->second) continue;
+						query("update edge_query q inner join node n on n.id = q.fk_node_from set q.weight = NULL"
+							" where n.fk_collection = " + c + " and n.type_major = " + to_string(i->first));
+					}
+				}
+				// (set_meta_value won't overwrite)
+				query("INSERT INTO collection_meta (fk_collection, `key`, value) VALUES (" + c + ", 'edge_weights', '" + escape(name) + "'), ("
+					+ c + ", 'edge_weight_counts', '" + out.str() + "') ON DUPLICATE KEY UPDATE value = VALUES(value)");
+				if (!f) return;
+				
+				// work out the missing weights here, and write them back in batches
+				std::vector<std::pair<std::string, double> > weights;
+				query("select q.id, q.strength, q.degree_from, q.degree_to, nc.count from edge_query q"
+					" inner join node n on n.id = q.fk_node_from"
+					" inner join node_count nc on nc.fk_collection = n.fk_collection and nc.type_major = n.type_major"
+					" where q.fk_collection = " + c + " and q.weight is NULL");
+				r = result();
+				while((row = mysql_fetch_row(r))) {
+					weights.push_back(std::make_pair(std::string(row[0]),
+						f(atoi(row[1]), strtoul(row[2], NULL, 10), strtoul(row[3], NULL, 10), strtoul(row[4], NULL, 10))));
+				}
+				mysql_free_result(r);
+				
+				for(std::size_t i = 0; i < weights.size(); i += 1000) {
+					std::stringstream cases, ids;
+					cases.precision(17);
+					for(std::size_t j = i; j < weights.size() && j < i + 1000; j++) {
+						cases << " when " << weights[j].first << " then " << weights[j].second;
+						ids << (j == i ? "" : ",") << weights[j].first;
+					}
+					query("update edge_query set weight = case id" + cases.str() + " end where id in (" + ids.str() + ")");
+				}
+			}
+			
+			// edge_query has had a weight column since the weights were precomputed -
+			// databases set up before then do without
+			bool has_weight_column() {
+				if (m_weight_column == -1) {
+					query("show columns from edge_query like 'weight'");
+					MYSQL_RES *r = result_store();
+					m_weight_column = mysql_num_rows(r) > 0 ? 1 : 0;
+					mysql_free_result(r);
+				}
+				return m_weight_column == 1;
+			}
+			
+			// what to select for an edge_query row's weight
+			std::string weight_column() {
+				return has_weight_column() ? "q.weight" : "NULL";
+			}
+			
 			void do_batch_edges(std::vector<std::string> &to_add) {
 				if (to_add.empty()) return;
 				std::string q = "insert into edge (fk_node_from, fk_node_to, strength) values " + join(to_add.begin(), to_add.end(), ",") + " on duplicate key update strength=VALUES(strength)";
@@ -740,6 +1044,26 @@ namespace semantic {
 			std::string m_socket;
 			
 			MYSQL *m_con;
+			
+			bool m_caches_checked;
+			
+			// whether edge_query has a weight column (-1 until we've looked)
+			int m_weight_column;
+			
+			// what our entries are filed under in the shared neighbor_cache
+			// and content_id_cache
+			std::string cache_key() {
+				return m_host + "/" + m_database + "\n" + get_property(*this, graph_name);
+			}
+
+			// once a search, see if somebody else has changed the collection
+			void check_collection_version() {
+				if (m_caches_checked) return;
+				std::string version = get_collection_version();
+				neighbor_cache<MySQL5StoragePolicy>::shared().validate(cache_key(), version);
+				content_id_cache<MySQL5StoragePolicy>::shared().validate(cache_key(), version);
+				m_caches_checked = true;
+			}
 	};
 } // namespace semantic
 
@@ -5,6 +5,7 @@ this follows the storage policy description found in docs/storage/policy.txt
 */
 
 #include <map>
+#include <string>
 #include <semantic/properties.hpp>
 
 #ifndef __SEMANTIC_STORAGE_NONE_HPP__
@@ -40,6 +41,8 @@ namespace semantic {
 			// methods having to do directly with this storage policy implementation
 			void set_mirror_changes_to_storage(bool b) { if (!b) { adjust_edge_degrees(); count_cache.clear(); } mirror_flag = b; }
 			bool get_mirror_changes_to_storage() { return mirror_flag; }
+			void set_defer_indexing_cleanup(bool) {} // nothing to clean up
+			bool get_defer_indexing_cleanup() { return false; }
 			void commit_changes_to_storage() {} // do nothing
 			
 			// methods having to do with structure alteration to the graph
@@ -81,6 +84,16 @@ namespace semantic {
 				return cnt;
 			}
 			
+			// collection meta data, for as long as we're around
+			void set_meta_value(const std::string key, const std::string value) {
+				meta[key] = value;
+			}
+
+			std::string get_meta_value(const std::string key, const std::string def = "") {
+				std::map<std::string, std::string>::const_iterator m = meta.find(key);
+				return m == meta.end() ? def : m->second;
+			}
+
 			void rename_collection(std::string, std::string) {}
 			void remove_collection(std::string) {}
 			void reset_collection(){}
@@ -98,6 +111,7 @@ namespace semantic {
 		
 		private:
 			std::map<int, traits::vertices_size_type> count_cache;
+			std::map<std::string, std::string> meta;
 	};
 } // namespace semantic
 
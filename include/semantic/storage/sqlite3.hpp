@@ -7,11 +7,17 @@ this follows the storage policy description found in docs/storage/policy.txt
 #if SEMANTIC_HAVE_SQLITE3
 
 #include <map>
+#include <set>
 #include <semantic/properties.hpp>
 #include <sqlite3.h>
 #include <semantic/exception.hpp>
 #include <semantic/storage/base.hpp>
+#include <semantic/neighbor_cache.hpp>
+#include <semantic/content_id_cache.hpp>
+#include <semantic/weighting/precomputed.hpp>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 #include <iostream>
 
 #include <boost/algorithm/string/split.hpp>
@@ -74,18 +80,43 @@ namespace semantic {
 		typedef typename storage_traits::vertex_properties_type vertex_properties;
 		typedef typename storage_traits::edge_properties_type edge_properties;
 		typedef typename storage_traits::vertex_id_type id_type;
-		
+
+		typedef std::map<std::string, sqlite3_stmt *> statement_cache;
+
+		typedef std::map<std::string, id_type> content_id_map;
+
+		// contents per query when looking up vertex ids by content
+		static const unsigned int content_batch_size = 500;
+
+		// one pending row for the edge table
+		struct edge_row {
+			id_type from, to;
+			int strength;
+		};
+
+		// rows per batched edge insert - 3 parameters each keeps us well under
+		// sqlite's default limits on host parameters and compound selects
+		static const unsigned int edge_batch_size = 100;
+
 		public:
 			typedef SEBase base_type;
 			
 			// constructor(s)
-			StoragePolicy() : m_clear_all(false), m_con(NULL), m_connected(false), m_collection_id((std::numeric_limits<id_type>::max)()), mirror_flag(false) {  }
+			StoragePolicy() : m_clear_all(false), m_con(NULL), m_connected(false), m_collection_id((std::numeric_limits<id_type>::max)()), mirror_flag(false), m_defer_cleanup(false), m_caches_checked(false), m_edge_weight(NULL), m_weight_column(-1) {  }
 			~StoragePolicy() { close(); }
 	
 			// methods having to do directly with this storage policy implementation
 			void set_mirror_changes_to_storage(bool b) { mirror_flag = b; }
 			bool get_mirror_changes_to_storage() { return mirror_flag; }
 			
+			// while this is on, commits leave node_count, degree and edge_query
+			// alone, and the first commit after it's turned off rebuilds them
+			// for the whole collection.  for committing a lot of changes in
+			// pieces, where bringing them up to date each time would cost the
+			// size of the collection each time
+			void set_defer_indexing_cleanup(bool b) { m_defer_cleanup = b; }
+			bool get_defer_indexing_cleanup() { return m_defer_cleanup; }
+			
 			void commit_changes_to_storage() {
 				count_cache.clear();
 				synchronize();
@@ -146,6 +177,7 @@ namespace semantic {
 			void did_clear() { 
 			    m_id_vertex_cache.clear(); 
 			    count_cache.clear(); 
+			    m_caches_checked = false;
 			    if (get_mirror_changes_to_storage()) m_clear_all = true; 
 			}
 			
@@ -241,16 +273,87 @@ namespace semantic {
 #else
 			id_type fetch_vertex_id_by_content_and_type(std::string content, int type) throw(VertexContentNotFoundException) {
 #endif
-				id_type id;
-				std::string q = "select node.id from node, content where content.id = node.fk_content and node.type_major = " + to_string(type) + " and content.content = '" + escape(content) + "' and fk_collection=" + to_string(get_collection_id());
+				std::vector<std::pair<std::string, id_type> > found;
+				fetch_vertex_ids_by_content_and_type(&content, &content + 1, type, back_inserter(found));
+				if (found.empty()) throw VertexContentNotFoundException(content);
+				return found[0].second;
+			}
+			
+			// will populate out with std::pair<std::string, id_type> for each content in
+			// i -> i_end that has a vertex of this type, in the order they're given;
+			// contents are taken from the shared content_id_cache when they're there
+			// and the rest are looked up together
+			template <class ContentIterator, class OutIterator>
+			void fetch_vertex_ids_by_content_and_type(ContentIterator i, ContentIterator i_end, int type, OutIterator out) {
+				std::vector<std::string> contents(i, i_end);
+				if (contents.empty()) return;
 				
-				query(q);
+				content_id_map ids;
+				std::vector<std::string> missing;
+				content_id_cache<SQLite3StoragePolicy> &cache = content_id_cache<SQLite3StoragePolicy>::shared();
+				if (cache.enabled()) {
+					check_collection_version();
+					cache.find(cache_key(), type, contents.begin(), contents.end(), inserter(ids, ids.end()), back_inserter(missing));
+				} else {
+					missing = contents;
+				}
 				
-				if (rows() < 1) throw VertexContentNotFoundException(content);
-				id = strtoul(field(0,0), NULL, 10);
-				free();
+				if (!missing.empty()) {
+					std::sort(missing.begin(), missing.end());
+					missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+					content_id_map fetched;
+					fetch_vertex_ids_from_storage(missing.begin(), missing.end(), type, fetched);
+					cache.insert(cache_key(), type, missing.begin(), missing.end(), fetched);
+					ids.insert(fetched.begin(), fetched.end());
+				}
 				
-				return id;
+				for(std::vector<std::string>::iterator c = contents.begin(); c != contents.end(); ++c) {
+					typename content_id_map::iterator id = ids.find(*c);
+					if (id != ids.end()) *out = std::make_pair(id->first, id->second);
+				}
+			}
+			
+			// the same, straight from the database: a query for each batch of
+			// contents, filling in ids for the ones with a vertex.  (sqlite
+			// walks the collection's nodes of this type once per query either
+			// way; matching them against the batch's content ids, rather than
+			// joining and then matching content, saves fetching content rows
+			// for all the nodes that aren't wanted).  every batch binds
+			// content_batch_size contents so they all share one cached statement;
+			// a short last batch repeats its first content to fill up
+			template <class ContentIterator>
+			void fetch_vertex_ids_from_storage(ContentIterator i, ContentIterator i_end, int type, content_id_map &ids) {
+				std::string q = "select c.content, n.id from node n"
+						" inner join content c on c.id = n.fk_content"
+						" where n.type_major = ? and n.fk_collection = ?"
+						" and n.fk_content in (select id from content where content in (?";
+				for(unsigned int n = 1; n < content_batch_size; ++n) q += ",?";
+				q += "))";
+				sqlite3_stmt *stmt = statement(q);
+				id_type cid = get_collection_id();
+				
+				std::vector<std::string> batch;
+				batch.reserve(content_batch_size);
+				while (i != i_end) {
+					batch.clear();
+					for(; i != i_end && batch.size() < content_batch_size; ++i) batch.push_back(*i);
+					
+					sqlite3_bind_int(stmt, 1, type);
+					sqlite3_bind_int64(stmt, 2, (sqlite_int64)cid);
+					for(unsigned int n = 0; n < content_batch_size; ++n) {
+						const std::string &content = batch[n < batch.size() ? n : 0];
+						sqlite3_bind_text(stmt, n + 3, content.data(), (int)content.size(), SQLITE_STATIC);
+					}
+					
+					try {
+						while (step(stmt) == SQLITE_ROW) {
+							ids[column_string(stmt, 0)] = (id_type)sqlite3_column_int64(stmt, 1);
+						}
+					} catch (...) {
+						sqlite3_reset(stmt);
+						throw;
+					}
+				}
 			}
 			
 			traits::vertices_size_type get_vertex_count_of_type(int node_type) {
@@ -328,9 +431,36 @@ namespace semantic {
 			// - the neighbor list is a std::pair<edge_properties, vertex_properties>
 			//		(se_graph_traits::mapped_neighbor_list can be used)
 			// - this method will create an inserter() for each neighbor list (value_type of the Map)
+			// lists are taken from the shared neighbor_cache when they're there
 			template <class IdIterator, class Map>
 			bool fetch_vertex_neighbors(IdIterator i, IdIterator i_end, Map &m) {
 				if (i == i_end) return false;
+				
+				neighbor_cache<SQLite3StoragePolicy> &cache = neighbor_cache<SQLite3StoragePolicy>::shared();
+				if (!cache.enabled()) return fetch_vertex_neighbors_from_storage(i, i_end, m);
+				
+				std::string key = cache_key();
+				check_collection_version();
+				
+				std::vector<id_type> missing;
+				cache.find(key, i, i_end, m, back_inserter(missing));
+				if (missing.empty()) return true;
+				
+				typename traits::mapped_neighbor_list fetched;
+				fetch_vertex_neighbors_from_storage(missing.begin(), missing.end(), fetched);
+				cache.insert(key, missing.begin(), missing.end(), fetched);
+				
+				for(typename traits::mapped_neighbor_list::iterator f = fetched.begin(); f != fetched.end(); ++f) {
+					typename Map::value_type::second_type &c = m[f->first];
+					copy(f->second.begin(), f->second.end(), inserter(c, c.end()));
+				}
+				return true;
+			}
+			
+			// the same, straight from the database
+			template <class IdIterator, class Map>
+			bool fetch_vertex_neighbors_from_storage(IdIterator i, IdIterator i_end, Map &m) {
+				if (i == i_end) return false;
 				typedef typename Map::value_type::second_type container_type;
 				typedef typename container_type::value_type value_type;
 				BOOST_STATIC_ASSERT((boost::is_same<typename Map::key_type, id_type>::value));
@@ -338,35 +468,38 @@ namespace semantic {
 				std::stringstream q;
 				 
 				q <<	"select q.fk_node_from, q.fk_node_to, q.strength, q.degree_from, q.degree_to," <<
-						" q.type_major, q.type_minor, c.content" <<
+						" q.type_major, q.type_minor, c.content, " << weight_column() <<
 						" from edge_query q" <<
 						" inner join node n on n.id = q.fk_node_to" <<
 						" left join content c on n.fk_content = c.id" <<
 						" where fk_node_from in (" << join(i, i_end, ",") << ")";
 				
-				// query!
-				query(q.str());
-				
-//				std::cout << "got " << rows() << " rows back..." << std::endl; // debug
-				
-				for(int row = 0; row < rows(); row++) {
-					edge_properties ep;
-					vertex_properties vp;
-					
-					id_type n_from = strtoul(field(row, 0), NULL, 10);
-					vp.id = strtoul(field(row, 1), NULL, 10);
-					vp.in_db = true;
-					ep.strength = atoi(field(row, 2));
-					ep.from_degree = atoi(field(row, 3));
-					ep.to_degree = atoi(field(row, 4));
-					vp.type_major = atoi(field(row, 5));
-					vp.type_minor = atoi(field(row, 6));
-					vp.content = std::string(field(row, 7));
-					
-					inserter(m[n_from], m[n_from].end()) = value_type(ep, vp); 
+				// query!  (stepped rather than through query(), whose text
+				// columns would round the weights)
+				sqlite3_stmt *stmt = prepare(q.str());
+				try {
+					while (step(stmt) == SQLITE_ROW) {
+						edge_properties ep;
+						vertex_properties vp;
+						
+						id_type n_from = (id_type)sqlite3_column_int64(stmt, 0);
+						vp.id = (id_type)sqlite3_column_int64(stmt, 1);
+						vp.in_db = true;
+						ep.strength = sqlite3_column_int(stmt, 2);
+						ep.from_degree = sqlite3_column_int(stmt, 3);
+						ep.to_degree = sqlite3_column_int(stmt, 4);
+						vp.type_major = sqlite3_column_int(stmt, 5);
+						vp.type_minor = sqlite3_column_int(stmt, 6);
+						vp.content = column_string(stmt, 7);
+						ep.weight = column_weight(stmt, 8);
+						
+						inserter(m[n_from], m[n_from].end()) = value_type(ep, vp); 
+					}
+				} catch (SQLiteException &e) {
+					sqlite3_finalize(stmt);
+					throw;
 				}
-				
-				free();
+				sqlite3_finalize(stmt);
 				
 				return true;
 			}
@@ -393,29 +526,36 @@ namespace semantic {
 				if (!include_edges) return true; // we're done
 				
 				// now do the edges
-				query("select q.fk_node_from, q.fk_node_to, q.strength, q.degree_from, q.degree_to from edge_query q inner join node n on n.id = q.fk_node_from where n.fk_collection = " + to_string(get_collection_id()));
+				// (stepped, like fetch_vertex_neighbors_from_storage, for the weights)
+				sqlite3_stmt *stmt = prepare("select q.fk_node_from, q.fk_node_to, q.strength, q.degree_from, q.degree_to, " + weight_column() + " from edge_query q inner join node n on n.id = q.fk_node_from where n.fk_collection = " + to_string(get_collection_id()));
 				// process
-				for(int i = 0; i < rows(); i++) {
-					edge_properties p;
-					id_type n_from, n_to;
-					Vertex u, v;
-					n_from = strtoul(field(i, 0), NULL, 10);
-					n_to = strtoul(field(i, 1), NULL, 10);
-					p.strength = atoi(field(i, 2));
-					p.from_degree = atoi(field(i, 3));
-					p.to_degree = atoi(field(i, 4));
-					
-					try {
-						// try to do this, ignore if we can't find the vertex
-						u = vertex_by_id(n_from);
-						v = vertex_by_id(n_to);
-						add_edge(u, v, p, *this); // add the edge
-					} catch (VertexNotFoundException<id_type> e) {
-//						std::cout << "exception: " << n_from << " " << n_to << " " << e.what() << std::endl;
-						continue;
+				try {
+					while (step(stmt) == SQLITE_ROW) {
+						edge_properties p;
+						id_type n_from, n_to;
+						Vertex u, v;
+						n_from = (id_type)sqlite3_column_int64(stmt, 0);
+						n_to = (id_type)sqlite3_column_int64(stmt, 1);
+						p.strength = sqlite3_column_int(stmt, 2);
+						p.from_degree = sqlite3_column_int(stmt, 3);
+						p.to_degree = sqlite3_column_int(stmt, 4);
+						p.weight = column_weight(stmt, 5);
+						
+						try {
+							// try to do this, ignore if we can't find the vertex
+							u = vertex_by_id(n_from);
+							v = vertex_by_id(n_to);
+							add_edge(u, v, p, *this); // add the edge
+						} catch (VertexNotFoundException<id_type> e) {
+//							std::cout << "exception: " << n_from << " " << n_to << " " << e.what() << std::endl;
+							continue;
+						}
 					}
+				} catch (SQLiteException &e) {
+					sqlite3_finalize(stmt);
+					throw;
 				}
-				free();
+				sqlite3_finalize(stmt);
 				
 				// done.
 				return true;
@@ -460,6 +600,16 @@ namespace semantic {
 				return value;				
 			}
 						
+			// out gets a std::pair<std::string, std::string> for each of them
+			template <class OutIterator>
+			void get_meta_values(OutIterator out) {
+				query("select key, value from collection_meta where fk_collection = " + to_string(get_collection_id()));
+				for(int row = 0; row < rows(); row++) {
+					*out = std::make_pair(std::string(field(row, 0)), std::string(field(row, 1) ? field(row, 1) : ""));
+				}
+				free();
+			}
+			
 			// vertex meta data functions
 			void set_vertex_meta_value(const Vertex u, const std::string key, const std::string value) {
 				query("insert or replace into node_meta (fk_node, key, value) values ("
@@ -477,6 +627,46 @@ namespace semantic {
 				return value;
 			}
 			
+			// changes every time changes to the collection are committed. search_cache
+			// uses it to tell when the results it holds have gone stale.
+			std::string get_collection_version() {
+				query("select c.last_update || '/' || coalesce(m.value, 0) from collection c"
+					" left join collection_meta m on m.fk_collection = c.id and m.key = 'generation'"
+					" where c.id = " + to_string(get_collection_id()));
+				std::string version;
+				if (rows() > 0 && field(0,0)) version = field(0,0);
+				free();
+				
+				return version;
+			}
+			
+			// will populate out with std::pair<id_type, std::string> for each id in
+			// i -> i_end that has a `key` value, in one query
+			template <class IdIterator, class OutIterator>
+			void fetch_vertex_meta_values(IdIterator i, IdIterator i_end, const std::string key, OutIterator out) {
+				if (i == i_end) return; // nothing to fetch!
+				std::stringstream q;
+				q << "select fk_node, value from node_meta where key='" << escape(key) << "'" <<
+						" and fk_node in (" << join(i, i_end, ",") << ")";
+				
+				query(q.str());
+				for(int row = 0; row < rows(); row++) {
+					*out = std::make_pair((id_type)strtoul(field(row, 0), NULL, 10), std::string(field(row, 1)));
+				}
+				free();
+			}
+			
+			// the vertex meta data keys in use in this collection
+			template <class OutIterator>
+			void get_vertex_meta_keys(OutIterator out) {
+				query("select distinct m.key from node_meta m inner join node n on n.id = m.fk_node"
+					" where n.fk_collection = " + to_string(get_collection_id()));
+				for(int row = 0; row < rows(); row++) {
+					*out = std::string(field(row, 0));
+				}
+				free();
+			}
+			
 			// specific functions for this storage policy
 #ifdef WIN32
 			void open() throw (...) {
@@ -484,7 +674,9 @@ namespace semantic {
 			void open() throw (SQLiteException) {
 #endif
 				if (m_connected) return; // already opened
+				finalize_statements(); // left over from a connection that errored out
 				m_connected = true;
+				m_weight_column = -1;
 				m_con = NULL;
 				int result = sqlite3_open(m_file.c_str(), &m_con);
 				// std::cerr << this << " opening new sqlite connection: " << m_file << std::endl;
@@ -508,7 +700,7 @@ namespace semantic {
 					queries.push_back("CREATE TABLE 'degree' ( 'fk_node' integer, 'type_major' integer, 'degree' integer, PRIMARY KEY ('fk_node','type_major') )");
 					queries.push_back("CREATE TABLE 'content' ( 'id' integer primary key, 'content' text unique )");
 					queries.push_back("CREATE TABLE 'edge' ( 'id' integer primary key, 'fk_node_from' integer, 'fk_node_to' integer, 'strength' real, UNIQUE ('fk_node_from','fk_node_to') )");
-					queries.push_back("CREATE TABLE 'edge_query' ( 'id' integer primary key, 'fk_collection' integer, 'fk_node_from' integer, 'fk_node_to' integer, 'strength' integer, 'degree_from' integer, 'degree_to' integer, 'type_major' integer, 'type_minor' integer, UNIQUE ('fk_node_from', 'fk_node_to') )");
+					queries.push_back("CREATE TABLE 'edge_query' ( 'id' integer primary key, 'fk_collection' integer, 'fk_node_from' integer, 'fk_node_to' integer, 'strength' integer, 'degree_from' integer, 'degree_to' integer, 'type_major' integer, 'type_minor' integer, 'weight' real, UNIQUE ('fk_node_from', 'fk_node_to') )");
 					queries.push_back("CREATE TABLE 'node' ( 'id' integer primary key, 'fk_collection' integer, 'type_major' integer, 'type_minor' integer, 'fk_content' integer, UNIQUE('fk_collection', 'type_major', 'type_minor', 'fk_content') )");
 					queries.push_back("CREATE TABLE 'node_count' ( 'fk_collection' integer, 'type_major' integer, 'count' integer, PRIMARY KEY ('fk_collection','type_major') )");
 					queries.push_back("CREATE TABLE 'node_meta' ( 'fk_node' integer, 'key' text, 'value' text, UNIQUE('fk_node','key') )");
@@ -527,6 +719,7 @@ namespace semantic {
 						
 			void close() {
 				if (!m_connected) return; // not opened
+				finalize_statements();
 				sqlite3_close(m_con);
 //				std::cerr << "closing connection." << std::endl;
 				m_con = NULL;
@@ -556,147 +749,531 @@ namespace semantic {
 			std::string get_file() { return m_file; }
 			
 		protected:
-			id_type create_content_row(std::string content) {
-				query("insert or ignore into content (content) values ('" + escape(content) + "')");
-				query("select id from content where content = '" + escape(content) + "'");
-				id_type id = strtoul(field(0,0), NULL, 10);
-				free();
+			id_type create_content_row(const std::string &content) {
+				// most content is new during indexing, so try the insert first and
+				// only fall back to a lookup when the row was already there
+				sqlite3_stmt *ins = statement("insert or ignore into content (content) values (?)");
+				sqlite3_bind_text(ins, 1, content.data(), (int)content.size(), SQLITE_TRANSIENT);
+				step(ins);
+				if (sqlite3_changes(m_con) > 0) return (id_type)sqlite3_last_insert_rowid(m_con);
+				
+				sqlite3_stmt *sel = statement("select id from content where content = ?");
+				sqlite3_bind_text(sel, 1, content.data(), (int)content.size(), SQLITE_TRANSIENT);
+				if (step(sel) != SQLITE_ROW) {
+					sqlite3_reset(sel);
+					throw SQLiteException("unable to find content row for '" + content + "'");
+				}
+				id_type id = (id_type)sqlite3_column_int64(sel, 0);
+				sqlite3_reset(sel);
 				return id;
 			}
 			
-			id_type create_node(int collection, int type_major, int type_minor, id_type content_id) {
-				id_type id;
-				query("select id from node where fk_collection = " + to_string(collection)
-					+ " and type_major = " + to_string(type_major) + " and type_minor = " + to_string(type_minor) + " and fk_content = " + to_string(content_id));
-				if (rows() > 0) {
-					// we have it already
-					id = strtoul(field(0,0), NULL, 10);
-					free();
-				} else {
-					free();
-					query("insert into node (fk_collection, type_major, type_minor, fk_content) values ("
-						+ to_string(collection) + ", " + to_string(type_major) + ", " 
-						+ to_string(type_minor) + ", " + to_string(content_id) + ")");
-					id = (id_type)sqlite3_last_insert_rowid(m_con);
-				}
+			id_type create_node(id_type collection, int type_major, int type_minor, id_type content_id) {
+				// same trick as above, the unique key on node does the existence check for us
+				sqlite3_stmt *ins = statement("insert or ignore into node (fk_collection, type_major, type_minor, fk_content) values (?, ?, ?, ?)");
+				sqlite3_bind_int64(ins, 1, (sqlite_int64)collection);
+				sqlite3_bind_int(ins, 2, type_major);
+				sqlite3_bind_int(ins, 3, type_minor);
+				sqlite3_bind_int64(ins, 4, (sqlite_int64)content_id);
+				step(ins);
+				if (sqlite3_changes(m_con) > 0) return (id_type)sqlite3_last_insert_rowid(m_con);
 				
+				sqlite3_stmt *sel = statement("select id from node where fk_collection = ? and type_major = ? and type_minor = ? and fk_content = ?");
+				sqlite3_bind_int64(sel, 1, (sqlite_int64)collection);
+				sqlite3_bind_int(sel, 2, type_major);
+				sqlite3_bind_int(sel, 3, type_minor);
+				sqlite3_bind_int64(sel, 4, (sqlite_int64)content_id);
+				if (step(sel) != SQLITE_ROW) {
+					sqlite3_reset(sel);
+					throw SQLiteException("unable to find node row for content " + to_string(content_id));
+				}
+				id_type id = (id_type)sqlite3_column_int64(sel, 0);
+				sqlite3_reset(sel);
 				return id;
 			}
 			
-			void indexing_cleanup(id_type collection) {
-				// first delete all the edge_query nodes that belong to this collection
-				query("delete from edge_query where fk_collection = " + to_string(collection));
+			void update_node(id_type id, int type_major, int type_minor, id_type content_id) {
+				sqlite3_stmt *upd = statement("update node set type_major = ?, type_minor = ?, fk_content = ? where id = ?");
+				sqlite3_bind_int(upd, 1, type_major);
+				sqlite3_bind_int(upd, 2, type_minor);
+				sqlite3_bind_int64(upd, 3, (sqlite_int64)content_id);
+				sqlite3_bind_int64(upd, 4, (sqlite_int64)id);
+				step(upd);
+			}
+			
+			// writes a batch of (from, to, strength) rows with a single statement.  sqlite
+			// won't take a multi-row VALUES list, but a compound select does the same job.
+			void insert_edge_batch(const std::vector<edge_row> &batch, unsigned int offset, unsigned int count) {
+				sqlite3_stmt *ins = statement(edge_batch_sql(count));
+				for(unsigned int i = 0; i < count; i++) {
+					const edge_row &r = batch[offset+i];
+					sqlite3_bind_int64(ins, i*3+1, (sqlite_int64)r.from);
+					sqlite3_bind_int64(ins, i*3+2, (sqlite_int64)r.to);
+					sqlite3_bind_int(ins, i*3+3, r.strength);
+				}
+				step(ins);
+			}
+			
+			std::string edge_batch_sql(unsigned int count) {
+				std::string q = "insert or replace into edge (fk_node_from, fk_node_to, strength)";
+				for(unsigned int i = 0; i < count; i++) {
+					q += (i == 0 ? " select ?, ?, ?" : " union all select ?, ?, ?");
+				}
+				return q;
+			}
+			
+			// makes sure the indexes and scratch tables the incremental cleanup relies on
+			// exist - older index files were created without them
+			void prepare_cleanup_schema() {
+				query("create index if not exists edge_fk_node_to on edge (fk_node_to)");
+				query("create index if not exists degree_type_major_degree on degree (type_major, degree)");
 				
-				// update node counts
-				query("delete from node_count");
-				query("insert into node_count select fk_collection, type_major, count(id) from node group by fk_collection, type_major");
+				// nodes whose out edges changed during this synchronize
+				query("create temp table if not exists dirty_node (fk_node integer primary key)");
+				// nodes whose incoming edge_query rows have to be looked at again
+				query("create temp table if not exists dirty_target (fk_node integer primary key)");
+				query("delete from dirty_node");
+				query("delete from dirty_target");
+				
+				// the precomputed edge weights (see weighting/precomputed.hpp)
+				if (!has_weight_column()) {
+					query("alter table edge_query add column weight real");
+					m_weight_column = 1;
+				}
+				m_edge_weight = weighting_registry::shared().find(get_meta_value("weighting", weighting_registry::default_name()));
+				if (m_edge_weight) {
+					int result = sqlite3_create_function(m_con, "se_edge_weight", 4, SQLITE_UTF8, &m_edge_weight, &sql_edge_weight, NULL, NULL);
+					if (result != SQLITE_OK) throw SQLiteException(m_con);
+				}
+			}
+			
+			// edge_query has had a weight column since the weights were precomputed -
+			// files from before then get one the next time they're indexed
+			bool has_weight_column() {
+				if (m_weight_column == -1) {
+					query("pragma table_info(edge_query)");
+					m_weight_column = 0;
+					for(int row = 0; row < rows(); row++) {
+						if (std::string(field(row, 1)) == "weight") m_weight_column = 1;
+					}
+					free();
+				}
+				return m_weight_column == 1;
+			}
+			
+			// what to select for an edge_query row's weight
+			std::string weight_column() {
+				return has_weight_column() ? "q.weight" : "null";
+			}
+			
+			// se_edge_weight(strength, degree_from, degree_to, count) - the edge_weight
+			// of the weighting the function was registered with
+			static void sql_edge_weight(sqlite3_context *context, int, sqlite3_value **argv) {
+				edge_weight_function f = *(edge_weight_function *)sqlite3_user_data(context);
+				sqlite3_result_double(context, f(sqlite3_value_int(argv[0]),
+					(unsigned long)sqlite3_value_int64(argv[1]),
+					(unsigned long)sqlite3_value_int64(argv[2]),
+					(unsigned long)sqlite3_value_int64(argv[3])));
+			}
+			
+			void mark_dirty_node(id_type id) {
+				sqlite3_stmt *ins = statement("insert or ignore into dirty_node (fk_node) values (?)");
+				sqlite3_bind_int64(ins, 1, (sqlite_int64)id);
+				step(ins);
+			}
+			
+			// everything pointing at this node loses (or changes) an out edge too
+			void mark_dirty_neighbors(id_type id) {
+				sqlite3_stmt *ins = statement("insert or ignore into dirty_node (fk_node) select fk_node_from from edge where fk_node_to = ?");
+				sqlite3_bind_int64(ins, 1, (sqlite_int64)id);
+				step(ins);
+			}
+			
+			// the select that generates edge_query rows, limited by the restriction
+			std::string edge_query_select(id_type collection, int min, float max_factor, std::string restriction) {
+				return "select e.id, n_from.fk_collection, e.fk_node_from, e.fk_node_to, e.strength, d_from.degree as degree_from, d_to.degree degree_to, n_to.type_major, n_to.type_minor, " + std::string(m_edge_weight ? "se_edge_weight(e.strength, d_from.degree, d_to.degree, nc.count)" : "null") + " from node n_from inner join edge e on e.fk_node_from = n_from.id inner join node n_to on e.fk_node_to = n_to.id inner join degree d_from on d_from.fk_node = e.fk_node_from and d_from.type_major = n_to.type_major left join degree d_to on d_to.fk_node = e.fk_node_to and d_to.type_major = n_from.type_major left join node_count nc on nc.fk_collection = n_from.fk_collection and nc.type_major = n_from.type_major where n_from.fk_collection = " + to_string(collection) + " and " + restriction + " and ((n_from.type_major = 2) or (d_to.degree >= " + to_string(min) + " and (d_to.degree < " + to_string(min) + "+2 or d_to.degree < nc.count * " + to_string(max_factor) + ")))";
+			}
+			
+			std::map<int, long> get_node_counts(id_type collection) {
+				std::map<int, long> counts;
+				query("select type_major, count from node_count where fk_collection = " + to_string(collection));
+				for(int row = 0; row < rows(); row++) {
+					counts[atoi(field(row, 0))] = atol(field(row, 1));
+				}
+				free();
+				return counts;
+			}
+			
+			// rebuilds node_count, degree and edge_query for the whole collection
+			void rebuild_collection_indexes(id_type collection, int min, float max_factor) {
+				std::string c = to_string(collection);
+				query("delete from edge_query where fk_collection = " + c);
+				
+				query("delete from node_count where fk_collection = " + c);
+				query("insert into node_count select fk_collection, type_major, count(id) from node where fk_collection = " + c + " group by fk_collection, type_major");
 				
-				// update degrees of nodes
-				query("delete from degree");
-				query("insert into degree select fk_node_from as fk_node, type_major, count(fk_node_to) as degree from edge, node where edge.fk_node_to = node.id group by fk_node, type_major");
+				query("delete from degree where fk_node in (select id from node where fk_collection = " + c + ")");
+				query("insert into degree select e.fk_node_from as fk_node, n.type_major, count(e.fk_node_to) as degree from edge e inner join node n on e.fk_node_to = n.id where n.fk_collection = " + c + " group by e.fk_node_from, n.type_major");
 				
+				query("insert or ignore into edge_query " + edge_query_select(collection, min, max_factor, "1"));
+			}
+			
+			// brings node_count, degree and edge_query up to date with the changes made
+			// by this synchronize.  only the nodes in dirty_node and the rows touching them
+			// are recomputed, so the cost follows the size of the change, not the collection.
+			//  - count_delta holds the net number of nodes added for each type
+			//  - recount forces node_count to be recounted (vertex types may have changed)
+			void indexing_cleanup(id_type collection, const std::map<int, long> &count_delta, bool recount) {
 				int min = atoi(get_meta_value("min", "1").c_str());
 				float max_factor = (float)atof(get_meta_value("max_factor", "0.1").c_str());
 				
+				// edge_query has to be rebuilt from scratch if it was built with other
+				// parameters (or by a version that didn't record them)
+				std::string params = to_string(min) + ":" + to_string(max_factor);
+				if (get_meta_value("edge_query_params") != params) {
+					rebuild_collection_indexes(collection, min, max_factor);
+					set_meta_value("edge_query_params", params);
+					return;
+				}
 				
-				// now execute our edge_query building query
-				std::string q = "insert or ignore into edge_query select e.id, n_from.fk_collection, e.fk_node_from, e.fk_node_to, e.strength, d_from.degree as degree_from, d_to.degree degree_to, n_to.type_major, n_to.type_minor from node n_from inner join edge e on e.fk_node_from = n_from.id inner join node n_to on e.fk_node_to = n_to.id inner join degree d_from on d_from.fk_node = e.fk_node_from and d_from.type_major = n_to.type_major left join degree d_to on d_to.fk_node = e.fk_node_to and d_to.type_major = n_from.type_major left join node_count nc on nc.fk_collection = n_from.fk_collection and nc.type_major = n_from.type_major where n_from.fk_collection = " + to_string(collection) + " and ((n_from.type_major = 2) or (d_to.degree >= " + to_string(min) + " and (d_to.degree < " + to_string(min) + "+2 or d_to.degree < nc.count * " + to_string(max_factor) + ")))";
+				std::string c = to_string(collection);
 				
-				// execute it
-				query(q);
+				// update node counts
+				std::map<int, long> old_counts = get_node_counts(collection);
+				if (recount) {
+					query("delete from node_count where fk_collection = " + c);
+					query("insert into node_count select fk_collection, type_major, count(id) from node where fk_collection = " + c + " group by fk_collection, type_major");
+				} else {
+					for(std::map<int, long>::const_iterator i = count_delta.begin(); i != count_delta.end(); ++i) {
+						if (i->second == 0) continue;
+						query("insert or ignore into node_count (fk_collection, type_major, count) values (" + c + ", " + to_string(i->first) + ", 0)");
+						query("update node_count set count = count + (" + to_string(i->second) + ") where fk_collection = " + c + " and type_major = " + to_string(i->first));
+					}
+				}
+				std::map<int, long> new_counts = get_node_counts(collection);
+
+				// when a good part of the collection changed (a first indexing run, say)
+				// one pass over everything beats chasing the dirty rows
+				long total = 0;
+				for(std::map<int, long>::iterator i = new_counts.begin(); i != new_counts.end(); ++i) total += i->second;
+				query("select count(*) from dirty_node");
+				long num_dirty = atol(field(0,0));
+				free();
+				if (num_dirty * 4 > total) {
+					rebuild_collection_indexes(collection, min, max_factor);
+					return;
+				}
+
+				// a changed count moves the max_factor cut off, so edges into nodes whose
+				// degree lies between the old and the new cut off may switch in or out
+				for(std::map<int, long>::iterator i = new_counts.begin(); i != new_counts.end(); ++i) {
+					if (i->first == node_type_major_term) continue; // edges from terms are always kept
+					long old_count = old_counts.count(i->first) ? old_counts[i->first] : 0;
+					if (old_count == i->second) continue;
+					
+					float lo = (std::min)(old_count, i->second) * max_factor;
+					float hi = (std::max)(old_count, i->second) * max_factor;
+					query("insert or ignore into dirty_target select d.fk_node from degree d inner join node n on n.id = d.fk_node where d.type_major = " + to_string(i->first) + " and d.degree >= " + to_string(min) + "+2 and d.degree >= " + to_string(lo) + " and d.degree < " + to_string(hi) + " and n.fk_collection = " + c);
+				}
+				
+				// update degrees of the dirty nodes
+				query("delete from degree where fk_node in (select fk_node from dirty_node)");
+				query("insert into degree select e.fk_node_from as fk_node, n.type_major, count(e.fk_node_to) as degree from edge e inner join node n on e.fk_node_to = n.id where e.fk_node_from in (select fk_node from dirty_node) group by e.fk_node_from, n.type_major");
+				
+				// a dirty node's degree shows up in the rows leading out of it (degree_from)
+				// and in the rows leading into it (degree_to, which also decides if they're kept)
+				query("insert or ignore into dirty_target select fk_node from dirty_node");
+				
+				query("delete from edge_query where fk_node_from in (select fk_node from dirty_node)");
+				// (edge_query shares its ids with edge, so we can find the incoming rows through edge's index)
+				query("delete from edge_query where id in (select d.id from dirty_target dt cross join edge d on d.fk_node_to = dt.fk_node)");
+				
+				// (the cross joins keep sqlite from scanning all of edge - it has no idea how
+				// small the dirty tables are)
+				query("insert or ignore into edge_query " + edge_query_select(collection, min, max_factor,
+					"e.id in (select d.id from dirty_node dn cross join edge d on d.fk_node_from = dn.fk_node"
+					" union select d.id from dirty_target dt cross join edge d on d.fk_node_to = dt.fk_node)"));
+				
+				query("delete from dirty_node");
+				query("delete from dirty_target");
+			}
+			
+			// the rows indexing_cleanup wrote already have their weights, but those
+			// depend on the node count of the source's type too, so when a count
+			// changed every row leading out of that type is weighed again - as is
+			// everything when the collection's weighting changed
+			void update_edge_weights(id_type collection) {
+				std::string c = to_string(collection);
+				std::string name = m_edge_weight ? get_meta_value("weighting", weighting_registry::default_name()) : "";
+				std::map<int, long> counts = get_node_counts(collection);
+				
+				std::string old_name = get_meta_value("edge_weights");
+				std::map<int, long> old_counts;
+				std::stringstream in(get_meta_value("edge_weight_counts"));
+				int type; long count; char colon;
+				while (in >> type >> colon >> count) old_counts[type] = count;
+				
+				std::stringstream out;
+				for(std::map<int, long>::iterator i = counts.begin(); i != counts.end(); ++i) {
+					out << i->first << ":" << i->second << " ";
+				}
+				if (name == old_name && out.str() == get_meta_value("edge_weight_counts")) return;
+				
+				if (name != old_name) {
+					query("update edge_query set weight = " + weight_of_row() + " where fk_collection = " + c);
+				} else {
+					for(std::map<int, long>::iterator i = counts.begin(); i != counts.end(); ++i) {
+						if (old_counts.count(i->first) && old_counts[i->first] == i->second) continue;
+						query("update edge_query set weight = " + weight_of_row() + " where fk_node_from in (select id from node where fk_collection = " + c + " and type_major = " + to_string(i->first) + ")");
+					}
+				}
+				set_meta_value("edge_weights", name);
+				set_meta_value("edge_weight_counts", out.str());
+			}
+			
+			// an edge_query row's weight, in an update of edge_query
+			std::string weight_of_row() {
+				if (!m_edge_weight) return "null";
+				return "se_edge_weight(strength, degree_from, degree_to, (select nc.count from node n inner join node_count nc on nc.fk_collection = n.fk_collection and nc.type_major = n.type_major where n.id = edge_query.fk_node_from))";
 			}
 			
 			void synchronize() {
 				// synchronize what we have stored here with the database!
+				// everything below runs as prepared statements inside a single transaction
 				// std::cerr << "begin committing changes" << std::endl;
 				
 				open();
 				query("PRAGMA synchronous=OFF");
 				query("BEGIN TRANSACTION");
-				if (m_clear_all) {
-				    // we are supposed to clear out the entire collection... we can do that.
-				    remove_collection(get_property(*this, graph_name));
-				    m_collection_id = (std::numeric_limits<id_type>::max)(); // reset cached id
-				    get_collection_id(); // regenerate empty collection
-				    
-				    m_clear_all = false;
-				    m_to_remove.clear();
-				    m_to_remove_edges.clear();
-				    m_to_clear.clear();
-				    query("COMMIT TRANSACTION");
-				}
-				
-				id_type collection = get_collection_id();
-			
-				// first step is: go through vertices and make sure they're in the graph
-				typename traits::vertex_iterator vi, vi_end;
-
-				for(boost::tie(vi, vi_end) = vertices(*this); vi != vi_end; ++vi) {
-					if ((*this)[*vi].dirty) {
-						// ok, needs an update
-						if ((*this)[*vi].in_db) {
-							// and it's already in the DB, so we have to update it.
-							id_type content_id = create_content_row((*this)[*vi].content);
-							
-							// update the row
-							query("update node set type_major = " + to_string((*this)[*vi].type_major) + ", type_minor = " + to_string((*this)[*vi].type_minor) + ", fk_content = " + to_string(content_id));
-							(*this)[*vi].dirty = false;
+				
+				try {
+					prepare_cleanup_schema();
+					
+					if (m_clear_all) {
+						// we are supposed to clear out the entire collection... we can do that.
+						// (the collection_ad trigger takes the nodes and everything else with it)
+						query("delete from collection where name = '" + escape(get_property(*this, graph_name)) + "'");
+						m_collection_id = (std::numeric_limits<id_type>::max)(); // reset cached id
+						
+						m_clear_all = false;
+						m_to_remove.clear();
+						m_to_remove_edges.clear();
+						m_to_clear.clear();
+					}
+					
+					id_type collection = get_collection_id(); // regenerates an empty collection if we just cleared it
+					
+					// what indexing_cleanup needs to know about
+					std::set<id_type> dirty;
+					std::vector<id_type> updated;
+					std::map<int, long> count_delta;
+				
+					// first step is: go through vertices and make sure they're in the graph
+					typename traits::vertex_iterator vi, vi_end;
+
+					for(boost::tie(vi, vi_end) = vertices(*this); vi != vi_end; ++vi) {
+						vertex_properties &vp = (*this)[*vi];
+						if (!vp.dirty) continue;
+						
+						id_type content_id = create_content_row(vp.content);
+						if (vp.in_db) {
+							// it's already in the DB, so we have to update it.
+							update_node(vp.id, vp.type_major, vp.type_minor, content_id);
+							updated.push_back(vp.id);
 						} else {
 							// just add it
-							id_type content_id = create_content_row((*this)[*vi].content);
-							id_type node_id = create_node(collection, (*this)[*vi].type_major, (*this)[*vi].type_minor, content_id);
-
-							(*this)[*vi].id = node_id;
-							(*this)[*vi].in_db = true;
-							(*this)[*vi].dirty = false; // ok, done with this one
+							long changes_before = sqlite3_total_changes(m_con);
+							vp.id = create_node(collection, vp.type_major, vp.type_minor, content_id);
+							vp.in_db = true;
+							if (sqlite3_total_changes(m_con) > changes_before) count_delta[vp.type_major]++;
 							
 							// put it in the cache
-							m_id_vertex_cache[(*this)[*vi].id] = *vi;
+							m_id_vertex_cache[vp.id] = *vi;
 						}
+						vp.dirty = false; // ok, done with this one
 					}
-				}
-				
-				// now go through the edges and batch add them
-				typename traits::edge_iterator ei, ei_end;
-				// vector for storing our batch jobs
 
-				for(boost::tie(ei, ei_end) = edges(*this); ei != ei_end; ++ei) {
-					if (!((*this)[*ei].dirty)) continue; // not dirty - does not need "cleaning"
-					
-					query("insert or replace into edge (fk_node_from, fk_node_to, strength) values (" + to_string((*this)[source(*ei, *this)].id) + "," + to_string((*this)[target(*ei, *this)].id) + "," + to_string((*this)[*ei].strength) + ")");
+					// now go through the edges and batch add them
+					typename traits::edge_iterator ei, ei_end;
+					// vector for storing our batch jobs
+					std::vector<edge_row> batch;
+					batch.reserve(edge_batch_size);
+
+					for(boost::tie(ei, ei_end) = edges(*this); ei != ei_end; ++ei) {
+						if (!((*this)[*ei].dirty)) continue; // not dirty - does not need "cleaning"
+
+						edge_row r;
+						r.from = (*this)[source(*ei, *this)].id;
+						r.to = (*this)[target(*ei, *this)].id;
+						r.strength = (*this)[*ei].strength;
+						batch.push_back(r);
+						dirty.insert(r.from);
+
+						if (batch.size() == edge_batch_size) {
+							insert_edge_batch(batch, 0, edge_batch_size);
+							batch.clear();
+						}
+
+						(*this)[*ei].dirty = false;
+					}
+					// and whatever is left over, one at a time (the single row statement is cached too)
+					for(unsigned int i = 0; i < batch.size(); i++) {
+						insert_edge_batch(batch, i, 1);
+					}
+
+					for(typename std::set<id_type>::iterator i = dirty.begin(); i != dirty.end(); ++i) {
+						mark_dirty_node(*i);
+					}
+					// an updated vertex may have changed type, which changes its neighbors' degrees
+					for(unsigned int i = 0; i < updated.size(); i++) {
+						mark_dirty_node(updated[i]);
+						mark_dirty_neighbors(updated[i]);
+					}
+
+					// check for deleted vertices
+					if (!m_to_remove.empty()) count_cache.clear(); // clear the vertex count cache so it's reloaded later
+					sqlite3_stmt *node_type = statement("select type_major from node where id = ? and fk_collection = ?");
+					sqlite3_stmt *del_node = statement("delete from node where id = ?");
+					for(unsigned int i = 0; i < m_to_remove.size(); i++) {
+						sqlite3_bind_int64(node_type, 1, (sqlite_int64)m_to_remove[i]);
+						sqlite3_bind_int64(node_type, 2, (sqlite_int64)collection);
+						if (step(node_type) != SQLITE_ROW) continue; // not there anymore
+						count_delta[sqlite3_column_int(node_type, 0)]--;
+						sqlite3_reset(node_type);
+
+						// the trigger takes care of the node's own edges and rows
+						mark_dirty_neighbors(m_to_remove[i]);
+						sqlite3_bind_int64(del_node, 1, (sqlite_int64)m_to_remove[i]);
+						step(del_node);
+					}
+					m_to_remove.clear();
+
+					// and edges
+					sqlite3_stmt *del_edge = statement("delete from edge where fk_node_from = ? and fk_node_to = ?");
+					for(unsigned int i = 0; i < m_to_remove_edges.size(); i++) {
+						mark_dirty_node(m_to_remove_edges[i].first);
+						sqlite3_bind_int64(del_edge, 1, (sqlite_int64)m_to_remove_edges[i].first);
+						sqlite3_bind_int64(del_edge, 2, (sqlite_int64)m_to_remove_edges[i].second);
+						step(del_edge);
+					}
+					m_to_remove_edges.clear();
+
+					sqlite3_stmt *clear_edges = statement("delete from edge where fk_node_from = ?1 or fk_node_to = ?1");
+					for(unsigned int i = 0; i < m_to_clear.size(); i++) {
+						mark_dirty_node(m_to_clear[i]);
+						mark_dirty_neighbors(m_to_clear[i]);
+						sqlite3_bind_int64(clear_edges, 1, (sqlite_int64)m_to_clear[i]);
+						step(clear_edges);
+					}
+					m_to_clear.clear();
+
+					// perform cleanup
+					// std::cerr << "doing cleanup" << std::endl;
+					if (m_defer_cleanup) {
+						// (parameters that can't match make the next cleanup start over,
+						// even if that's in another process)
+						set_meta_value("edge_query_params", "deferred");
+					} else {
+						indexing_cleanup(collection, count_delta, !updated.empty());
+						update_edge_weights(collection);
+					}
 					
-					(*this)[*ei].dirty = false;
+					// new version of the collection, for anyone holding on to search results
+					std::string cid = to_string(collection);
+					query("update collection set last_update = CURRENT_TIMESTAMP where id = " + cid);
+					query("insert or replace into collection_meta (fk_collection, key, value) select " + cid + ", 'generation', "
+						"coalesce((select value from collection_meta where fk_collection = " + cid + " and key = 'generation'), 0) + 1");
+				} catch (...) {
+					// don't leave a half written collection behind, or the
+					// transaction open on the connection (whatever went wrong)
+					if (m_con) sqlite3_exec(m_con, "ROLLBACK TRANSACTION", NULL, NULL, NULL);
+					throw;
 				}
-				
-				// check for deleted vertices
-				if (!m_to_remove.empty()) count_cache.clear(); // clear the vertex count cache so it's reloaded later
-			    for(unsigned int i = 0; i < m_to_remove.size(); i++) {
-    			    query("delete from node where id = " + to_string(m_to_remove[i]));
-			    }
-			    m_to_remove.clear();
-			    
-				// and edges
-				for(unsigned int i = 0; i < m_to_remove_edges.size(); i++) {
-				    id_type from, to;
-				    boost::tie(from, to) = m_to_remove_edges[i];
-    			    query("delete from edge where fk_node_from = " + to_string(from) + " and fk_node_to = " + to_string(to));
-			    }
-			    m_to_remove_edges.clear();
-			    
-			    for(unsigned int i = 0; i < m_to_clear.size(); i++) {
-				    id_type id = m_to_clear[i];
-    			    query("delete from edge where fk_node_from = " + to_string(id) + " or fk_node_to = " + to_string(id));
-			    }
-			    m_to_clear.clear();
+
 				query("COMMIT TRANSACTION");
-				query("BEGIN TRANSACTION");
+				neighbor_cache<SQLite3StoragePolicy>::shared().invalidate(cache_key());
+				content_id_cache<SQLite3StoragePolicy>::shared().invalidate(cache_key());
+				m_caches_checked = false;
+				// std::cerr << "done committing changes" << std::endl;
+			}
+
+			// returns the cached prepared statement for this sql, preparing it the first
+			// time we see it.  statements live until the connection is closed.
+#ifdef WIN32
+			sqlite3_stmt *statement(const std::string &sql) throw(...) {
+#else
+			sqlite3_stmt *statement(const std::string &sql) throw(SQLiteException) {
+#endif
+				open(); // first, in case
 				
-				// perform cleanup
-				// std::cerr << "doing cleanup" << std::endl;
-				indexing_cleanup(collection);
+				typename statement_cache::iterator i = m_statements.find(sql);
+				if (i != m_statements.end()) return i->second;
 				
-				query("COMMIT TRANSACTION");
-				// std::cerr << "done committing changes" << std::endl;
+				sqlite3_stmt *stmt = NULL;
+				if (sqlite3_prepare_v2(m_con, sql.c_str(), (int)sql.size(), &stmt, NULL) != SQLITE_OK) {
+					SQLiteException e(m_con);
+					if (stmt) sqlite3_finalize(stmt);
+					throw e;
+				}
+				m_statements.insert(std::make_pair(sql, stmt));
+				return stmt;
+			}
+			
+			// prepares a statement we'll only run once; the caller finalizes it
+#ifdef WIN32
+			sqlite3_stmt *prepare(const std::string &sql) throw(...) {
+#else
+			sqlite3_stmt *prepare(const std::string &sql) throw(SQLiteException) {
+#endif
+				open(); // first, in case
+				
+				sqlite3_stmt *stmt = NULL;
+				if (sqlite3_prepare_v2(m_con, sql.c_str(), (int)sql.size(), &stmt, NULL) != SQLITE_OK) {
+					SQLiteException e(m_con);
+					if (stmt) sqlite3_finalize(stmt);
+					throw e;
+				}
+				return stmt;
+			}
+			
+			std::string column_string(sqlite3_stmt *stmt, int col) {
+				const char *text = (const char *)sqlite3_column_text(stmt, col);
+				return text ? std::string(text, sqlite3_column_bytes(stmt, col)) : std::string();
+			}
+			
+			// an edge_query weight, or -1 for none
+			double column_weight(sqlite3_stmt *stmt, int col) {
+				return sqlite3_column_type(stmt, col) == SQLITE_NULL ? -1 : sqlite3_column_double(stmt, col);
+			}
+			
+			// steps a prepared statement, waiting on a busy database like query() does.
+			// statements that don't return rows are reset and ready for the next bind.
+#ifdef WIN32
+			int step(sqlite3_stmt *stmt) throw(...) {
+#else
+			int step(sqlite3_stmt *stmt) throw(SQLiteException) {
+#endif
+				int r;
+				int c = 0;
+				do {
+					r = sqlite3_step(stmt);
+					if (r == SQLITE_BUSY || r == SQLITE_LOCKED) sqlite3_reset(stmt);
+					if (c>0) std::cerr << ".";
+					if (c++ >= 20) break; // only try 20 times
+				} while (r == SQLITE_BUSY || r == SQLITE_LOCKED);
+				
+				if (r == SQLITE_ROW) return r; // caller reads the columns, then resets
+				
+				sqlite3_reset(stmt);
+				if (r != SQLITE_DONE) throw SQLiteException(m_con);
+				return r;
+			}
+			
+			void finalize_statements() {
+				for(typename statement_cache::iterator i = m_statements.begin(); i != m_statements.end(); ++i) {
+					sqlite3_finalize(i->second);
+				}
+				m_statements.clear();
 			}
 			
 			id_type get_collection_id() {
@@ -779,6 +1356,32 @@ namespace semantic {
 			char **m_result;
 			int m_rows, m_cols;
 			bool mirror_flag;
+			bool m_defer_cleanup;
+			
+			// prepared statements, keyed by their sql
+			statement_cache m_statements;
+			
+			bool m_caches_checked;
+			
+			// the weighting edge_query's weight column is filled in with, and
+			// whether the column's there at all (-1 until we've looked)
+			edge_weight_function m_edge_weight;
+			int m_weight_column;
+			
+			// what our entries are filed under in the shared neighbor_cache
+			// and content_id_cache
+			std::string cache_key() {
+				return m_file + "\n" + get_property(*this, graph_name);
+			}
+
+			// once a search, see if somebody else has changed the collection
+			void check_collection_version() {
+				if (m_caches_checked) return;
+				std::string version = get_collection_version();
+				neighbor_cache<SQLite3StoragePolicy>::shared().validate(cache_key(), version);
+				content_id_cache<SQLite3StoragePolicy>::shared().validate(cache_key(), version);
+				m_caches_checked = true;
+			}
 	};
 	
 } // namespace semantic
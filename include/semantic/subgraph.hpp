@@ -15,8 +15,11 @@ This class should be used for the "searching" portion of the Semantic Engine
 #include <semantic/semantic.hpp>
 #include <semantic/weighting/none.hpp>
 #include <semantic/utility.hpp>
+#include <semantic/compact_subgraph.hpp>
 #include <string>
 #include <map>
+#include <vector>
+#include <iterator>
 
 //#include <iostream>
 
@@ -139,13 +142,44 @@ namespace semantic {
 				}
 				return stem;
 			}
-			
+
+			// unstem_term() for a run of term vertices already in the subgraph,
+			// with one storage lookup for all of them. out gets a
+			// std::pair<vertex_descriptor, std::string> for each vertex.
+			template <class Iterator, class OutIterator>
+			void unstem_terms(Iterator i, Iterator i_end, OutIterator out) {
+				std::vector<typename se_traits::vertex_id_type> ids;
+				for(Iterator u = i; u != i_end; ++u) ids.push_back(storage_policy::get_vertex_id(*u));
+
+				std::map<typename se_traits::vertex_id_type, std::string> terms;
+				storage_policy::fetch_vertex_meta_values(ids.begin(), ids.end(), "term", inserter(terms, terms.end()));
+
+				for(typename std::vector<typename se_traits::vertex_id_type>::size_type n = 0; i != i_end; ++i, ++n) {
+					const std::string &stem = (*this)[*i].content;
+					typename std::map<typename se_traits::vertex_id_type, std::string>::iterator t = terms.find(ids[n]);
+					if (t != terms.end()) {
+						std::string::size_type pos = t->second.find_last_of(":");
+						if( pos != std::string::npos && pos > 0 ){
+							*out = std::make_pair(*i, t->second.substr(0,pos));
+							continue;
+						}
+					}
+					*out = std::make_pair(*i, stem);
+				}
+			}
+
 			
 			template <class WeightMap>
             void populate_weight_map(WeightMap w) {
                 // forward this to our superclass's implementation
                 base_graph_type::populate_weight_map(weighting, w);
             }
+
+			// the subgraph as it stands, numbered and weighed into arrays
+			// (see compact_subgraph.hpp)
+			compact_subgraph<SESubgraph> compact() {
+				return compact_subgraph<SESubgraph>(*this);
+			}
 			
 			void clear() {
 				base_graph_type::clear();   // SEGraph::clear()
@@ -8,7 +8,9 @@ for the duration of a single process
 #ifndef __SEMANTIC_SUBGRAPH_BFS_HPP__
 #define __SEMANTIC_SUBGRAPH_BFS_HPP__
 
+#include <semantic/utility.hpp>
 #include <set>
+#include <string>
 
 namespace semantic {
 	template <class SEBase>
@@ -23,6 +25,9 @@ namespace semantic {
 			void set_depth(unsigned int d) { m_depth = d; }
 			unsigned int get_depth() { return m_depth; }
 			
+			// describes the settings that shape the subgraph (see search_cache)
+			std::string subgraph_parameters() const { return "bfs depth=" + to_string(m_depth); }
+			
 			// methods in the concept/policy
 			template <class Iterator, class WeightingPolicy>
 			void want_vertices(Iterator i, Iterator i_end, WeightingPolicy w) {
@@ -8,6 +8,7 @@ for the duration of a single process
 #ifndef __SEMANTIC_SUBGRAPH_NONE_HPP__
 #define __SEMANTIC_SUBGRAPH_NONE_HPP__
 
+#include <string>
 
 
 namespace semantic {
@@ -19,6 +20,9 @@ namespace semantic {
 			template <class Iterator, class WeightingPolicy>
 			void want_vertices(Iterator i, Iterator i_end, WeightingPolicy w) {}
 			
+			// describes the settings that shape the subgraph (see search_cache)
+			std::string subgraph_parameters() const { return "none"; }
+			
 			void did_clear() {SEBase::did_clear();}
 			void will_clear() {SEBase::will_clear();}
 	};
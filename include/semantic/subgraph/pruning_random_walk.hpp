@@ -42,6 +42,12 @@ namespace semantic {
 			unsigned int get_depth() { return m_depth; }
 			unsigned int get_trials() { return m_trials; }
 			
+			// describes the settings that shape the subgraph (see search_cache)
+			std::string subgraph_parameters() const {
+				return "pruning_random_walk depth=" + to_string(m_depth) + " trials=" + to_string(m_trials)
+					+ " keep=" + to_string(m_prune_keep);
+			}
+			
 			template <class Iterator, class WeightingPolicy>
 			void want_vertices(Iterator i, Iterator i_end, WeightingPolicy w) {
 				// set the graph's energy hit count
@@ -40,6 +40,11 @@ namespace semantic {
 			unsigned int get_depth() const { return m_depth; }
 			unsigned int get_trials() const { return m_trials; }
 			
+			// describes the settings that shape the subgraph (see search_cache)
+			std::string subgraph_parameters() const {
+				return "random_walk depth=" + to_string(m_depth) + " trials=" + to_string(m_trials);
+			}
+			
 			template <class Iterator, class WeightingPolicy>
 			void want_vertices(Iterator i, Iterator i_end, WeightingPolicy w) {
 				// set energy hits to # of trials
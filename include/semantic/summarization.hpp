@@ -4,6 +4,7 @@
 #include <semantic/semantic.hpp>
 #include <semantic/abbreviations.hpp>
 #include <semantic/stem/english_stem.h>
+#include <semantic/cached_stemmer.hpp>
 
 #include <map>
 #include <string>
@@ -149,7 +150,7 @@ namespace semantic {
  * **************************************************************** */
 			std::vector<std::string> tokenize_words( const std::string& sentence ){
 				
-				stemming::english_stem Stemmer;
+				cached_stemmer<>& Stemmer = cached_stemmer<>::for_this_thread();
 				std::vector<std::string> terms;
 				std::string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
 				std::string numbers = "0123456789";
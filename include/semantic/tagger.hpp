@@ -7,8 +7,10 @@
 #include <semantic/utility.hpp>
 
 #include <semantic/abbreviations.hpp>
+#include <semantic/lexicon.hpp>
 #include <boost/algorithm/string.hpp>
 #include <cctype>
+#include <algorithm>
 
 
 // STL Includes
@@ -30,137 +32,215 @@ namespace semantic {
             
             tagger( std::istream& lexicon_stream )
             {
-                init();
                 load_lexicon( lexicon_stream );
+                init();
             }
             
             tagger( const std::string& lexicon_location="" )
             {
-                init();
                 load_lexicon( lexicon_location );
+                init();
+            }
+
+            // share an already loaded lexicon; copies of a tagger share
+            // their lexicon the same way
+            tagger( compiled_lexicon::pointer lexicon_ptr )
+                : lexicon( lexicon_ptr )
+            {
+                init();
+            }
+
+            compiled_lexicon::pointer get_lexicon() const {
+                return lexicon;
             }
             
 
+/* *********************************************************************
+ *        Tokens and tags without the string copies
+ *
+ *        tag( text, out ) tokenizes and tags `text` into `out`.  the
+ *        tokens are spans of `text` itself (or of scratch space in
+ *        `out`, for the few tokens that punctuation cleaning had to
+ *        rewrite) and the tags are the lexicon's tag ids, so once `out`
+ *        has grown to fit the texts nothing gets allocated per token.
+ *        keep a tagged_tokens around and hand it in for every text; the
+ *        spans are good until `text` changes or `out` is reused.
+ *********************************************************************** */
+            struct token {
+                const char *begin;
+                std::string::size_type length;
+
+                std::string str() const { return std::string( begin, length ); }
+            };
+
+            class tagged_tokens {
+                public:
+                    std::vector<token> tokens;
+                    std::vector<compiled_lexicon::tag_id> tags;
+
+                    std::size_t size() const { return tokens.size(); }
+
+                private:
+                    friend class tagger;
+
+                    // a token before we know where it lives: an offset into
+                    // the text, or into `scratch` when it's been rewritten
+                    struct piece {
+                        std::string::size_type offset;
+                        std::string::size_type length;
+                        bool rewritten;
+                    };
+                    std::vector<piece> words, pieces;
+                    std::string stripped, scratch;
+            };
+
+            void tag( const std::string& text, tagged_tokens& out ){
+                tokenize( text, out );
+                out.tags.resize( out.tokens.size() );
+                for( std::vector<token>::size_type i = 0; i < out.tokens.size(); ++i ){
+                    out.tags[i] = tag_token( out.tokens[i].begin, out.tokens[i].length );
+                }
+            }
+
+            const char *tag_name( compiled_lexicon::tag_id tag ) const {
+                return lexicon->tag_name( tag );
+            }
+
+
 /* *********************************************************************
  *        Separate words and punctuation in preparation for tagging
  *********************************************************************** */
             
             std::vector<std::string> tokenize(const std::string& text)
             {
-                std::string s(text);
-            
-                /* load the standard set of abbreviations */
-                Abbreviations abbrs;
-            
-                
-                // Remove any HTML-like tags that sneaked in
-                std::string::size_type htmlPos = s.find_first_of("<",0);
-                std::string::size_type lastHtmlPos = s.find_first_of(">",htmlPos);
-                while( htmlPos != std::string::npos && lastHtmlPos != std::string::npos ){
-                    s.replace(htmlPos,lastHtmlPos-htmlPos+1," ");
-                    htmlPos = s.find_first_of("<",htmlPos+1);
-                    lastHtmlPos = s.find_first_of(">",htmlPos);
+                tokenize( text, scratch_tokens );
+
+                std::vector<std::string> final;
+                final.reserve( scratch_tokens.tokens.size() );
+                for( std::vector<token>::size_type i = 0; i < scratch_tokens.tokens.size(); ++i ){
+                    final.push_back( scratch_tokens.tokens[i].str() );
                 }
-                
-            
-                
+                return final;
+            }
+
+            void tokenize( const std::string& text, tagged_tokens& out )
+            {
+                out.words.clear();
+                out.pieces.clear();
+                out.scratch.clear();
+                out.tokens.clear();
+
+                // Remove any HTML-like tags that sneaked in -- only then do
+                // we need a copy of the text
+                const std::string *source = &text;
+                if( text.find_first_of("<",0) != std::string::npos ){
+                    std::string &s = out.stripped;
+                    s.assign( text );
+                    std::string::size_type htmlPos = s.find_first_of("<",0);
+                    std::string::size_type lastHtmlPos = s.find_first_of(">",htmlPos);
+                    while( htmlPos != std::string::npos && lastHtmlPos != std::string::npos ){
+                        s.replace(htmlPos,lastHtmlPos-htmlPos+1," ");
+                        htmlPos = s.find_first_of("<",htmlPos+1);
+                        lastHtmlPos = s.find_first_of(">",htmlPos);
+                    }
+                    source = &s;
+                }
+                const char *base = source->data();
+                const std::string::size_type size = source->size();
+
                 // Simple tokenization on whitespace
-                std::vector<std::string> coll;
-                std::string delim = "\x20\x09\x0a\x0c\x0d\xa0\x85";
-                std::string::size_type lastPos = s.find_first_not_of(delim,0);
-                std::string::size_type startPos = s.find_first_of(delim,lastPos);
-                
-                while( startPos != std::string::npos || lastPos != std::string::npos ){
-                    coll.push_back( s.substr(lastPos,startPos-lastPos) );
-                    lastPos = s.find_first_not_of(delim,startPos);
-                    startPos = s.find_first_of(delim,lastPos);
+                std::string::size_type i = 0;
+                while( i < size ){
+                    while( i < size && char_class[(unsigned char)base[i]] & delimiter ) i++;
+                    if( i == size ) break;
+                    tagged_tokens::piece w = { i, 0, false };
+                    while( i < size && !(char_class[(unsigned char)base[i]] & delimiter) ) i++;
+                    w.length = i - w.offset;
+                    out.words.push_back( w );
                 }
-                
+
                 // short circuit...
-                if( coll.empty() )
-                    return coll;
-                
-            
-                
+                if( out.words.empty() )
+                    return;
+
                 // If the final token has a period, remove it
-                std::string elem = coll.back();
-                unsigned int n = 1;
-                std::string lchar = elem.substr(elem.length()-n,1);
-                if( lchar == "." ){
-                    while(elem.length() >= n && elem.substr(elem.length()-n,1) == "."){
+                tagged_tokens::piece &last = out.words.back();
+                if( base[last.offset + last.length - 1] == '.' ){
+                    std::string::size_type n = 0;
+                    while( n < last.length && base[last.offset + last.length - 1 - n] == '.' ){
                         n++;
                     }
-                
-                    coll[coll.size()-1] = elem.substr(0,elem.size()-(n-1));
-                    std::string final_period;
-                    for( unsigned int j=1;j<n;j++){
-                        final_period += ".";
-                    }
-                    coll.push_back(final_period);
+                    last.length -= n;
+                    tagged_tokens::piece periods = { last.offset + last.length, n, false };
+                    out.words.push_back( periods );
                 }
-                
-            
-                
+
                 // Do the real tokenization now by separating off the punctuation
-                std::vector<std::string> tokens;
-                std::vector<std::string>::iterator pos;
-                for( pos = coll.begin(); pos != coll.end(); ++pos ){
-                    std::string tok = *pos;
-                
-                    // only clean punctuation if there's something to clean
-                    if( tok.find_first_not_of(letters+numbers,0) != std::string::npos ){
-                
-                        tok = clean_punctuation( tok );
-                
-                        std::string::size_type end = tok.find_first_of( " ", 0 );
-                        if( end != std::string::npos ){
-                
-                            // There are multiple tokens here
-                            tokens.push_back( tok.substr(0,end) );
-                
-                            while( end != std::string::npos ){
-                                std::string::size_type beg = tok.find_first_not_of( " ", end );
-                                end = tok.find_first_of( " ", beg );
-                                tokens.push_back( tok.substr(beg,end-beg) );
-                            }
-                
-                        } else {
-                            // There's just one token here
-                            tokens.push_back( tok );
-                        }
+                for( std::vector<tagged_tokens::piece>::iterator pos = out.words.begin();
+                         pos != out.words.end(); ++pos ){
+                    const char *tok = base + pos->offset;
+                    std::string::size_type len = pos->length;
+
+                    // only clean punctuation if there's something to clean;
+                    // a word with a comma or a period after it is common enough
+                    // to split here, and clean_punctuation does the rest
+                    std::string::size_type alnum = 0;
+                    while( alnum < len && char_class[(unsigned char)tok[alnum]] & alphanumeric ) alnum++;
+
+                    if( alnum == len ){
+                        out.pieces.push_back( *pos );
+                    } else if( alnum > 0 && alnum == len - 1 && tok[alnum] == ',' ){
+                        tagged_tokens::piece word = { pos->offset, alnum, false };
+                        tagged_tokens::piece comma = { pos->offset + alnum, 1, false };
+                        out.pieces.push_back( word );
+                        out.pieces.push_back( comma );
+                    } else if( alnum > 0 && alnum == len - 1 && tok[alnum] == '.' &&
+                               only_letters( tok, alnum ) ){
+                        out.pieces.push_back( *pos );
                     } else {
-                        tokens.push_back( tok );
+                        std::string cleaned = clean_punctuation( std::string( tok, len ) );
+
+                        // There may be multiple tokens here
+                        std::string::size_type beg = 0;
+                        std::string::size_type end = cleaned.find_first_of( " ", 0 );
+                        while( true ){
+                            tagged_tokens::piece p = { out.scratch.size(), 0, true };
+                            std::string::size_type stop = end == std::string::npos ? cleaned.size() : end;
+                            out.scratch.append( cleaned, beg, stop - beg );
+                            p.length = stop - beg;
+                            out.pieces.push_back( p );
+
+                            if( end == std::string::npos ) break;
+                            beg = cleaned.find_first_not_of( " ", end );
+                            end = cleaned.find_first_of( " ", beg );
+                            if( beg == std::string::npos ) beg = cleaned.size();
+                        }
                     }
                 }
-                
-            
-                
+
                 /*    Now deal with all the periods, most of which should be
                  *    separated from the word (i.e. when it indicates the end
                  *    of a sentence), but some should be left on the word
                  *    (i.e. for abbreviations) */
-                std::vector<std::string> final;
-                std::vector<std::string>::size_type size = tokens.size();
-                for( unsigned i=0; i<size; ++i ){
-                    std::string token = tokens[i];
-                    std::string::size_type len = token.length();
-                    if (    len > 1 &&
-                            token.substr(len-1,1) == "." &&
-                            i + 1 < size &&
-                            ( is_upper( tokens[i+1] ) || ! is_alpha( tokens[i+1] ) ) &&
-                            !abbrs.is_abbreviation( token ) ) {
-                
+                std::vector<tagged_tokens::piece>::size_type count = out.pieces.size();
+                out.tokens.reserve( count );
+                for( std::vector<tagged_tokens::piece>::size_type i = 0; i < count; ++i ){
+                    token t = resolve( out, base, out.pieces[i] );
+                    if( t.length > 1 &&
+                            t.begin[t.length-1] == '.' &&
+                            i + 1 < count &&
+                            next_starts_sentence( resolve( out, base, out.pieces[i+1] ) ) &&
+                            !abbrs.is_abbreviation( t.str() ) ) {
+
                         // Separate word and period
-                        // Add both to tokens
-                        final.push_back( token.substr(0,len-1) );
-                        final.push_back( "." );
+                        token word = { t.begin, t.length - 1 };
+                        token period = { t.begin + t.length - 1, 1 };
+                        out.tokens.push_back( word );
+                        out.tokens.push_back( period );
                     } else {
-                        final.push_back( token );
+                        out.tokens.push_back( t );
                     }
                 }
-                
-            
-                return final;
             }
             
 
@@ -171,15 +251,15 @@ namespace semantic {
             
             std::string add_tags( const std::string& text )
             {
-                std::vector<std::string> toks =  tokenize( text );
+                tag( text, scratch_tokens );
                 std::string tagged;
             
-                for( unsigned i = 0; i < toks.size(); ++i ){
-                    std::string word = clean_word( toks[i] );
-                    std::string tag = assign_tag( word );
-            
-            
-                    tagged.append( toks[i] + "/" + tag + " " );
+                for( unsigned i = 0; i < scratch_tokens.size(); ++i ){
+                    const token &t = scratch_tokens.tokens[i];
+                    tagged.append( t.begin, t.length );
+                    tagged.append( "/" );
+                    tagged.append( lexicon->tag_name( scratch_tokens.tags[i] ) );
+                    tagged.append( " " );
                 }
                 return tagged;
             }
@@ -190,7 +270,7 @@ namespace semantic {
  * ********************************************************************** */
             void reset()
             {
-                previous_tag = "PP";
+                previous_tag = tag_PP;
             }
 
 /* **********************************************************************
@@ -199,14 +279,18 @@ namespace semantic {
             std::map<std::string,int> get_POS( const std::string& text,
                                                const std::set<std::string>& exps){
 
-                std::vector<std::string> toks =  tokenize( text );
+                std::vector<bool> wanted( lexicon->num_tags(), false );
+                for( std::set<std::string>::const_iterator pos = exps.begin(); pos != exps.end(); ++pos ){
+                    compiled_lexicon::tag_id t = lexicon->find_tag( *pos );
+                    if( t != compiled_lexicon::no_tag ) wanted[t] = true;
+                }
+
+                tag( text, scratch_tokens );
                 std::map<std::string,int> terms;
 
-                for( unsigned i = 0; i < toks.size(); ++i ){
-                    std::string word = clean_word( toks[i] );
-                    std::string tag = assign_tag( word );
-                    if( exps.count(tag)){
-                        terms[toks[i]]++;
+                for( unsigned i = 0; i < scratch_tokens.size(); ++i ){
+                    if( wanted[scratch_tokens.tags[i]] ){
+                        terms[scratch_tokens.tokens[i].str()]++;
                     }
                 }
                 return terms;
@@ -295,16 +379,14 @@ namespace semantic {
  *        Get the maximal noun phrases from the given text string
  * ********************************************************************** */
             std::map<std::string,int> get_maximal_noun_phrases( const std::string& text ){
-                std::vector<std::string> toks = tokenize( text );
+                tag( text, scratch_tokens );
+                const std::vector<token> &words = scratch_tokens.tokens;
+                const std::vector<compiled_lexicon::tag_id> &tags = scratch_tokens.tags;
                 std::map<std::string,int> terms;
                 std::string simplified;
-                std::vector<std::string> words;
-                std::vector<std::string> tags;
-                for( unsigned i = 0; i < toks.size(); ++i ){
-                    std::string tag = assign_tag( clean_word( toks[i] ) );
-                    words.push_back( toks[i] );
-                    tags.push_back( tag );
-                    simplified += simplify_tag( tag );
+                simplified.reserve( tags.size() );
+                for( unsigned i = 0; i < tags.size(); ++i ){
+                    simplified += simple_tags[tags[i]];
                 }
 
                 std::vector<std::pair<std::string::size_type,
@@ -323,7 +405,9 @@ namespace semantic {
                     std::string::size_type mnp_length = pos->second;
                     for( std::string::size_type i = start;
                              i < start + mnp_length; ++i){
-                        term += words[i] + "/" + tags[i];
+                        term.append( words[i].begin, words[i].length );
+                        term += "/";
+                        term += lexicon->tag_name( tags[i] );
                         if( i < start+mnp_length-1 ){
                             term += " ";
                         }
@@ -537,24 +621,77 @@ namespace semantic {
 %#
 #%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%*/
         private:
-            std::string previous_tag;
+            compiled_lexicon::tag_id previous_tag;
             std::string letters;
             std::string upper_case;
             std::string numbers;
 
 
 
-            typedef maps::ordered<std::string, unsigned long> LexiconValueMap;
-            typedef maps::unordered<std::string, LexiconValueMap> LexiconMap;
-            LexiconMap LEXICON;
-            LexiconMap HMM;
+            compiled_lexicon::pointer lexicon;
+            compiled_lexicon::tag_id tag_PP, tag_NN, tag_SYM;
+            compiled_lexicon::word_id word_SYM;
+
+            // scratch space, kept between calls so it stops allocating
+            Abbreviations abbrs;
+            tagged_tokens scratch_tokens;
+            std::string lower;
+
+            // per tag id, what simplify_tag() makes of it
+            std::string simple_tags;
+
+            // per byte, what the tokenizer makes of it
+            enum { delimiter = 1, alphanumeric = 2, letter = 4 };
+            unsigned char char_class[256];
 
 
             void init(){
+                tag_PP = lexicon->find_tag("PP");
+                tag_NN = lexicon->find_tag("NN");
+                tag_SYM = lexicon->find_tag("SYM");
+                word_SYM = lexicon->find_word("*SYM*");
                 reset();
                 numbers = "0123456789";
                 upper_case = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
                 letters = "abcdefghijklmnopqrstuvwxyz"+upper_case;
+
+                simple_tags.clear();
+                for( std::size_t t = 0; t < lexicon->num_tags(); t++ ){
+                    simple_tags += simplify_tag( lexicon->tag_name(t) );
+                }
+
+                std::fill( char_class, char_class + 256, 0 );
+                std::string delim = "\x20\x09\x0a\x0c\x0d\xa0\x85";
+                for( std::string::size_type i = 0; i < delim.size(); i++ )
+                    char_class[(unsigned char)delim[i]] |= delimiter;
+                for( std::string::size_type i = 0; i < letters.size(); i++ )
+                    char_class[(unsigned char)letters[i]] |= alphanumeric | letter;
+                for( std::string::size_type i = 0; i < numbers.size(); i++ )
+                    char_class[(unsigned char)numbers[i]] |= alphanumeric;
+            }
+
+
+/* **********************************************************************
+ *        Used by `tokenize`
+ * ********************************************************************** */
+            bool only_letters( const char *s, std::string::size_type length ) const {
+                for( std::string::size_type i = 0; i < length; i++ ){
+                    if( !(char_class[(unsigned char)s[i]] & letter) ) return false;
+                }
+                return true;
+            }
+
+            static token resolve( const tagged_tokens& out, const char *base,
+                                  const tagged_tokens::piece& p ){
+                token t = { (p.rewritten ? out.scratch.data() : base) + p.offset, p.length };
+                return t;
+            }
+
+            // does this token keep a period in front of it off the word?
+            static bool next_starts_sentence( const token& t ){
+                return t.length == 0 ||
+                       isupper( (unsigned char)t.begin[0] ) ||
+                       !isalpha( (unsigned char)t.begin[0] );
             }
 
 
@@ -904,7 +1041,8 @@ namespace semantic {
 
 
 /* *********************************************************************
- *        Load the lexicon into a 2-dimensional std::map
+ *        Load the lexicon -- compiled once per file and shared
+ *        by every tagger that asks for the same file
  *********************************************************************** */
             void load_lexicon( const std::string& filename="" )
             {
@@ -925,61 +1063,16 @@ namespace semantic {
             }
 
             bool try_loading_lexicon( const std::string &filename ) {
-                std::ifstream file;
-                file.open(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-                if( file ){
-                    load_lexicon(file);
-                    file.clear();
-                    file.close();
+                try {
+                    lexicon = compiled_lexicon::shared( filename );
                     return true;
+                } catch ( LexiconException &e ){
+                    return false;
                 }
-                return false;
             }
 
             void load_lexicon( std::istream& lex_stream ){
-                std::string lex = "hmm";
-                std::string line;
-
-                while (std::getline(lex_stream,line)) {
-
-                    if( line.compare(0,10,"## Lexicon") == 0 ){
-                        lex = "lex";
-                    } else if ( line.compare(0,22,"## Hidden Markov Model") == 0){
-                        lex = "hmm";
-                    }
-
-                    if ( line.compare(0,1,"#") != 0 ) {
-                        std::string::size_type pos = line.find_first_of(" ", 0);
-                        std::string word = line.substr(0,pos-1);
-                        std::string delim = " {},:";
-                        std::string::size_type lastPos = line.find_first_not_of(delim,pos);
-                        pos = line.find_first_of(delim,lastPos);
-
-
-                        while( pos != std::string::npos || lastPos != std::string::npos ){
-
-                            // POS TAG
-                            std::string tag = line.substr(lastPos,pos-lastPos);
-                            lastPos = line.find_first_not_of(delim,pos);
-                            pos = line.find_first_of(delim,lastPos);
-
-                            // Frequency
-                            unsigned long value;
-                            std::string num = line.substr(lastPos,pos-lastPos);
-                            value = strtoul( num.c_str(), NULL, 10 );
-                            lastPos = line.find_first_not_of(delim,pos);
-                            pos = line.find_first_of(delim,lastPos);
-
-                            // Record
-                            if( lex == "lex" ){
-                                LEXICON[word][tag] = value;
-                            } else if ( lex == "hmm" ) {
-                                HMM[word][tag] = value;
-                            }
-                        }
-
-                    }
-                }
+                lexicon = compiled_lexicon::pointer( new compiled_lexicon( lex_stream ) );
             }
 
 
@@ -988,58 +1081,30 @@ namespace semantic {
 /* **********************************************************************
  *        Viterbi Algorithm --> Bayesian logic applied to values in lexica
  * ********************************************************************** */
-            std::string assign_tag( const std::string& word )
+            compiled_lexicon::tag_id assign_tag( compiled_lexicon::word_id word )
             {
-                if( word == "*SYM*")
-                    return "SYM";
-
-                
-                std::string best_tag( "NN" );
-                unsigned long best_so_far = 0;
-                
-                LexiconValueMap &wordtags = LEXICON[word];
-                LexiconValueMap &hmmtags = HMM[previous_tag];
-                
-                for( LexiconValueMap::iterator pos = wordtags.begin();
-                         pos != wordtags.end();
-                         ++pos ) {
-                    std::string tag = pos->first;
-                    if( hmmtags.count( tag ) ){
-                        unsigned long probability = hmmtags[tag] * ( pos->second + 1 );
-                        if( probability > best_so_far ){
-                            best_so_far = probability;
-                            best_tag = tag;
-                        }
-                    }
-                }
-                previous_tag = best_tag;
-                
-                return best_tag;
-            }
-
-/*        A slightly slower version of the above     */
-            std::string assign_tag_slower( const std::string& word )
-            {
-                if( word == "*SYM*")
-                    return "SYM";
-
-                std::string best_tag( "NN" );
+                compiled_lexicon::tag_id best_tag = tag_NN;
                 unsigned long best_so_far = 0;
 
-                LexiconValueMap &wordtags = LEXICON[word];
-                LexiconValueMap &hmmtags = HMM[previous_tag];
+                // the word's tags come in tag order, so ties go to the
+                // alphabetically first tag like they always have
+                std::pair<const compiled_lexicon::tag_count*,
+                          const compiled_lexicon::tag_count*> wordtags = lexicon->tags( word );
 
-                for(LexiconValueMap::iterator pos = hmmtags.begin(); pos != hmmtags.end(); ++pos) {
-                    std::string tag = pos->first;
-                    if( wordtags.count( tag ) ){
-                        unsigned long probability = pos->second * ( wordtags[tag] + 1 );
+                for( const compiled_lexicon::tag_count *pos = wordtags.first;
+                         pos != wordtags.second;
+                         ++pos ) {
+                    unsigned long transitions = lexicon->transition( previous_tag, pos->tag );
+                    if( transitions ){
+                        unsigned long probability = transitions * ( (unsigned long)pos->count + 1 );
                         if( probability > best_so_far ){
                             best_so_far = probability;
-                            best_tag = tag;
+                            best_tag = pos->tag;
                         }
                     }
                 }
                 previous_tag = best_tag;
+                
                 return best_tag;
             }
 
@@ -1079,38 +1144,43 @@ namespace semantic {
 
 
 /* *********************************************************************
- *        Decide what form of the word to analyze
+ *        Decide what form of the word to analyze, and tag it
  *********************************************************************** */
-            std::string clean_word( const std::string& word )
+            compiled_lexicon::tag_id tag_token( const char *word, std::string::size_type length )
             {
+                lower.assign( word, length );
+                for( std::string::size_type i = 0; i < length; i++ )
+                    lower[i] = tolower( (unsigned char)lower[i] );
 
-                std::string lower(word);
-                std::transform( word.begin(), word.end(), lower.begin(), tolower );
+                compiled_lexicon::word_id id = lexicon->no_word();
 
                 // if it looks like this word starts a sentence, try lower case first
-                if( previous_tag == "PP" && is_upper(word) ){
-                    // Does the word exist as a lower case word?
-                    if( LEXICON.count( lower ) && word != "I" ){
-                        // NOTE: it would be better to have an actual comparison count
-                        // here -- use lower if more common than upper...
-                        return lower;
-                    }
+                if( previous_tag == tag_PP && length > 0 && isupper( (unsigned char)word[0] ) &&
+                        !( length == 1 && word[0] == 'I' ) ){
+                    // NOTE: it would be better to have an actual comparison count
+                    // here -- use lower if more common than upper...
+                    id = lexicon->find_word( lower );
                 }
 
                 // Does the word exist in the lexicon as-is?
-                if( LEXICON.count( word ) ){
-                    return word;
-                }
+                if( id == lexicon->no_word() )
+                    id = lexicon->find_word( word, length );
 
                 // Does the word exist as a lower case word?
-                if( LEXICON.count( lower ) ){
-                    return lower;
-                }
-
+                if( id == lexicon->no_word() )
+                    id = lexicon->find_word( lower );
 
                 // Otherwise, classify by word morphology
-                return classify_unknown_word( word );
+                if( id == lexicon->no_word() ){
+                    std::string unknown = classify_unknown_word( std::string( word, length ) );
+                    if( unknown == "*SYM*" )
+                        return tag_SYM;
+                    id = lexicon->find_word( unknown );
+                } else if( id == word_SYM ){
+                    return tag_SYM;
+                }
 
+                return assign_tag( id );
             }
 
 
@@ -1167,7 +1237,7 @@ namespace semantic {
                     if( pos > 0 &&
                         word.find_last_of(letters+numbers,pos) == pos-1 &&
                         word.find_first_of(letters+numbers,pos) == pos+1){
-                        if( LEXICON.count( word.substr(pos+1,word.size()-1-pos) ) ){
+                        if( lexicon->contains( word.substr(pos+1,word.size()-1-pos) ) ){
                             return "*HYP-ADJ*";
                         } else {
                             return "*HYP*";
@@ -0,0 +1,246 @@
+/*
+interns the strings that go through indexing -- the stemmed terms and the
+words they were stemmed from -- so the parser and the indexer can pass
+around and count small integer ids instead of strings.
+
+each distinct string is stored once, packed into large blocks, and gets a
+dense id (0, 1, 2... in the order they were first seen), which means
+anything kept per term can live in a vector indexed by id.
+
+the dictionary is locked with a mutex when the Boost thread library was
+found at configure time (the parallel indexer's parsers share one), and is
+for single threaded use otherwise.
+*/
+
+#ifndef __SEMANTIC_TERM_DICTIONARY_HPP__
+#define __SEMANTIC_TERM_DICTIONARY_HPP__
+
+#include <semantic/config.hpp>
+#include <semantic/utility.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/utility.hpp>
+#include <boost/cstdint.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <cstddef>
+
+namespace semantic {
+
+	typedef unsigned int term_id;
+
+	// what find() says about a string that hasn't been interned
+	const term_id no_term = ~term_id(0);
+
+	class term_dictionary : boost::noncopyable {
+		public:
+			term_dictionary() : m_buckets(1024, no_term), m_block_used(block_size), m_block_bytes(0) {}
+
+			~term_dictionary() {
+				free_blocks();
+			}
+
+			// the id for s, adding it if it's new
+			term_id intern(const std::string &s) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return insert(s.data(), s.size());
+			}
+
+			// intern() for each of i -> i_end, under one lock
+			template <class Iterator, class OutIterator>
+			void intern(Iterator i, Iterator i_end, OutIterator out) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				for(; i != i_end; ++i, ++out) *out = insert(i->data(), i->size());
+			}
+
+			// the id for s, or no_term
+			term_id find(const std::string &s) const {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				std::size_t h = hash(s.data(), s.size());
+				for(std::size_t b = h & (m_buckets.size() - 1); m_buckets[b] != no_term; b = (b + 1) & (m_buckets.size() - 1)) {
+					if (matches(m_entries[m_buckets[b]], h, s.data(), s.size())) return m_buckets[b];
+				}
+				return no_term;
+			}
+
+			std::string str(term_id id) const {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				const entry &e = m_entries[id];
+				return std::string(e.text, e.length);
+			}
+
+			// how many strings there are; the ids run from 0 to size() - 1
+			std::size_t size() const {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_entries.size();
+			}
+
+			// roughly what the dictionary costs us
+			std::size_t bytes() const {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				return m_block_bytes + m_entries.capacity() * sizeof(entry) + m_buckets.capacity() * sizeof(term_id);
+			}
+
+			void clear() {
+#if SEMANTIC_HAVE_BOOST_THREAD
+				boost::mutex::scoped_lock lock(m_mutex);
+#endif
+				free_blocks();
+				m_entries.clear();
+				m_buckets.assign(1024, no_term);
+			}
+
+		private:
+			enum { block_size = 64 * 1024 };
+
+			struct entry {
+				const char *text;
+				std::size_t length;
+				std::size_t hash;
+			};
+
+			std::vector<entry> m_entries;		// by id
+			std::vector<term_id> m_buckets;		// open addressing, a power of two of them
+			std::vector<char *> m_blocks;		// where the strings live
+			std::size_t m_block_used, m_block_bytes;
+#if SEMANTIC_HAVE_BOOST_THREAD
+			mutable boost::mutex m_mutex;
+#endif
+
+			// (the lock is held for all of these)
+			static std::size_t hash(const char *s, std::size_t n) {
+				boost::uint32_t h = 2166136261u;	// FNV-1a
+				for(std::size_t i = 0; i < n; ++i) {
+					h ^= static_cast<unsigned char>(s[i]);
+					h *= 16777619u;
+				}
+				return h;
+			}
+
+			static bool matches(const entry &e, std::size_t h, const char *s, std::size_t n) {
+				return e.hash == h && e.length == n && std::memcmp(e.text, s, n) == 0;
+			}
+
+			term_id insert(const char *s, std::size_t n) {
+				std::size_t h = hash(s, n);
+				std::size_t b = h & (m_buckets.size() - 1);
+				for(; m_buckets[b] != no_term; b = (b + 1) & (m_buckets.size() - 1)) {
+					if (matches(m_entries[m_buckets[b]], h, s, n)) return m_buckets[b];
+				}
+
+				entry e;
+				e.text = store(s, n);
+				e.length = n;
+				e.hash = h;
+				term_id id = static_cast<term_id>(m_entries.size());
+				m_entries.push_back(e);
+				m_buckets[b] = id;
+
+				// keep it no more than half full
+				if (m_entries.size() * 2 > m_buckets.size()) rehash(m_buckets.size() * 2);
+				return id;
+			}
+
+			void rehash(std::size_t buckets) {
+				m_buckets.assign(buckets, no_term);
+				for(term_id id = 0; id < m_entries.size(); ++id) {
+					std::size_t b = m_entries[id].hash & (buckets - 1);
+					while (m_buckets[b] != no_term) b = (b + 1) & (buckets - 1);
+					m_buckets[b] = id;
+				}
+			}
+
+			// a copy of s in the current block, or a block of its own if it's huge
+			const char *store(const char *s, std::size_t n) {
+				char *text;
+				if (n + 1 > block_size) {
+					text = new char[n + 1];
+					m_blocks.insert(m_blocks.end() - (m_blocks.empty() ? 0 : 1), text);
+					m_block_bytes += n + 1;
+				} else {
+					if (m_block_used + n + 1 > block_size) {
+						m_blocks.push_back(new char[block_size]);
+						m_block_used = 0;
+						m_block_bytes += block_size;
+					}
+					text = m_blocks.back() + m_block_used;
+					m_block_used += n + 1;
+				}
+				std::memcpy(text, s, n);
+				text[n] = '\0';
+				return text;
+			}
+
+			void free_blocks() {
+				for(std::vector<char *>::iterator b = m_blocks.begin(); b != m_blocks.end(); ++b) delete[] *b;
+				m_blocks.clear();
+				m_block_used = block_size;
+				m_block_bytes = 0;
+			}
+	};
+
+
+	// how many times each word turned up as each (stemmed) term: the
+	// unstemmed variants the indexer picks a display form from
+	class variant_counts {
+		public:
+			struct variant {
+				term_id term, word;
+				unsigned int count;
+			};
+
+			void add(term_id term, term_id word, unsigned int n = 1) {
+				m_counts[key(term, word)] += n;
+			}
+
+			void merge(const variant_counts &other) {
+				for(count_map::const_iterator i = other.m_counts.begin(); i != other.m_counts.end(); ++i) {
+					m_counts[i->first] += i->second;
+				}
+			}
+
+			// out gets a variant for each (term, word)
+			template <class OutIterator>
+			void variants(OutIterator out) const {
+				for(count_map::const_iterator i = m_counts.begin(); i != m_counts.end(); ++i, ++out) {
+					variant v;
+					v.term = static_cast<term_id>(i->first >> 32);
+					v.word = static_cast<term_id>(i->first & 0xffffffffu);
+					v.count = i->second;
+					*out = v;
+				}
+			}
+
+			std::size_t size() const { return m_counts.size(); }
+			bool empty() const { return m_counts.empty(); }
+			void clear() { m_counts.clear(); }
+
+		private:
+			typedef maps::unordered<boost::uint64_t, unsigned int> count_map;
+			count_map m_counts;
+
+			static boost::uint64_t key(term_id term, term_id word) {
+				return (static_cast<boost::uint64_t>(term) << 32) | word;
+			}
+	};
+
+} // namespace semantic
+
+#endif
@@ -4,6 +4,7 @@
 #define _IDF_WEIGHTING_HPP_
 
 #include <math.h>
+#include <string>
 
 namespace semantic {
 
@@ -11,6 +12,13 @@ namespace semantic {
         public:
             typedef double weight_type;
 
+            // for precomputing (see weighting/precomputed.hpp): count is the
+            // number of vertices of the source's type
+            static std::string name() { return "idf"; }
+            static double edge_weight(int, unsigned long, unsigned long degree_to, unsigned long count) {
+                return (float)log(1+count/(double)degree_to);
+            }
+
             
             template<class Vertex, class NeighborList, class Graph, class WeightMap>
             void apply_weights(Vertex u, const NeighborList &nlist, Graph &g, WeightMap w)
@@ -3,6 +3,7 @@
 #define _LG_WEIGHTING_HPP_
 
 #include <map>
+#include <string>
 #include <semantic/utility.hpp>
 #include <boost/graph/properties.hpp>
 
@@ -15,6 +16,13 @@ namespace semantic {
             typedef typename Global::weight_type global_weight_type;
             typedef WeightType weight_type;
 
+            // for precomputing (see weighting/precomputed.hpp)
+            static std::string name() { return "lg(" + Local::name() + "," + Global::name() + ")"; }
+            static double edge_weight(int strength, unsigned long degree_from, unsigned long degree_to, unsigned long count) {
+                return Local::edge_weight(strength, degree_from, degree_to, count)
+                     * Global::edge_weight(strength, degree_from, degree_to, count);
+            }
+
             
             template<class Vertex, class NeighborList, class Graph, class WeightMap>
             void apply_weights(Vertex u, const NeighborList &nlist, Graph &g, WeightMap w)
@@ -0,0 +1,136 @@
+/*
+edge weights worked out once, at indexing time, instead of for every search.
+
+the TF and IDF weights only depend on what's in an edge_query row -- the
+strength, the degrees -- and on the number of vertices of the source's type,
+so the storage policies can fill in a weight column for the whole collection
+when they clean up after indexing.  which weighting they use is the
+collection's "weighting" meta value (the name() of a weighting policy, see
+text_indexer::set_weighting()), "lg(tf,idf)" if it isn't set, looked up in
+the weighting_registry.
+
+PrecomputedWeighting then just reads the weights back off the edges, and
+falls back on its Fallback policy for any vertex with edges that don't have
+one (a collection indexed before there was a weight column, or with a
+weighting nobody registered).
+*/
+
+#ifndef _PRECOMPUTED_WEIGHTING_HPP_
+#define _PRECOMPUTED_WEIGHTING_HPP_
+
+#include <semantic/config.hpp>
+#include <semantic/weighting/none.hpp>
+#include <semantic/weighting/tf.hpp>
+#include <semantic/weighting/idf.hpp>
+#include <semantic/weighting/lg.hpp>
+
+#if SEMANTIC_HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+#include <boost/utility.hpp>
+
+#include <string>
+#include <map>
+
+namespace semantic {
+
+    // an edge's weight from its edge_query row and the number of vertices
+    // of its source's type
+    typedef double (*edge_weight_function)(int strength, unsigned long degree_from,
+                                           unsigned long degree_to, unsigned long count);
+
+    // the weightings the storage policies can precompute, by name
+    class weighting_registry : boost::noncopyable {
+        public:
+            static weighting_registry &shared() {
+                static weighting_registry registry;
+                return registry;
+            }
+
+            template <class WeightingPolicy>
+            void add() {
+                add(WeightingPolicy::name(), &WeightingPolicy::edge_weight);
+            }
+
+            void add(const std::string &name, edge_weight_function f) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+                boost::mutex::scoped_lock lock(m_mutex);
+#endif
+                m_functions[name] = f;
+            }
+
+            // NULL if there's no weighting by that name
+            edge_weight_function find(const std::string &name) {
+#if SEMANTIC_HAVE_BOOST_THREAD
+                boost::mutex::scoped_lock lock(m_mutex);
+#endif
+                std::map<std::string, edge_weight_function>::iterator f = m_functions.find(name);
+                return f == m_functions.end() ? NULL : f->second;
+            }
+
+            // what storage uses when the collection doesn't say
+            static std::string default_name() { return "lg(tf,idf)"; }
+
+        private:
+            std::map<std::string, edge_weight_function> m_functions;
+#if SEMANTIC_HAVE_BOOST_THREAD
+            boost::mutex m_mutex;
+#endif
+
+            weighting_registry() {
+                add<NoWeighting>();
+                add<TFWeighting>();
+                add<IDFWeighting>();
+                add<LGWeighting<TFWeighting, IDFWeighting, double> >();
+                add<LGWeighting<NoWeighting, IDFWeighting, double> >();
+                add<LGWeighting<TFWeighting, NoWeighting, double> >();
+            }
+    };
+
+
+    template <class Fallback = LGWeighting<TFWeighting, IDFWeighting, double> >
+    class PrecomputedWeighting {
+        public:
+            typedef double weight_type;
+
+            static std::string name() { return Fallback::name(); }
+
+            template<class Vertex, class NeighborList, class Graph, class WeightMap>
+            void apply_weights(Vertex u, const NeighborList &nlist, Graph &g, WeightMap w)
+            {
+                typedef typename NeighborList::const_iterator iterator;
+
+                iterator ei;
+                for(ei = nlist.begin(); ei != nlist.end(); ++ei) {
+                    if ((*ei).first.weight < 0) {
+                        fallback.apply_weights(u, nlist, g, w);
+                        return;
+                    }
+                }
+                for(ei = nlist.begin(); ei != nlist.end(); ++ei) put(w, g.get_vertex_id((*ei).second), (*ei).first.weight);
+            }
+
+            template<class Vertex, class Graph, class WeightMap>
+            void apply_weights(Vertex u, Graph &g, WeightMap w)
+            {
+                typedef typename se_graph_traits<Graph>::out_edge_iterator iterator;
+                typedef typename se_graph_traits<Graph>::edge_descriptor edge;
+                function_requires< WritablePropertyMapConcept<WeightMap, edge> >();
+
+                iterator ei, ei_end;
+                for(boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                    if (g[*ei].weight < 0) {
+                        fallback.apply_weights(u, g, w);
+                        return;
+                    }
+                }
+                for(boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) put(w, *ei, g[*ei].weight);
+            }
+
+        private:
+            Fallback fallback;
+    };
+
+} // namespace semantic
+
+#endif // _PRECOMPUTED_WEIGHTING_HPP_
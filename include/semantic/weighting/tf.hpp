@@ -4,6 +4,7 @@
 #define _TF_WEIGHTING_HPP_
 
 #include <math.h>
+#include <string>
 
 namespace semantic {
 
@@ -11,6 +12,10 @@ namespace semantic {
         public:
             typedef double weight_type;
 
+            // for precomputing (see weighting/precomputed.hpp)
+            static std::string name() { return "tf"; }
+            static double edge_weight(int strength, unsigned long, unsigned long, unsigned long) { return strength; }
+
             
             template<class Vertex, class NeighborList, class Graph, class WeightMap>
             void apply_weights(Vertex, const NeighborList &nlist, Graph &g, WeightMap w)
@@ -3,6 +3,7 @@
 // semantic
 #include <semantic/analysis/linlog.hpp>
 #include <semantic/analysis/agglomerate_clustering/cluster_helper.hpp>
+#include <semantic/analysis/agglomerate_clustering/euclidean_mst.hpp>
 
 
 #include "clusters.h"
@@ -243,47 +244,29 @@ void ClusteringThread::run() {
 
     if (safeTerminate_) return;
 
-	// use the position map to generate a distance map
-    typedef semantic::se_graph_traits<Graph>::vertex_pair_edge edge;
-    typedef semantic::se_graph_traits<Graph>::vertex_descriptor vertex;
-    maps::unordered<edge, double> distances;
-    maps::unordered<vertex, maps::unordered<vertex, double> > distances_2d;
+    // cluster by where the vertices ended up
+    PositionMap positions;
     BGL_FORALL_VERTICES(u, *graph_, Graph) {
-        if (safeTerminate_) return;
-        BGL_FORALL_VERTICES(v, *graph_, Graph) {
-            edge e1(u,v), e2(v,u);
-            double distance = maps.position[maps.vertex_index[u]].dist(maps.position[maps.vertex_index[v]]);
-            distances[e1] = distances[e2] = distance;
-            distances_2d[u][v] = distances_2d[v][u] = distance;
-        }
+        positions[u] = maps.position[maps.vertex_index[u]];
     }
     
     if (safeTerminate_) return;
-    // now generate an MST
-    std::vector<edge> mst;
-	semantic::minimum_weight_spanning_tree(*graph_, extract_keys(distances.begin()), extract_keys(distances.end()), boost::make_assoc_property_map(distances), back_inserter(mst));
-    if (safeTerminate_) return;
-    
-    // create the dendrogram
-	semantic::dendrogram_from_distance_mst(*graph_, mst, boost::make_assoc_property_map(distances), dendrogram_, SingleLinkDistanceCalculator());
+	semantic::analysis::dendrogram_from_layout(*graph_, boost::make_assoc_property_map(positions), dendrogram_);
     
     // now let's silhouette this baby
-    // measuring clusters between having 2 and having n-1 (or 30, whichever is smaller)... test silhouettes
+    // measuring clusters between having 2 and having n-1 (or 20, whichever is smaller), all in one sweep
+	std::vector<std::pair<unsigned int, double> > silhouettes;
+	dendrogram_.layout_silhouettes(boost::make_assoc_property_map(positions), 2, max_num_clusters - 1,
+		back_inserter(silhouettes), QThread::idealThreadCount() > 0 ? QThread::idealThreadCount() : 1);
 	unsigned int best_num = 0;
     double best_silhouette = 0;
-	for(unsigned int i = 2; i < max_num_clusters; i++) {
-        maps::unordered<vertex, unsigned long> cluster_map;
-        dendrogram_.set_num_clusters(i);
-        dendrogram_.get_clusters(inserter(cluster_map, cluster_map.begin()));
-        // silhouette!!!
-        maps::unordered<vertex, double> quality_map;
-        double quality = semantic::analysis::silhouette(*graph_, boost::make_assoc_property_map(cluster_map), boost::make_assoc_property_map(distances_2d), boost::make_assoc_property_map(quality_map));
-        if (quality > best_silhouette) {
-            best_silhouette = quality;
-            best_num = i;
+	for(unsigned int i = silhouettes.size(); i-- > 0; ) {		// (they come most clusters first)
+        if (silhouettes[i].second > best_silhouette) {
+            best_silhouette = silhouettes[i].second;
+            best_num = silhouettes[i].first;
         }
-        progress(iterations + i, iterations + max_num_clusters);
     }
+	if (safeTerminate_) return;
 	
 	
     if (best_num < 2) best_num = 5; // why not
@@ -100,7 +100,7 @@ create procedure update_edge_query (IN p_collection INT)
 		delete from edge_query where fk_collection = p_collection;
 		
 		-- second re-populate
-		insert into edge_query
+		insert into edge_query (id, fk_collection, fk_node_from, fk_node_to, strength, degree_from, degree_to, type_major, type_minor)
 			select
 				e.id,
 				n_from.fk_collection,
@@ -171,7 +171,7 @@ create procedure update_dirty_edge_query (IN p_collection INT)
 		delete from edge_query where fk_node_from in (select fk_node from dirty_node, node where id = fk_node and fk_collection = p_collection and cleaning = 1);
 		
 		-- second re-populate
-		insert into edge_query
+		insert into edge_query (id, fk_collection, fk_node_from, fk_node_to, strength, degree_from, degree_to, type_major, type_minor)
 			select
 				e.id,
 				n_from.fk_collection,
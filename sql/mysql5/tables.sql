@@ -101,6 +101,7 @@ CREATE TABLE `edge_query` (
   `degree_to` smallint(5) unsigned NOT NULL,
   `type_major` tinyint(3) unsigned NOT NULL,
   `type_minor` tinyint(3) unsigned NOT NULL,
+  `weight` double default NULL,
   PRIMARY KEY  (`id`),
   KEY `fk_node_from` (`fk_node_from`)
 ) ENGINE=InnoDB DEFAULT CHARSET=latin1;
@@ -72,6 +72,7 @@ CREATE TABLE 'edge_query' (
   'degree_to' integer,
   'type_major' integer,
   'type_minor' integer,
+  'weight' real,
   UNIQUE ('fk_node_from', 'fk_node_to')
 );
 
@@ -111,3 +112,9 @@ CREATE TABLE 'node_meta' (
    'value' text, 
    UNIQUE('fk_node','key') 
 );
+
+--
+-- Indexes used by the incremental edge_query maintenance
+--
+CREATE INDEX 'edge_fk_node_to' ON 'edge' ('fk_node_to');
+CREATE INDEX 'degree_type_major_degree' ON 'degree' ('type_major', 'degree');
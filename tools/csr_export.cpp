@@ -0,0 +1,121 @@
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/positional_options.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/parsers.hpp>
+
+#include <semantic/semantic.hpp>
+#include <semantic/version.hpp>
+#include <semantic/storage/csr.hpp>
+
+#if SEMANTIC_HAVE_MYSQL
+#include <semantic/storage/mysql5.hpp>
+#endif
+#if SEMANTIC_HAVE_SQLITE3
+#include <semantic/storage/sqlite3.hpp>
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace semantic;
+namespace po = boost::program_options;
+
+#define usage() \
+	std::cerr << "Usage: " << argv[0] << " [options] <output file>" << std::endl << std::endl; \
+	std::cerr << "Writes a collection out as a read-only CSR index for searching." << std::endl << std::endl; \
+	std::cerr << "Options: " << std::endl; \
+	std::cerr << opts << std::endl; \
+	return EXIT_FAILURE; \
+
+
+template <class Graph>
+void report(Graph &g, const std::string &output) {
+	export_csr(g, output);
+
+	// read it back, which also checks that it maps
+	SEGraph<CSRStoragePolicy> csr(g.collection());
+	csr.set_file(output);
+	std::cout << output << ": collection '" << g.collection() << "', "
+	          << csr.get_vertex_count_of_type(node_type_major_doc) << " documents, "
+	          << csr.get_vertex_count_of_type(node_type_major_term) << " terms" << std::endl;
+}
+
+
+int main( int argc, char* argv[]){
+	po::options_description opts;
+	opts.add_options()
+		("help", "produce this help message\n")
+		("version", "print version information\n")
+		("collection,c", po::value<std::string>()->default_value("My Collection"), "The collection to export\n")
+#if SEMANTIC_HAVE_SQLITE3
+		("sqlite,s", po::value<std::string>(), "the SQLite 3 database file to export from\n")
+#endif
+#if SEMANTIC_HAVE_MYSQL
+		("mysql,m", po::value<std::string>(), "the MySQL database name")
+		("mysql_username,u", po::value<std::string>()->default_value(std::getenv("USER")), "the MySQL database username")
+		("mysql_password,p", po::value<std::string>()->default_value(""), "the MySQL database password")
+		("mysql_hostname,h", po::value<std::string>()->default_value("localhost"), "the MySQL database host\n")
+#endif
+		;
+
+	po::variables_map vm;
+	try {
+		po::options_description hidden_opts;
+		hidden_opts.add_options()
+			("output", po::value<std::string>(), "the file to write")
+			;
+
+		po::options_description all_opts;
+		all_opts.add(opts).add(hidden_opts);
+
+		po::positional_options_description positional_opts;
+		positional_opts.add("output",1);
+		po::store(po::command_line_parser(argc, argv).options(all_opts).positional(positional_opts).run(), vm);
+		po::notify(vm);
+	} catch (std::exception &e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		usage();
+	}
+
+	if (vm.count("help")){
+		usage();
+	}
+
+	if (vm.count("version")) {
+		std::cerr << std::endl;
+		print_version_info(std::cerr);
+		std::cerr << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	if (!vm.count("output") || (!vm.count("mysql") && !vm.count("sqlite"))) {
+		usage();
+	}
+
+	std::string output = vm["output"].as<std::string>();
+	try {
+		if (vm.count("sqlite")) {
+#if SEMANTIC_HAVE_SQLITE3
+			SEGraph<SQLite3StoragePolicy> g(vm["collection"].as<std::string>());
+			g.set_file(vm["sqlite"].as<std::string>());
+			report(g, output);
+#endif
+		} else {
+#if SEMANTIC_HAVE_MYSQL
+			SEGraph<MySQL5StoragePolicy> g(vm["collection"].as<std::string>());
+			g.set_host(vm["mysql_hostname"].as<std::string>());
+			g.set_user(vm["mysql_username"].as<std::string>());
+			g.set_pass(vm["mysql_password"].as<std::string>());
+			g.set_database(vm["mysql"].as<std::string>());
+			report(g, output);
+#endif
+		}
+	} catch (std::exception &e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
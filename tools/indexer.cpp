@@ -18,6 +18,7 @@
 #include <semantic/storage/mysql5.hpp>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -26,6 +27,10 @@
 #include <set>
 #include <vector>
 
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
 using namespace semantic;
 
 namespace po = boost::program_options;
@@ -40,6 +45,11 @@ typedef SEGraph<MySQL5StoragePolicy> MySQLGraph;
 
 typedef std::map<std::string,int> UnstemmedCount;
 std::string encoding;
+unsigned int split_paragraphs = 0;
+std::string split_delimiter;
+std::string language;
+bool detect_languages = false;
+unsigned int memory_budget = 0;		// megabytes; 0 for no limit
 
 #define usage() \
 	std::cerr << "Usage: " << argv[0] << " [options] <directory to index>" << std::endl << std::endl; \
@@ -74,13 +84,23 @@ std::set<std::string> load_stoplist(const std::string &filename){
 }
 	
 template <class Graph>
-bool do_indexing(Graph &g, text_indexer<Graph> &indexer, const std::vector<std::string> &filenames, const std::string term_type, int stemmer = 1, int verbose = 0 ){
+bool do_indexing(Graph &g, text_indexer<Graph> &indexer, const std::vector<std::string> &filenames, const std::string term_type, int stemmer = 1, int verbose = 0, unsigned int threads = 1 ){
 	
 	
  	std::set<std::string> blacklist = load_stoplist("../share/stoplist_en.txt");
 	
 	
 	std::string max = g.get_meta_value("max_phrase_length","3");
+	if( language.size() > 0 ){
+		try {
+			indexer.set_language( language );
+		} catch ( UnsupportedLanguageException &e ){
+			std::cerr << "Error: " << e.what() << std::endl;
+			return false;
+		}
+	}
+	indexer.detect_languages( detect_languages );
+	indexer.set_memory_budget( (std::size_t)memory_budget << 20 );
 	indexer.add_word_filter(blacklist_filter(blacklist));
  	indexer.add_word_filter(too_many_numbers_filter(6));
  	indexer.add_word_filter(minimum_length_filter(3));
@@ -92,31 +112,52 @@ bool do_indexing(Graph &g, text_indexer<Graph> &indexer, const std::vector<std::
 	if( stemmer ){
 		indexer.set_stemming(false);
 	}
-	std::vector<std::string>::const_iterator fpos;
 	
-	unsigned int file_count = 0;
-	for( fpos = filenames.begin(); fpos != filenames.end(); ++fpos ){
-		if( verbose )
-			std::cout << "Indexing " << *fpos << std::endl;
-
-		++file_count;
-
-		try {
+	unsigned int file_count = filenames.size();
+	if( split_paragraphs > 0 || split_delimiter.size() > 0 ){
+		// plain text files can hold any number of documents; stream them
+		// through a block at a time
+		std::vector<std::string> others;
+		for( std::vector<std::string>::const_iterator f = filenames.begin(); f != filenames.end(); ++f ){
+			std::string::size_type pos = f->find_last_of(".");
+			std::string ext = pos == std::string::npos ? "" : f->substr(pos+1);
+			std::transform(ext.begin(), ext.end(), ext.begin(), tolower);
+			if( ext != "txt" ){
+				others.push_back( *f );
+				continue;
+			}
 
-			indexer.index( *fpos );
-			
-		} catch (std::exception &e){
-			std::cerr << "Error indexing file: " << *fpos << " (" << e.what() << ")" << std::endl;
-			continue;
+			std::ifstream in( f->c_str(), std::ios_base::in | std::ios_base::binary );
+			if( !in ){
+				std::cerr << "Error indexing file: " << *f << " (couldn't open it)" << std::endl;
+				continue;
+			}
+			document_stream documents( in, encoding );
+			documents.split_on_paragraphs( split_paragraphs );
+			if( split_delimiter.size() > 0 )
+				documents.split_on_delimiter( split_delimiter );
+			indexer.index_stream( *f, documents, threads, verbose );
 		}
+		indexer.index_files( others.begin(), others.end(), threads, verbose );
+	} else {
+		indexer.index_files( filenames.begin(), filenames.end(), threads, verbose );
 	}
+	
 	if(verbose){
 		std::cout << std::endl << "Files: " << file_count << " Graph: " << num_vertices(g) << " vertices, " << num_edges(g) << " edges" << std::endl;
 		std::cout << std::endl << "Now storing the graph...";
 		std::cout.flush();
 	}
 
-	return indexer.finish();
+	bool finished = indexer.finish();
+#ifndef WIN32
+	// (ru_maxrss is in kilobytes)
+	struct rusage usage;
+	if( getrusage( RUSAGE_SELF, &usage ) == 0 ){
+		std::cout << std::endl << "Peak memory: " << usage.ru_maxrss / 1024 << " MB" << std::endl;
+	}
+#endif
+	return finished;
 }
 
 int main( int argc, char *argv[]) {
@@ -134,6 +175,15 @@ int main( int argc, char *argv[]) {
 		("collection_minimum", po::value<std::string>()->default_value("3"), "Set the minimum number of times a\nterm must appear across the\ncollection to be included in the\nindex\n")
 		("collection_maximum", po::value<std::string>()->default_value("0.2"), "Set the maximum document-frequency\n(between 0 and 1) for a term to be\nincluded in the index\n")
 		("disable_stemmer", "Turn off the stemming of terms\n" )
+		("language,l", po::value<std::string>(), "The language the documents are in:\nen, fr, de, es, it, pt, nl, sv, no,\nda or fi (kept with the collection;\nEnglish if it was never set)\n")
+		("detect_language", "Guess each document's language,\nfalling back on the collection's\n")
+		("lexicon", po::value<std::string>()->default_value("../share/lexicon.txt"), "The part-of-speech lexicon, either\nthe text file or one compiled with\nsemantic_lexicon\n")
+#if SEMANTIC_HAVE_BOOST_THREAD
+		("threads,t", po::value<unsigned int>()->default_value(1), "The number of threads to tag and\nstem documents with\n")
+#endif
+		("split_paragraphs", po::value<unsigned int>()->default_value(0), "Index each run of this many\nparagraphs in a .txt file as a\ndocument of its own\n")
+		("split_delimiter", po::value<std::string>(), "Index the parts of each .txt file\nbetween lines reading exactly this\nas documents of their own\n")
+		("memory_budget", po::value<unsigned int>()->default_value(0), "Index within about this many\nmegabytes, spilling postings to\ntemporary files (0 keeps the whole\ngraph in memory)\n")
 		("file,f", po::value<std::string>(), "Write the term index data to a file\n")
 #if SEMANTIC_HAVE_SQLITE3
 		("sqlite,s", po::value<std::string>(), "The SQLite 3 database file to use.\nthe file will be created if needed\n")
@@ -181,6 +231,19 @@ int main( int argc, char *argv[]) {
 	}
 	
 	encoding = vm["encoding"].as<std::string>();
+	split_paragraphs = vm["split_paragraphs"].as<unsigned int>();
+	if( vm.count("split_delimiter") )
+		split_delimiter = vm["split_delimiter"].as<std::string>();
+	if( vm.count("language") )
+		language = vm["language"].as<std::string>();
+	detect_languages = vm.count("detect_language") > 0;
+	memory_budget = vm["memory_budget"].as<unsigned int>();
+	std::string lexicon = vm["lexicon"].as<std::string>();
+	
+	unsigned int threads = 1;
+#if SEMANTIC_HAVE_BOOST_THREAD
+	threads = vm["threads"].as<unsigned int>();
+#endif
 	
 
 
@@ -228,7 +291,7 @@ int main( int argc, char *argv[]) {
 		}
 		g.set_mirror_changes_to_storage(true);
 
-	 	text_indexer<MySQLGraph> indexer(g, "../share/lexicon.txt" );
+	 	text_indexer<MySQLGraph> indexer(g, lexicon );
 		if( vm["collection_minimum"].as<std::string>().length() > 0)
 			indexer.set_collection_value("min",vm["collection_minimum"].as<std::string>());
 		
@@ -239,7 +302,7 @@ int main( int argc, char *argv[]) {
 			indexer.set_collection_value("doc_min",vm["document_minimum"].as<std::string>());
 		
 		
-		do_indexing(g, indexer, filenames, vm["term_type"].as<std::string>(), (int)vm.count("disable_stemmer"), (int)vm.count("verbose"));
+		do_indexing(g, indexer, filenames, vm["term_type"].as<std::string>(), (int)vm.count("disable_stemmer"), (int)vm.count("verbose"), threads);
 #endif
 	} else if ( vm.count("sqlite")){
 #if SEMANTIC_HAVE_SQLITE3	
@@ -258,7 +321,7 @@ int main( int argc, char *argv[]) {
 		}
 		g.set_mirror_changes_to_storage(true);
 
-	 	text_indexer<SQLiteGraph> indexer(g, "../share/lexicon.txt" );
+	 	text_indexer<SQLiteGraph> indexer(g, lexicon );
 		if( vm["collection_minimum"].as<std::string>().length() > 0)
 			indexer.set_collection_value("min",vm["collection_minimum"].as<std::string>());
 		
@@ -268,7 +331,7 @@ int main( int argc, char *argv[]) {
 		if( vm["document_minimum"].as<std::string>().length() > 0)
 			indexer.set_collection_value("doc_min",vm["document_minimum"].as<std::string>());
 
-		do_indexing(g, indexer, filenames, vm["term_type"].as<std::string>(), (int)vm.count("disable_stemmer"), (int)vm.count("verbose"));
+		do_indexing(g, indexer, filenames, vm["term_type"].as<std::string>(), (int)vm.count("disable_stemmer"), (int)vm.count("verbose"), threads);
 		
 #endif	
 	} else {
@@ -276,7 +339,7 @@ int main( int argc, char *argv[]) {
 		std::set<std::string> blacklist = load_stoplist("../share/stoplist_en.txt");
 	 	
 
-		text_parser parser("../share/lexicon.txt");
+		text_parser parser(lexicon);
 		parser.add_word_filter(blacklist_filter(blacklist));
 	 	parser.add_word_filter(too_many_numbers_filter(6));
 	 	parser.add_word_filter(minimum_length_filter(3));
@@ -286,6 +349,13 @@ int main( int argc, char *argv[]) {
 		if( vm.count("disable_stemmer") ){
 			parser.set_stemming(false);
 		}
+		std::string collection_language = language.size() > 0 ? language : "en";
+		try {
+			parser.set_language( collection_language );
+		} catch ( UnsupportedLanguageException &e ){
+			std::cerr << "Error: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
 
 		file_reader reader;
 		if( encoding.size() > 0 )
@@ -315,6 +385,8 @@ int main( int argc, char *argv[]) {
 				} else {
 					std::cout << "Filename: " << filename << std::endl;
 				}
+				if( detect_languages )
+					parser.set_language( detect_language( text, collection_language ) );
 				std::map<std::string,int>::iterator tpos;
 				std::map<std::string,int> terms = parser.parse( text );
 				for( tpos = terms.begin(); tpos != terms.end(); ++tpos ){
@@ -0,0 +1,30 @@
+
+#include <semantic/lexicon.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace semantic;
+
+// compiles the text part-of-speech lexicon into the binary form that
+// taggers map straight into memory at startup
+int main( int argc, char *argv[]) {
+
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " <lexicon.txt> <compiled lexicon>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try {
+		compiled_lexicon::pointer lexicon = compiled_lexicon::load(argv[1]);
+		lexicon->save(argv[2]);
+		std::cout << argv[2] << ": " << lexicon->num_words() << " words, "
+		          << lexicon->num_tags() << " tags" << std::endl;
+	} catch (LexiconException &e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -9,10 +9,10 @@
 #include <semantic/search.hpp>
 
 // for clustering
-#include <semantic/analysis/linlog.hpp>
+#include <semantic/analysis/parallel_linlog.hpp>
 #include <boost/progress.hpp>
 #include <semantic/analysis/agglomerate_clustering/dendrogram.hpp>
-#include <semantic/analysis/agglomerate_clustering/mst.hpp>
+#include <semantic/analysis/agglomerate_clustering/euclidean_mst.hpp>
 #include <semantic/analysis/agglomerate_clustering/cluster_helper.hpp>
 
 #if SEMANTIC_HAVE_MYSQL
@@ -21,6 +21,7 @@
 #if SEMANTIC_HAVE_SQLITE3
 #include <semantic/storage/sqlite3.hpp>
 #endif
+#include <semantic/storage/csr.hpp>
 
 #include <cstdlib>
 #include <iostream>
@@ -28,7 +29,7 @@
 #include <map>
 #include <string>
 
-typedef LGWeighting<TFWeighting,IDFWeighting,double> WeightingPolicy;
+typedef PrecomputedWeighting<LGWeighting<TFWeighting,IDFWeighting,double> > WeightingPolicy;
 
 #if SEMANTIC_HAVE_MYSQL
 typedef SESubgraph<MySQL5StoragePolicy, PruningRandomWalkSubgraph, WeightingPolicy > MySQLGraph;
@@ -36,6 +37,7 @@ typedef SESubgraph<MySQL5StoragePolicy, PruningRandomWalkSubgraph, WeightingPoli
 #if SEMANTIC_HAVE_SQLITE3
 typedef SESubgraph<SQLite3StoragePolicy, PruningRandomWalkSubgraph, WeightingPolicy > SQLiteGraph;
 #endif
+typedef SESubgraph<CSRStoragePolicy, PruningRandomWalkSubgraph, WeightingPolicy > CSRGraph;
 
 typedef std::pair<std::string,double> single_result;
 typedef std::vector<single_result> sorted_results;
@@ -52,7 +54,7 @@ namespace po = boost::program_options;
 
 
 template <class Graph>
-void cluster(Graph &g, std::string query_string, int num) {
+void cluster(Graph &g, std::string query_string, int num, unsigned int threads) {
     typedef analysis::linlog_traits<Graph, boost::associative_property_map<typename weighting_traits<Graph>::edge_weight_map> > linlog;
     typedef typename se_graph_traits<Graph>::vertex_descriptor vertex;
     typedef typename se_graph_traits<Graph>::vertices_size_type size_type;
@@ -66,26 +68,27 @@ void cluster(Graph &g, std::string query_string, int num) {
     std::cout << std::endl << "Calculating clusters..." << std::endl;
     
     boost::progress_display counter(300, std::cout);
-    analysis::linlog_layout_3d(g, boost::make_assoc_property_map(w), 300, p, counter);
-
-    typedef typename se_graph_traits<Graph>::vertex_pair_edge edge;
-    maps::unordered<edge, double> distances;
-    BGL_FORALL_VERTICES_T(u, g, Graph) {
-        BGL_FORALL_VERTICES_T(v, g, Graph) {
-            edge e1(u,v), e2(v,u);
-            distances[e1] = distances[e2] = p[u].dist(p[v]);
-        }
-    }
-    
-    // now generate an MST
-    std::vector<edge> mst;
-    minimum_weight_spanning_tree(g, extract_keys(distances.begin()), extract_keys(distances.end()), boost::make_assoc_property_map(distances), back_inserter(mst));
-    
+    analysis::parallel_linlog_layout_3d(g, boost::make_assoc_property_map(w), 300, p, threads, counter);
+
     // create the dendrogram
     dendrogram<Graph> dgram(g);
-    dendrogram_from_distance_mst(g, mst, boost::make_assoc_property_map(distances), dgram, SingleLinkDistanceCalculator());
+    analysis::dendrogram_from_layout(g, boost::make_assoc_property_map(p), dgram);
     
-    // we have a dendrogram!
+    // we have a dendrogram!  with no number of clusters asked for, take the
+    // cut with the best silhouette
+    if (num <= 0) {
+        size_type most = num_vertices(g) > 21 ? 20 : num_vertices(g) - 1;
+        std::vector<std::pair<size_type, double> > silhouettes;
+        dgram.layout_silhouettes(boost::make_assoc_property_map(p), 2, most, back_inserter(silhouettes), threads);
+        double best = 0;
+        num = 4;
+        for(unsigned int i = silhouettes.size(); i-- > 0; ) {
+            if (silhouettes[i].second > best) {
+                best = silhouettes[i].second;
+                num = silhouettes[i].first;
+            }
+        }
+    }
     dgram.set_num_clusters(num);
     
     // we need a ranking map -- bad planning among other things made this inaccessible,
@@ -133,9 +136,10 @@ int main( int argc, char* argv[]){
 		("collection,c", po::value<std::string>()->default_value("My Collection"), "The collection to search\n")
 		("summaries", "Print summaries for each document\n")
 		("spread", po::value<double>()->default_value(0.3), "a value from 0 to 1, specifying how\nbroad the search. 1 = most broad\n")
+		("ranking", po::value<std::string>()->default_value("subgraph"), "how to rank: 'subgraph' (a random walk\naround the query terms) or 'matrix'\n(spreading activation over the whole\ncollection)\n")
+		("threads", po::value<unsigned int>()->default_value(1), "threads for --ranking matrix and\n--cluster\n")
 		("cluster", "output results in clusters instead\nof a list\n")
-		("num_clusters", po::value<int>()->default_value(4), "the number of clusters\n")
-//		("num_clusters", po::value<int>(), "override the number of clusters (defaults to 'best fit' using silhouette measure)")
+		("num_clusters", po::value<int>()->default_value(4), "the number of clusters (0 for the\nbest fit by silhouette)\n")
 #if SEMANTIC_HAVE_SQLITE3
 		("sqlite,s", po::value<std::string>(), "the SQLite 3 database file to use\n")
 #endif
@@ -145,6 +149,7 @@ int main( int argc, char* argv[]){
 		("mysql_password,p", po::value<std::string>()->default_value(""), "the MySQL database password")
 		("mysql_hostname,h", po::value<std::string>()->default_value("localhost"), "the MySQL database host\n")
 #endif
+		("csr", po::value<std::string>(), "a CSR index written by semantic_csr_export\n")
 		;
 
 	
@@ -180,10 +185,6 @@ int main( int argc, char* argv[]){
 		return 0;
 	}
 
-#if !SEMANTIC_HAVE_MYSQL && !SEMANTIC_HAVE_SQLITE3
-	std::cerr << "Error: you must compile the indexer with either MySQL or SQLite support!" << std::endl;
-	return 0;
-#endif
 
 	// check for required options
 	if (!vm.count("collection") || !vm.count("query")){
@@ -192,19 +193,31 @@ int main( int argc, char* argv[]){
 
 
 
-	if ( !vm.count("mysql") && !vm.count("sqlite")) {
+	if ( !vm.count("mysql") && !vm.count("sqlite") && !vm.count("csr")) {
 		std::string error;
 #if SEMANTIC_HAVE_MYSQL && SEMANTIC_HAVE_SQLITE3			
-		error = "Error: you must supply either a MySQL or SQLite 3 database!";
+		error = "Error: you must supply either a MySQL or SQLite 3 database, or a CSR index!";
 #elif SEMANTIC_HAVE_MYSQL
-		error = "Error: you must supply a MySQL database!";
+		error = "Error: you must supply a MySQL database or a CSR index!";
+#elif SEMANTIC_HAVE_SQLITE3
+		error = "Error: you must supply a SQLite 3 database or a CSR index!";
 #else
-		error = "Error: you must supply a SQLite 3 database!";
+		error = "Error: you must supply a CSR index!";
 #endif
 		std::cerr << error << std::endl << std::endl;
 		usage();
 	}
 
+	std::string ranking = vm["ranking"].as<std::string>();
+	if( ranking != "subgraph" && ranking != "matrix" ){
+		std::cerr << "Error: --ranking must be 'subgraph' or 'matrix'" << std::endl << std::endl;
+		usage();
+	}
+	if( ranking == "matrix" && vm.count("cluster") ){
+		std::cerr << "Error: --cluster needs --ranking subgraph" << std::endl << std::endl;
+		usage();
+	}
+
 	if( vm.count("mysql") && !vm.count("mysql_username")){
 		std::cerr << "Error: you must supply a username for the MySQL database: " << vm["mysql"].as<std::string>() << std::endl;
 	}
@@ -217,7 +230,38 @@ int main( int argc, char* argv[]){
 	sorted_results docs, terms;
 	std::map<std::string,std::string> summaries;
 			
-	if( vm.count("sqlite")){ 		// SQLite
+	if( vm.count("csr")){ 		// a read-only CSR index
+		CSRGraph g(vm["collection"].as<std::string>());
+		g.set_file(vm["csr"].as<std::string>());
+		g.set_trials(100);
+		g.set_depth(4);
+		g.keep_only_top_edges((float)vm["spread"].as<double>());
+
+		search<CSRGraph> engine(g);
+		activation_matrix<CSRGraph> matrix;
+		if( ranking == "matrix" ){
+			engine.set_activation_matrix(&matrix);
+			engine.set_activation_threads(vm["threads"].as<unsigned int>());
+		}
+		
+		docs_and_terms results;
+		
+		try {
+			results = engine.semantic(vm["query"].as<std::string>());
+		} catch ( std::exception &e ){
+			std::cerr << "Error: " << e.what() << std::endl;
+		}
+		
+		docs = results.first;
+		terms = results.second;
+
+		if (vm.count("cluster"))
+		    cluster(g, vm["query"].as<std::string>(), vm["num_clusters"].as<int>(), vm["threads"].as<unsigned int>());
+
+		if( vm.count("summaries") && !vm.count("cluster"))
+			summaries = engine.summarize_documents(docs);
+		
+	} else if( vm.count("sqlite")){ 		// SQLite
 #if SEMANTIC_HAVE_SQLITE3
 		SQLiteGraph g(vm["collection"].as<std::string>());
 		try {
@@ -234,6 +278,11 @@ int main( int argc, char* argv[]){
 
 
 		search<SQLiteGraph> engine(g);
+		activation_matrix<SQLiteGraph> matrix;
+		if( ranking == "matrix" ){
+			engine.set_activation_matrix(&matrix);
+			engine.set_activation_threads(vm["threads"].as<unsigned int>());
+		}
 		
 		docs_and_terms results;
 		
@@ -247,7 +296,7 @@ int main( int argc, char* argv[]){
 		terms = results.second;
 
 		if (vm.count("cluster"))
-		    cluster(g, vm["query"].as<std::string>(), vm["num_clusters"].as<int>());
+		    cluster(g, vm["query"].as<std::string>(), vm["num_clusters"].as<int>(), vm["threads"].as<unsigned int>());
 
 		if( vm.count("summaries") && !vm.count("cluster"))
 			summaries = engine.summarize_documents(docs);
@@ -273,13 +322,18 @@ int main( int argc, char* argv[]){
 
 
 		search<MySQLGraph> engine(g);
+		activation_matrix<MySQLGraph> matrix;
+		if( ranking == "matrix" ){
+			engine.set_activation_matrix(&matrix);
+			engine.set_activation_threads(vm["threads"].as<unsigned int>());
+		}
 		docs_and_terms results = engine.semantic(vm["query"].as<std::string>());
 
 		docs = results.first;
 		terms = results.second;
 		
 		if (vm.count("cluster"))
-		    cluster(g, vm["query"].as<std::string>(), vm["num_clusters"].as<int>());
+		    cluster(g, vm["query"].as<std::string>(), vm["num_clusters"].as<int>(), vm["threads"].as<unsigned int>());
 
 		if( vm.count("summaries") && !vm.count("cluster"))
 			summaries = engine.summarize_documents(docs);